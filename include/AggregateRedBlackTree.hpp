@@ -0,0 +1,226 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AggregateRedBlackTree.hpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:40:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef AGGREGATEREDBLACKTREE_HPP
+#define AGGREGATEREDBLACKTREE_HPP
+
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include <limits>
+
+namespace ft {
+
+///
+/// @brief Node that keeps the aggregate of its subtree under a monoid.
+///
+///    Monoid provides the aggregate value_type, which must be trivially
+///    copyable, an identity(), an associative combine(a, b) and lift(v)
+///    turning a tree value into an aggregate. combine is applied in key
+///    order, so it does not have to be commutative.
+///
+///    A rotation recomputes the two nodes it moved, an insertion or erasure
+///    then recomputes the path from the changed position to the root, so
+///    every update costs O(log n) combines on top of the rebalancing. The
+///    joins of a range erase recompute their path as well, O(log^2 n).
+///
+/// @tparam Value
+/// @tparam Monoid
+///
+template <typename Value, typename Monoid>
+struct AggregateRedBlackTreeNode : public RedBlackTreeNode<Value> {
+
+  typedef typename Monoid::value_type aggregate_type;
+  typedef RedBlackTreeNodeBase *base_ptr;
+  typedef const RedBlackTreeNodeBase *const_base_ptr;
+  typedef AggregateRedBlackTreeNode *node_ptr;
+  typedef const AggregateRedBlackTreeNode *const_node_ptr;
+  /// Only the value is constructed in a node, the aggregate is assigned.
+  typedef char requires_trivial_aggregate
+      [__has_trivial_copy(aggregate_type) &&
+               __has_trivial_destructor(aggregate_type)
+           ? 1
+           : -1];
+
+  /// Aggregate of the subtree rooted at this node.
+  aggregate_type total;
+
+  static aggregate_type subtree(const_base_ptr x) {
+    return x ? static_cast<const_node_ptr>(x)->total : Monoid::identity();
+  }
+
+  static void recompute(base_ptr x) {
+    node_ptr n = static_cast<node_ptr>(x);
+    n->total = Monoid::combine(
+        Monoid::combine(subtree(x->left), Monoid::lift(n->value)),
+        subtree(x->right));
+  }
+
+  static void propagate(base_ptr x, base_ptr header) {
+    for (; x != header; x = x->parent())
+      recompute(x);
+  }
+
+  /// Pointer links that recompute the rotated nodes.
+  struct Links : public RedBlackTreeNodeLinks {
+    static void rotated(base_ptr x, base_ptr y) {
+      recompute(x);
+      recompute(y);
+    }
+    /// The joins of a range erase work on detached trees, root parent 0.
+    static void relinked(base_ptr x) { propagate(x, 0); }
+  };
+  typedef RedBlackTreeAlgorithms<Links> algorithms_type;
+
+  static void insert_and_rebalance(const bool insert_left, base_ptr x,
+                                   base_ptr p, RedBlackTreeNodeBase &header) {
+    // The new node is a leaf, rotations may read it before the walk up.
+    static_cast<node_ptr>(x)->total =
+        Monoid::lift(static_cast<node_ptr>(x)->value);
+    algorithms_type().insert_and_rebalance(insert_left, x, p, &header);
+    propagate(x, &header);
+  }
+
+  static base_ptr rebalance_for_erase(base_ptr const z,
+                                      RedBlackTreeNodeBase &header) {
+    // Deepest node whose subtree loses z: the parent of z, or with two
+    // children the parent the successor is taken from.
+    base_ptr from = z->parent();
+    if (z->left != 0 && z->right != 0) {
+      base_ptr y = RedBlackTreeNodeBase::minimum(z->right);
+      from = y == z->right ? y : y->parent();
+    }
+    base_ptr y = algorithms_type().rebalance_for_erase(z, &header);
+    propagate(from, &header);
+    return y;
+  }
+
+  static base_ptr unlink_range(base_ptr first, base_ptr last,
+                               RedBlackTreeNodeBase &header) {
+    return algorithms_type().unlink_range(first, last, &header);
+  }
+
+  void copy_augment(const AggregateRedBlackTreeNode &x) { total = x.total; }
+
+  ///
+  /// @brief Aggregate of the values whose key is in [lo, hi).
+  ///
+  ///    Below the node where lo and hi part ways, the left path adds the
+  ///    nodes not less than lo with their right subtrees, the right path
+  ///    the nodes less than hi with their left subtrees: O(log n).
+  ///
+  /// @tparam KeyOfValue
+  /// @param root
+  /// @param lo
+  /// @param hi
+  /// @param comp
+  /// @return aggregate_type
+  ///
+  template <typename KeyOfValue, typename Key, typename Compare>
+  static aggregate_type aggregate(const_base_ptr root, const Key &lo,
+                                  const Key &hi, const Compare &comp) {
+    KeyOfValue key;
+    const_base_ptr x = root;
+    while (x != 0) {
+      if (comp(key(valueOf(x)), lo))
+        x = x->right;
+      else if (!comp(key(valueOf(x)), hi))
+        x = x->left;
+      else
+        break;
+    }
+    if (x == 0)
+      return Monoid::identity();
+    aggregate_type before = Monoid::identity();
+    for (const_base_ptr l = x->left; l != 0;)
+      if (comp(key(valueOf(l)), lo))
+        l = l->right;
+      else {
+        before = Monoid::combine(
+            Monoid::combine(Monoid::lift(valueOf(l)), subtree(l->right)),
+            before);
+        l = l->left;
+      }
+    aggregate_type after = Monoid::identity();
+    for (const_base_ptr r = x->right; r != 0;)
+      if (comp(key(valueOf(r)), hi)) {
+        after = Monoid::combine(
+            after,
+            Monoid::combine(subtree(r->left), Monoid::lift(valueOf(r))));
+        r = r->right;
+      } else
+        r = r->left;
+    return Monoid::combine(Monoid::combine(before, Monoid::lift(valueOf(x))),
+                           after);
+  }
+
+private:
+  static const Value &valueOf(const_base_ptr x) {
+    return static_cast<const_node_ptr>(x)->value;
+  }
+};
+
+///
+/// @brief Node policy of ft::map and ft::set for a RedBlackTree whose nodes
+/// aggregate their subtree, see map::aggregate().
+///
+///    ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int,
+///    long> >, ft::aggregate_nodes<ft::sum_aggregate<long> > >
+///
+/// @tparam Monoid
+///
+template <typename Monoid> struct aggregate_nodes {
+  template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+            typename Alloc>
+  struct tree {
+    typedef RedBlackTree<Key, Value, KeyOfValue, Compare, Alloc,
+                         AggregateRedBlackTreeNode<Value, Monoid> >
+        type;
+  };
+};
+
+/// Sum of the mapped values.
+template <typename T> struct sum_aggregate {
+  typedef T value_type;
+  static T identity() { return T(); }
+  static T combine(const T &a, const T &b) { return a + b; }
+  template <typename Key> static T lift(const pair<const Key, T> &v) {
+    return v.second;
+  }
+};
+
+/// Smallest mapped value, the identity is the largest T.
+template <typename T> struct min_aggregate {
+  typedef T value_type;
+  static T identity() { return std::numeric_limits<T>::max(); }
+  static T combine(const T &a, const T &b) { return b < a ? b : a; }
+  template <typename Key> static T lift(const pair<const Key, T> &v) {
+    return v.second;
+  }
+};
+
+/// Largest mapped value, the identity is the lowest T.
+template <typename T> struct max_aggregate {
+  typedef T value_type;
+  static T identity() {
+    return std::numeric_limits<T>::is_integer
+               ? std::numeric_limits<T>::min()
+               : -std::numeric_limits<T>::max();
+  }
+  static T combine(const T &a, const T &b) { return a < b ? b : a; }
+  template <typename Key> static T lift(const pair<const Key, T> &v) {
+    return v.second;
+  }
+};
+
+} // namespace ft
+
+#endif
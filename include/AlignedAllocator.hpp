@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AlignedAllocator.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ALIGNEDALLOCATOR_HPP
+#define ALIGNEDALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace ft {
+
+/// Size of a cache line, the default alignment of aligned_allocator.
+enum { cache_line_size = 64 };
+/// Largest alignment aligned_allocator accepts.
+enum { max_alignment = 4096 };
+
+///
+/// @brief Allocator returning storage aligned to Alignment bytes.
+///
+///    The size of every block is rounded up to a multiple of Alignment, so
+///    the last line of a block is never shared with another allocation: two
+///    vectors filled by two threads cannot false-share.
+///
+/// @tparam T
+/// @tparam Alignment Power of two, from sizeof(void *) to max_alignment
+///
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator {
+  /// Fails to compile for an unsupported Alignment.
+  typedef char invalid_alignment[(Alignment & (Alignment - 1)) == 0 &&
+                                         Alignment >= sizeof(void *) &&
+                                         Alignment <= max_alignment
+                                     ? 1
+                                     : -1];
+
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U> struct rebind {
+    typedef aligned_allocator<U, Alignment> other;
+  };
+
+  enum { alignment = Alignment };
+
+  aligned_allocator() throw() {}
+  aligned_allocator(const aligned_allocator &) throw() {}
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment> &) throw() {}
+  ~aligned_allocator() throw() {}
+
+  pointer address(reference x) const { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  ///
+  /// @brief Allocate n objects, the block is aligned and padded to
+  /// Alignment.
+  ///
+  /// @param n
+  /// @return pointer
+  ///
+  pointer allocate(size_type n, const void * = 0) {
+    if (n > max_size())
+      throw std::bad_alloc();
+    const size_type bytes =
+        (n * sizeof(T) + Alignment - 1) & ~(size_type(Alignment) - 1);
+    void *p = NULL;
+    if (posix_memalign(&p, Alignment, bytes ? bytes : Alignment) != 0)
+      throw std::bad_alloc();
+    return static_cast<pointer>(p);
+  }
+
+  void deallocate(pointer p, size_type) { std::free(p); }
+
+  size_type max_size() const throw() {
+    return (size_type(-1) - Alignment) / sizeof(T);
+  }
+
+  void construct(pointer p, const T &val) { ::new ((void *)p) T(val); }
+  void destroy(pointer p) { p->~T(); }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator==(const aligned_allocator<T, Alignment> &,
+                       const aligned_allocator<U, Alignment> &) {
+  return true;
+}
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator!=(const aligned_allocator<T, Alignment> &,
+                       const aligned_allocator<U, Alignment> &) {
+  return false;
+}
+
+///
+/// @brief Alignment an allocator guarantees for the storage it returns.
+///
+///    Any allocator is only trusted with the alignment of its value_type,
+///    aligned_allocator guarantees its Alignment.
+///
+/// @tparam Allocator
+///
+template <typename Allocator> struct allocator_alignment {
+  enum { value = __alignof__(typename Allocator::value_type) };
+};
+template <typename T, std::size_t Alignment>
+struct allocator_alignment<aligned_allocator<T, Alignment> > {
+  enum { value = Alignment };
+};
+
+///
+/// @brief Size in bytes from which ft::vector constructs, copies, fills
+/// and destroys its elements in chunks handed to run(), so the pages of a
+/// huge buffer can be first touched by many threads. 0 keeps all of it on
+/// the calling thread.
+///
+///    Specialize it to opt another allocator in, with workers() and run()
+///    spreading the chunks over threads: ft::first_touch_allocator in
+///    FirstTouchAllocator.hpp uses ft::parallel::default_pool().
+///
+/// @tparam Allocator
+///
+template <typename Allocator> struct allocator_first_touch {
+  static const std::size_t threshold = 0;
+  /// Number of threads run() spreads the chunks over.
+  static std::size_t workers() { return 1; }
+  /// Calls body(i) for every chunk i in [0, chunks).
+  template <typename Body> static void run(std::size_t chunks, Body &body) {
+    for (std::size_t i = 0; i < chunks; ++i)
+      body(i);
+  }
+};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,564 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BitVector.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BITVECTOR_HPP
+#define BITVECTOR_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+/// Storage unit of a bit_vector, 64 flags per word on LP64 targets.
+typedef unsigned long bit_word;
+enum { bit_word_bits = int(sizeof(bit_word) * CHAR_BIT) };
+
+///
+/// @brief Proxy reference to one bit of a bit_vector.
+///
+struct bit_reference {
+  bit_word *word;
+  bit_word mask;
+
+  bit_reference(bit_word *w, bit_word m) : word(w), mask(m) {}
+  bit_reference() : word(NULL), mask(0) {}
+
+  operator bool() const { return (*word & mask) != 0; }
+  bit_reference &operator=(bool x) {
+    if (x)
+      *word |= mask;
+    else
+      *word &= ~mask;
+    return *this;
+  }
+  bit_reference &operator=(const bit_reference &x) {
+    return *this = bool(x);
+  }
+  bool operator==(const bit_reference &x) const { return bool(*this) == bool(x); }
+  bool operator<(const bit_reference &x) const { return !bool(*this) && bool(x); }
+  void flip() { *word ^= mask; }
+};
+
+///
+/// @brief Word pointer + bit offset, shared by the bit_vector iterators.
+///
+struct BitIteratorBase {
+  typedef random_access_iterator_tag iterator_category;
+  typedef bool value_type;
+  typedef std::ptrdiff_t difference_type;
+
+  BitIteratorBase(bit_word *w, unsigned int off) : p(w), offset(off) {}
+
+  void bumpUp() {
+    if (offset++ == unsigned(bit_word_bits) - 1) {
+      offset = 0;
+      ++p;
+    }
+  }
+  void bumpDown() {
+    if (offset-- == 0) {
+      offset = unsigned(bit_word_bits) - 1;
+      --p;
+    }
+  }
+  void incr(difference_type i) {
+    difference_type n = i + offset;
+    p += n / bit_word_bits;
+    n = n % bit_word_bits;
+    if (n < 0) {
+      n += bit_word_bits;
+      --p;
+    }
+    offset = static_cast<unsigned int>(n);
+  }
+
+  friend difference_type operator-(const BitIteratorBase &lhs,
+                                   const BitIteratorBase &rhs) {
+    return difference_type(bit_word_bits) * (lhs.p - rhs.p) +
+           difference_type(lhs.offset) - difference_type(rhs.offset);
+  }
+  friend bool operator==(const BitIteratorBase &lhs,
+                         const BitIteratorBase &rhs) {
+    return lhs.p == rhs.p && lhs.offset == rhs.offset;
+  }
+  friend bool operator!=(const BitIteratorBase &lhs,
+                         const BitIteratorBase &rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator<(const BitIteratorBase &lhs,
+                        const BitIteratorBase &rhs) {
+    return lhs.p < rhs.p || (lhs.p == rhs.p && lhs.offset < rhs.offset);
+  }
+  friend bool operator>(const BitIteratorBase &lhs,
+                        const BitIteratorBase &rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const BitIteratorBase &lhs,
+                         const BitIteratorBase &rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const BitIteratorBase &lhs,
+                         const BitIteratorBase &rhs) {
+    return !(lhs < rhs);
+  }
+
+  bit_word *p;
+  unsigned int offset;
+};
+
+struct BitIterator : public BitIteratorBase {
+  typedef bit_reference reference;
+  typedef bit_reference *pointer;
+  typedef BitIterator iterator;
+
+  BitIterator() : BitIteratorBase(NULL, 0) {}
+  BitIterator(bit_word *w, unsigned int off) : BitIteratorBase(w, off) {}
+
+  reference operator*() const { return reference(p, bit_word(1) << offset); }
+  reference operator[](difference_type i) const { return *(*this + i); }
+  iterator &operator++() {
+    bumpUp();
+    return *this;
+  }
+  iterator operator++(int) {
+    iterator tmp = *this;
+    bumpUp();
+    return tmp;
+  }
+  iterator &operator--() {
+    bumpDown();
+    return *this;
+  }
+  iterator operator--(int) {
+    iterator tmp = *this;
+    bumpDown();
+    return tmp;
+  }
+  iterator &operator+=(difference_type i) {
+    incr(i);
+    return *this;
+  }
+  iterator &operator-=(difference_type i) {
+    incr(-i);
+    return *this;
+  }
+  iterator operator+(difference_type i) const {
+    iterator tmp = *this;
+    return tmp += i;
+  }
+  iterator operator-(difference_type i) const {
+    iterator tmp = *this;
+    return tmp -= i;
+  }
+  friend iterator operator+(difference_type n, const iterator &it) {
+    return it + n;
+  }
+};
+
+struct BitConstIterator : public BitIteratorBase {
+  typedef bool reference;
+  typedef const bool *pointer;
+  typedef BitConstIterator const_iterator;
+
+  BitConstIterator() : BitIteratorBase(NULL, 0) {}
+  BitConstIterator(const bit_word *w, unsigned int off)
+      : BitIteratorBase(const_cast<bit_word *>(w), off) {}
+  BitConstIterator(const BitIterator &it) : BitIteratorBase(it.p, it.offset) {}
+
+  reference operator*() const { return (*p & (bit_word(1) << offset)) != 0; }
+  reference operator[](difference_type i) const { return *(*this + i); }
+  const_iterator &operator++() {
+    bumpUp();
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator tmp = *this;
+    bumpUp();
+    return tmp;
+  }
+  const_iterator &operator--() {
+    bumpDown();
+    return *this;
+  }
+  const_iterator operator--(int) {
+    const_iterator tmp = *this;
+    bumpDown();
+    return tmp;
+  }
+  const_iterator &operator+=(difference_type i) {
+    incr(i);
+    return *this;
+  }
+  const_iterator &operator-=(difference_type i) {
+    incr(-i);
+    return *this;
+  }
+  const_iterator operator+(difference_type i) const {
+    const_iterator tmp = *this;
+    return tmp += i;
+  }
+  const_iterator operator-(difference_type i) const {
+    const_iterator tmp = *this;
+    return tmp -= i;
+  }
+  friend const_iterator operator+(difference_type n, const const_iterator &it) {
+    return it + n;
+  }
+};
+
+///
+/// @brief Packed boolean vector class
+///
+///    Flags are stored bit_word_bits to a word in a vectorBase of words, the
+///    bits past size() in the last word are always kept at 0 so the bulk
+///    operations (count, find_first/find_next, &=, |=, ^=, fill, flip) can
+///    work a whole word at a time.
+///
+/// @tparam Allocator Rebound to bit_word
+///
+template <class Allocator = std::allocator<bool> >
+class bit_vector
+    : protected vectorBase<bit_word, typename Allocator::template rebind<
+                                         bit_word>::other> {
+  typedef typename Allocator::template rebind<bit_word>::other word_allocator;
+  typedef vectorBase<bit_word, word_allocator> Base;
+
+public:
+  typedef bool value_type;
+  typedef Allocator allocator_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef bit_reference reference;
+  typedef bool const_reference;
+  typedef BitIterator iterator;
+  typedef BitConstIterator const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  /// Returned by the find functions when no bit is set.
+  static const size_type npos = size_type(-1);
+
+  /// ---------- Ctors & operators
+
+  explicit bit_vector(const allocator_type &alloc = allocator_type())
+      : Base(word_allocator(alloc)), nbits(0) {}
+
+  ///
+  /// @brief Construct a new bit_vector object -> Fill constructor
+  ///
+  /// @param n
+  /// @param val
+  /// @param alloc
+  ///
+  explicit bit_vector(size_type n, bool val = false,
+                      const allocator_type &alloc = allocator_type())
+      : Base(wordsFor(n), word_allocator(alloc)), nbits(n) {
+    this->finish = this->start + wordsFor(n);
+    fill(val);
+  }
+
+  bit_vector(const bit_vector &other)
+      : Base(other.words(), other.alloc), nbits(other.nbits) {
+    this->finish = std::copy(other.start, other.finish, this->start);
+  }
+
+  bit_vector &operator=(const bit_vector &other) {
+    if (&other != this) {
+      bit_vector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// ---------- Iterators
+  iterator begin() { return iterator(this->start, 0); }
+  const_iterator begin() const { return const_iterator(this->start, 0); }
+  iterator end() { return begin() + difference_type(nbits); }
+  const_iterator end() const { return begin() + difference_type(nbits); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+  size_type size() const { return nbits; }
+  bool empty() const { return nbits == 0; }
+  size_type max_size() const {
+    const size_type n = Base::max_size();
+    return n > npos / bit_word_bits ? npos : n * bit_word_bits;
+  }
+  size_type capacity() const { return Base::capacity() * bit_word_bits; }
+
+  ///
+  /// @brief Make room for at least n bits.
+  ///
+  /// @param n
+  ///
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("bit_vector::reserve");
+    if (wordsFor(n) > Base::capacity())
+      reallocate(wordsFor(n));
+  }
+
+  ///
+  /// @brief Resize the bit_vector, new bits are set to val.
+  ///
+  /// @param n
+  /// @param val
+  ///
+  void resize(size_type n, bool val = false) {
+    if (n > nbits) {
+      if (wordsFor(n) > Base::capacity())
+        reallocate(Base::growLength(words(), wordsFor(n) - words(),
+                                    Base::max_size(), "bit_vector::resize"));
+      if (val && nbits % bit_word_bits)
+        this->finish[-1] |= fillWord(true) << (nbits % bit_word_bits);
+      std::fill(this->finish, this->start + wordsFor(n), fillWord(val));
+      this->finish = this->start + wordsFor(n);
+    } else
+      this->finish = this->start + wordsFor(n);
+    nbits = n;
+    clearTail();
+  }
+
+  /// ---------- Element access
+
+  reference operator[](size_type n) {
+    return reference(this->start + n / bit_word_bits,
+                     bit_word(1) << (n % bit_word_bits));
+  }
+  const_reference operator[](size_type n) const { return test(n); }
+  reference at(size_type n) {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return test(0); }
+  reference back() { return (*this)[nbits - 1]; }
+  const_reference back() const { return test(nbits - 1); }
+
+  ///
+  /// @brief Value of the bit n, unchecked.
+  ///
+  bool test(size_type n) const {
+    return (this->start[n / bit_word_bits] >> (n % bit_word_bits)) & 1;
+  }
+
+  /// ---------- Modifiers
+
+  void push_back(bool val) {
+    if (nbits % bit_word_bits == 0) {
+      if (this->finish == this->endOfStorage)
+        reallocate(Base::growLength(words(), 1, Base::max_size(),
+                                    "bit_vector::push_back"));
+      *this->finish++ = 0;
+    }
+    if (val)
+      this->finish[-1] |= bit_word(1) << (nbits % bit_word_bits);
+    ++nbits;
+  }
+
+  void pop_back() {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+    --nbits;
+    this->finish[-1] &= ~(bit_word(1) << (nbits % bit_word_bits));
+    if (nbits % bit_word_bits == 0)
+      --this->finish;
+  }
+
+  void clear() {
+    this->finish = this->start;
+    nbits = 0;
+  }
+
+  void swap(bit_vector &other) {
+    this->swapData(other);
+    ft::swap(nbits, other.nbits);
+  }
+
+  /// ---------- Word operations
+
+  ///
+  /// @brief Set every bit to val.
+  ///
+  void fill(bool val) {
+    std::fill(this->start, this->finish, fillWord(val));
+    clearTail();
+  }
+
+  ///
+  /// @brief Invert every bit.
+  ///
+  void flip() {
+    for (bit_word *w = this->start; w != this->finish; ++w)
+      *w = ~*w;
+    clearTail();
+  }
+
+  ///
+  /// @brief Number of bits set.
+  ///
+  /// @return size_type
+  ///
+  size_type count() const {
+    size_type n = 0;
+    for (const bit_word *w = this->start; w != this->finish; ++w)
+      n += __builtin_popcountl(*w);
+    return n;
+  }
+  bool any() const { return findFrom(0) != npos; }
+  bool none() const { return !any(); }
+
+  ///
+  /// @brief Index of the first bit set, npos if there is none.
+  ///
+  size_type find_first() const { return findFrom(0); }
+  ///
+  /// @brief Index of the first bit set after pos, npos if there is none.
+  ///
+  size_type find_next(size_type pos) const {
+    return pos >= size() ? npos : findFrom(pos + 1);
+  }
+
+  ///
+  /// @brief Word-wise logic operations, both bit_vectors must have the same
+  /// size.
+  ///
+  bit_vector &operator&=(const bit_vector &rhs) {
+    requireSameSize(rhs, "bit_vector::operator&=");
+    for (size_type i = 0; i < words(); i++)
+      this->start[i] &= rhs.start[i];
+    return *this;
+  }
+  bit_vector &operator|=(const bit_vector &rhs) {
+    requireSameSize(rhs, "bit_vector::operator|=");
+    for (size_type i = 0; i < words(); i++)
+      this->start[i] |= rhs.start[i];
+    return *this;
+  }
+  bit_vector &operator^=(const bit_vector &rhs) {
+    requireSameSize(rhs, "bit_vector::operator^=");
+    for (size_type i = 0; i < words(); i++)
+      this->start[i] ^= rhs.start[i];
+    return *this;
+  }
+
+  /// Underlying words, the unused bits of the last one are 0.
+  const bit_word *data() const { return this->start; }
+  size_type num_words() const { return words(); }
+
+protected:
+  static size_type wordsFor(size_type n) {
+    return n / bit_word_bits + (n % bit_word_bits != 0);
+  }
+  static bit_word fillWord(bool val) { return val ? ~bit_word(0) : 0; }
+  size_type words() const { return Base::size(); }
+
+  /// Zero the bits past size() in the last word.
+  void clearTail() {
+    if (nbits % bit_word_bits)
+      this->finish[-1] &= (bit_word(1) << (nbits % bit_word_bits)) - 1;
+  }
+
+  size_type findFrom(size_type pos) const {
+    if (pos >= nbits)
+      return npos;
+    size_type i = pos / bit_word_bits;
+    bit_word w = this->start[i] & (fillWord(true) << (pos % bit_word_bits));
+    while (!w) {
+      if (++i == words())
+        return npos;
+      w = this->start[i];
+    }
+    return i * bit_word_bits + __builtin_ctzl(w);
+  }
+
+  void reallocate(size_type n) {
+    bit_word *tmp = this->allocate(n);
+    std::copy(this->start, this->finish, tmp);
+    const size_type len = words();
+    this->deallocate(this->start, Base::capacity());
+    this->start = tmp;
+    this->finish = tmp + len;
+    this->endOfStorage = tmp + n;
+  }
+
+  void rangeCheck(size_type n) const {
+    if (n >= nbits)
+      throw std::out_of_range("bit_vector::rangeCheck");
+  }
+
+  void requireSameSize(const bit_vector &rhs, const char *s) const {
+    if (rhs.nbits != nbits)
+      throw std::invalid_argument(s);
+  }
+
+  size_type nbits;
+
+  friend bool operator==(const bit_vector &lhs, const bit_vector &rhs) {
+    return lhs.nbits == rhs.nbits &&
+           ft::equal(lhs.start, lhs.finish, rhs.start);
+  }
+};
+
+template <class Allocator>
+const typename bit_vector<Allocator>::size_type bit_vector<Allocator>::npos;
+
+template <class Alloc>
+inline bool operator!=(const bit_vector<Alloc> &lhs,
+                       const bit_vector<Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Alloc>
+inline bit_vector<Alloc> operator&(const bit_vector<Alloc> &lhs,
+                                   const bit_vector<Alloc> &rhs) {
+  bit_vector<Alloc> tmp(lhs);
+  return tmp &= rhs;
+}
+template <class Alloc>
+inline bit_vector<Alloc> operator|(const bit_vector<Alloc> &lhs,
+                                   const bit_vector<Alloc> &rhs) {
+  bit_vector<Alloc> tmp(lhs);
+  return tmp |= rhs;
+}
+template <class Alloc>
+inline bit_vector<Alloc> operator^(const bit_vector<Alloc> &lhs,
+                                   const bit_vector<Alloc> &rhs) {
+  bit_vector<Alloc> tmp(lhs);
+  return tmp ^= rhs;
+}
+
+template <class Alloc>
+inline void swap(bit_vector<Alloc> &x, bit_vector<Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,392 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CircularBuffer.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CIRCULARBUFFER_HPP
+#define CIRCULARBUFFER_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+///
+/// @brief Random access iterator over a circular_buffer, it walks the
+/// logical positions 0..size() and wraps around the storage.
+///
+/// @tparam Buffer circular_buffer or const circular_buffer
+/// @tparam T value_type, const qualified for the const_iterator
+///
+template <typename Buffer, typename T> struct CircularBuffer_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef ft::random_access_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef CircularBuffer_iterator<Buffer, T> Self;
+
+  CircularBuffer_iterator() : buf(), index() {}
+  CircularBuffer_iterator(Buffer *b, std::size_t i) : buf(b), index(i) {}
+  /// Enable conversion to const_iterator.
+  operator CircularBuffer_iterator<const Buffer, const T>() const {
+    return CircularBuffer_iterator<const Buffer, const T>(buf, index);
+  }
+
+  reference operator*() const { return (*buf)[index]; }
+  pointer operator->() const { return &(*buf)[index]; }
+  reference operator[](difference_type n) const { return (*buf)[index + n]; }
+
+  Self &operator++() {
+    ++index;
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    ++index;
+    return tmp;
+  }
+  Self &operator--() {
+    --index;
+    return *this;
+  }
+  Self operator--(int) {
+    Self tmp = *this;
+    --index;
+    return tmp;
+  }
+  Self &operator+=(difference_type n) {
+    index += n;
+    return *this;
+  }
+  Self &operator-=(difference_type n) {
+    index -= n;
+    return *this;
+  }
+  Self operator+(difference_type n) const { return Self(buf, index + n); }
+  Self operator-(difference_type n) const { return Self(buf, index - n); }
+  friend Self operator+(difference_type n, const Self &it) { return it + n; }
+  friend difference_type operator-(const Self &lhs, const Self &rhs) {
+    return difference_type(lhs.index) - difference_type(rhs.index);
+  }
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.index == rhs.index;
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.index != rhs.index;
+  }
+  friend bool operator<(const Self &lhs, const Self &rhs) {
+    return lhs.index < rhs.index;
+  }
+  friend bool operator>(const Self &lhs, const Self &rhs) { return rhs < lhs; }
+  friend bool operator<=(const Self &lhs, const Self &rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const Self &lhs, const Self &rhs) {
+    return !(lhs < rhs);
+  }
+
+  Buffer *buf;
+  std::size_t index;
+};
+
+///
+/// @brief Fixed capacity ring buffer class
+///
+///    The storage comes from vectorBase and is allocated once, its finish
+///    pointer is left at start: the live elements are the size() slots
+///    following head, wrapping at capacity().
+///
+///    When full, push_back overwrites the oldest element and push_front the
+///    newest one, unless the buffer was built with overwrite off, then
+///    pushing throws std::length_error.
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <class T, class Allocator = std::allocator<T> >
+class circular_buffer : protected vectorBase<T, Allocator> {
+
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::difference_type difference_type;
+  typedef CircularBuffer_iterator<circular_buffer, T> iterator;
+  typedef CircularBuffer_iterator<const circular_buffer, const T>
+      const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  /// Contiguous run of elements: pointer and length.
+  typedef ft::pair<pointer, size_type> array_range;
+  typedef ft::pair<const_pointer, size_type> const_array_range;
+  typedef vectorBase<T, Allocator> Base;
+
+  using Base::get_allocator;
+  using Base::max_size;
+
+  /// ---------- Ctors & operators
+
+  ///
+  /// @brief Construct a new circular_buffer object holding up to capacity
+  /// elements.
+  ///
+  /// @param capacity
+  /// @param overwrite Overwrite the oldest element when full, or throw
+  /// @param alloc
+  ///
+  explicit circular_buffer(size_type capacity = 0, bool overwrite = true,
+                           const allocator_type &alloc = allocator_type())
+      : Base(checkCapacity(capacity, alloc), alloc), head(0), count(0),
+        overwrite(overwrite) {}
+
+  circular_buffer(const circular_buffer &other)
+      : Base(other.capacity(), other.get_allocator()), head(0), count(0),
+        overwrite(other.overwrite) {
+    try {
+      copyFrom(other);
+    } catch (...) {
+      clear();
+      __throw_exception_again;
+    }
+  }
+
+  ~circular_buffer() { clear(); }
+
+  circular_buffer &operator=(const circular_buffer &other) {
+    if (&other != this) {
+      circular_buffer tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// ---------- Iterators
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, count); }
+  const_iterator end() const { return const_iterator(this, count); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+  size_type size() const { return count; }
+  size_type capacity() const { return Base::capacity(); }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == capacity(); }
+  bool overwrites() const { return overwrite; }
+
+  ///
+  /// @brief Change the capacity, the newest elements are kept when it
+  /// shrinks below size().
+  ///
+  /// @param n
+  ///
+  void set_capacity(size_type n) {
+    if (n == capacity())
+      return;
+    circular_buffer tmp(n, overwrite, get_allocator());
+    const size_type skip = count > n ? count - n : 0;
+    for (size_type i = skip; i < count; i++)
+      tmp.push_back((*this)[i]);
+    swap(tmp);
+  }
+
+  /// ---------- Element access
+
+  reference operator[](size_type n) { return Base::start[slot(n)]; }
+  const_reference operator[](size_type n) const {
+    return Base::start[slot(n)];
+  }
+  reference at(size_type n) {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  reference front() {
+    requireNonEmpty();
+    return (*this)[0];
+  }
+  const_reference front() const {
+    requireNonEmpty();
+    return (*this)[0];
+  }
+  reference back() {
+    requireNonEmpty();
+    return (*this)[count - 1];
+  }
+  const_reference back() const {
+    requireNonEmpty();
+    return (*this)[count - 1];
+  }
+
+  ///
+  /// @brief The elements as two contiguous runs: array_one() holds the
+  /// oldest ones up to the end of the storage, array_two() the rest from the
+  /// start of the storage. Copying both in order gives the whole content.
+  ///
+  /// @return array_range
+  ///
+  array_range array_one() {
+    return array_range(Base::start + head, firstRunLength());
+  }
+  const_array_range array_one() const {
+    return const_array_range(Base::start + head, firstRunLength());
+  }
+  array_range array_two() {
+    return array_range(Base::start, count - firstRunLength());
+  }
+  const_array_range array_two() const {
+    return const_array_range(Base::start, count - firstRunLength());
+  }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Add val after the newest element, O(1).
+  ///
+  /// @param val
+  ///
+  void push_back(const value_type &val) {
+    if (full()) {
+      if (!overwrite)
+        throw std::length_error("circular_buffer::push_back");
+      if (capacity() == 0)
+        return;
+      Base::start[head] = val;
+      head = slot(1);
+      return;
+    }
+    Base::construct(Base::start, val, slot(count));
+    ++count;
+  }
+
+  ///
+  /// @brief Add val before the oldest element, O(1).
+  ///
+  /// @param val
+  ///
+  void push_front(const value_type &val) {
+    if (full()) {
+      if (!overwrite)
+        throw std::length_error("circular_buffer::push_front");
+      if (capacity() == 0)
+        return;
+      head = prevSlot();
+      Base::start[head] = val;
+      return;
+    }
+    Base::construct(Base::start, val, prevSlot());
+    head = prevSlot();
+    ++count;
+  }
+
+  void pop_back() {
+    requireNonEmpty();
+    Base::destroy(Base::start, slot(count - 1));
+    --count;
+  }
+
+  void pop_front() {
+    requireNonEmpty();
+    Base::destroy(Base::start, head);
+    head = slot(1);
+    --count;
+  }
+
+  void clear() {
+    for (size_type i = 0; i < count; i++)
+      Base::destroy(Base::start, slot(i));
+    head = 0;
+    count = 0;
+  }
+
+  void swap(circular_buffer &other) {
+    this->swapData(other);
+    ft::swap(head, other.head);
+    ft::swap(count, other.count);
+    ft::swap(overwrite, other.overwrite);
+  }
+
+protected:
+  static size_type checkCapacity(size_type n, const allocator_type &alloc) {
+    if (n > alloc.max_size())
+      throw std::length_error("circular_buffer::circular_buffer");
+    return n;
+  }
+
+  /// Storage index of the logical position n, n <= capacity().
+  size_type slot(size_type n) const {
+    const size_type i = head + n;
+    return i >= capacity() ? i - capacity() : i;
+  }
+  size_type prevSlot() const { return head == 0 ? capacity() - 1 : head - 1; }
+  size_type firstRunLength() const {
+    return std::min(count, capacity() - head);
+  }
+
+  void copyFrom(const circular_buffer &other) {
+    for (; count < other.count; ++count)
+      Base::construct(Base::start, other[count], count);
+  }
+
+  void rangeCheck(size_type n) const {
+    if (n >= count)
+      throw std::out_of_range("circular_buffer::rangeCheck");
+  }
+
+  void requireNonEmpty() const {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+  }
+
+  size_type head;
+  size_type count;
+  bool overwrite;
+};
+
+template <class T, class Alloc>
+inline bool operator==(const circular_buffer<T, Alloc> &lhs,
+                       const circular_buffer<T, Alloc> &rhs) {
+  return lhs.size() == rhs.size() &&
+         ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <class T, class Alloc>
+inline bool operator!=(const circular_buffer<T, Alloc> &lhs,
+                       const circular_buffer<T, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+inline void swap(circular_buffer<T, Alloc> &x, circular_buffer<T, Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,834 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CompactRedBlackTree.hpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:40:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef COMPACTREDBLACKTREE_HPP
+#define COMPACTREDBLACKTREE_HPP
+
+#include "Iterators.hpp"
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace ft {
+
+///
+/// @brief Node of a CompactRedBlackTree, linked by 32-bit arena indices.
+///
+///    The value is only constructed while the node is in the tree, the null
+///    slot, the header slot and free slots leave it raw.
+///
+template <typename Value> struct CompactRedBlackTreeNode {
+  /// Parent index shifted left once, the color is the low bit.
+  uint32_t parentColor;
+  uint32_t left;
+  uint32_t right;
+  Value value;
+};
+
+///
+/// @brief Links of CompactRedBlackTreeNode for RedBlackTreeAlgorithms, an
+/// index names a slot of the arena and 0 is the null node.
+///
+template <typename Value> struct CompactRedBlackTreeLinks {
+  typedef uint32_t node_ptr;
+  typedef CompactRedBlackTreeNode<Value> node;
+
+  CompactRedBlackTreeLinks() : nodes(0) {}
+  explicit CompactRedBlackTreeLinks(node *arena) : nodes(arena) {}
+
+  node_ptr parent(node_ptr x) const { return nodes[x].parentColor >> 1; }
+  void set_parent(node_ptr x, node_ptr p) const {
+    nodes[x].parentColor = (p << 1) | (nodes[x].parentColor & 1);
+  }
+  node_ptr left(node_ptr x) const { return nodes[x].left; }
+  void set_left(node_ptr x, node_ptr l) const { nodes[x].left = l; }
+  node_ptr right(node_ptr x) const { return nodes[x].right; }
+  void set_right(node_ptr x, node_ptr r) const { nodes[x].right = r; }
+  RedBlackTreeColor color(node_ptr x) const {
+    return RedBlackTreeColor(nodes[x].parentColor & 1);
+  }
+  void set_color(node_ptr x, RedBlackTreeColor c) const {
+    nodes[x].parentColor = (nodes[x].parentColor & ~uint32_t(1)) | uint32_t(c);
+  }
+  void rotated(node_ptr, node_ptr) const {}
+  void relinked(node_ptr) const {}
+
+  node *nodes;
+};
+
+///
+/// @brief Bidirectional iterator over a CompactRedBlackTree.
+///
+///    It keeps the tree and a node index, so it stays valid when the arena
+///    grows, but unlike the pointer tree it does not follow its elements
+///    through a swap().
+///
+/// @tparam Tree CompactRedBlackTree or const CompactRedBlackTree
+/// @tparam T value_type, const qualified for the const_iterator
+///
+template <typename Tree, typename T> struct CompactRedBlackTree_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef CompactRedBlackTree_iterator<Tree, T> Self;
+  typedef uint32_t node_ptr;
+
+  CompactRedBlackTree_iterator() : tree(), node() {}
+  CompactRedBlackTree_iterator(Tree *t, node_ptr x) : tree(t), node(x) {}
+  /// Enable conversion to const_iterator.
+  operator CompactRedBlackTree_iterator<const Tree, const T>() const {
+    return CompactRedBlackTree_iterator<const Tree, const T>(tree, node);
+  }
+
+  reference operator*() const { return tree->value(node); }
+  pointer operator->() const { return &tree->value(node); }
+
+  Self &operator++() {
+    node = tree->algorithms().increment(node);
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    node = tree->algorithms().increment(node);
+    return tmp;
+  }
+  Self &operator--() {
+    node = tree->algorithms().decrement(node);
+    return *this;
+  }
+  Self operator--(int) {
+    Self tmp = *this;
+    node = tree->algorithms().decrement(node);
+    return tmp;
+  }
+
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.node == rhs.node;
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.node != rhs.node;
+  }
+
+  Tree *tree;
+  node_ptr node;
+};
+
+///
+/// @brief Red-black tree whose nodes live in one contiguous arena and link
+/// to each other by 32-bit indices.
+///
+///    Slot 0 is the null node and slot 1 the header, erased slots go on a
+///    free list threaded through their left index and are reused before the
+///    arena grows. A node of a map<int, int> takes 20 bytes instead of 32,
+///    neighbours in the arena share cache lines, and because the links are
+///    positions the whole arena is copied (or relocated when it grows) with
+///    one memcpy for trivially copyable values; the balancing code is the
+///    same RedBlackTreeAlgorithms the pointer tree uses. The color takes a
+///    bit of the parent index, so a tree holds at most 2^31 - 3 elements.
+///
+///    The arena is only allocated by the first insertion, and clear() keeps
+///    it for reuse.
+///
+/// @tparam Key
+/// @tparam Value
+/// @tparam KeyOfValue
+/// @tparam Compare
+/// @tparam Alloc
+///
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc = std::allocator<Value> >
+class CompactRedBlackTree {
+
+  template <typename Tree, typename T>
+  friend struct CompactRedBlackTree_iterator;
+
+public:
+  typedef Key key_type;
+  typedef Value value_type;
+  typedef value_type *pointer;
+  typedef const value_type *const_pointer;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Alloc allocator_type;
+  typedef RedBlackTreeNoAggregate aggregate_type;
+  typedef CompactRedBlackTree_iterator<CompactRedBlackTree, value_type>
+      iterator;
+  typedef CompactRedBlackTree_iterator<const CompactRedBlackTree,
+                                       const value_type>
+      const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+protected:
+  typedef uint32_t node_ptr;
+  typedef CompactRedBlackTreeNode<Value> node;
+  typedef typename Alloc::template rebind<node>::other node_allocator_type;
+  typedef RedBlackTreeAlgorithms<CompactRedBlackTreeLinks<Value> >
+      algorithms_type;
+  /// Values are copied and relocated with memcpy when that is what copying
+  /// them does.
+  typedef ft::integral_constant<bool, __has_trivial_copy(Value) &&
+                                          __has_trivial_destructor(Value)>
+      trivial_type;
+
+  enum {
+    null_node = 0,
+    header_node = 1,
+    /// Largest slot count, the index must fit beside the color bit.
+    max_slots = 0x7FFFFFFF
+  };
+
+  node_allocator_type nodeAlloc;
+  Compare keyCompare;
+  node *nodes;
+  node_ptr capacity; // Slots allocated.
+  node_ptr used;     // Slots [0, used) hold links.
+  node_ptr freeList;
+  size_type nodeCount;
+
+public:
+  CompactRedBlackTree()
+      : nodeAlloc(), keyCompare(), nodes(0), capacity(0), used(0),
+        freeList(null_node), nodeCount(0) {}
+  CompactRedBlackTree(const Compare &comp,
+                      const allocator_type &a = allocator_type())
+      : nodeAlloc(a), keyCompare(comp), nodes(0), capacity(0), used(0),
+        freeList(null_node), nodeCount(0) {}
+  ///
+  /// @brief Copy the arena as is: same slots, same links, no rebalancing.
+  ///
+  CompactRedBlackTree(const CompactRedBlackTree &x)
+      : nodeAlloc(x.nodeAlloc), keyCompare(x.keyCompare), nodes(0),
+        capacity(0), used(0), freeList(null_node), nodeCount(0) {
+    if (x.nodes == 0)
+      return;
+    nodes = nodeAlloc.allocate(x.used);
+    try {
+      copyArena(nodes, x.nodes, x.used, trivial_type());
+    } catch (...) {
+      nodeAlloc.deallocate(nodes, x.used);
+      __throw_exception_again;
+    }
+    capacity = x.used;
+    used = x.used;
+    freeList = x.freeList;
+    nodeCount = x.nodeCount;
+  }
+  ~CompactRedBlackTree() {
+    if (nodes) {
+      destroyValues(trivial_type());
+      nodeAlloc.deallocate(nodes, capacity);
+    }
+  }
+
+  CompactRedBlackTree &operator=(const CompactRedBlackTree &x) {
+    if (this != &x) {
+      CompactRedBlackTree tmp(x);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  // Accessors.
+  Compare key_comp() const { return keyCompare; }
+  allocator_type get_allocator() const { return allocator_type(nodeAlloc); }
+
+  iterator begin() { return iterator(this, leftmost()); }
+  const_iterator begin() const { return const_iterator(this, leftmost()); }
+  iterator end() { return iterator(this, header_node); }
+  const_iterator end() const { return const_iterator(this, header_node); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const { return nodeCount == 0; }
+  size_type size() const { return nodeCount; }
+  size_type max_size() const {
+    const size_type n = nodeAlloc.max_size();
+    return (n < size_type(max_slots) ? n : size_type(max_slots)) - 2;
+  }
+
+  void swap(CompactRedBlackTree &t) {
+    ft::swap(nodeAlloc, t.nodeAlloc);
+    ft::swap(keyCompare, t.keyCompare);
+    ft::swap(nodes, t.nodes);
+    ft::swap(capacity, t.capacity);
+    ft::swap(used, t.used);
+    ft::swap(freeList, t.freeList);
+    ft::swap(nodeCount, t.nodeCount);
+  }
+
+  // Insert/erase.
+
+  ///
+  /// @brief Creates the key pair if it doesn't exist.
+  ///
+  /// @param v
+  /// @return pair<iterator, bool>
+  ///
+  pair<iterator, bool> insert_unique(const Value &v) {
+    typedef pair<iterator, bool> Res;
+    pair<node_ptr, node_ptr> res = get_insert_unique_pos(KeyOfValue()(v));
+    if (res.second)
+      return Res(insert_(res.first, res.second, v), true);
+    return Res(iterator(this, res.first), false);
+  }
+
+  template <class II> void insert_unique(II first, II last) {
+    for (; first != last; ++first)
+      insert_unique(end(), *first);
+  }
+
+  iterator insert_unique(const_iterator pos, const value_type &v) {
+    pair<node_ptr, node_ptr> res =
+        get_insert_hint_unique_pos(pos.node, KeyOfValue()(v));
+    if (res.second)
+      return insert_(res.first, res.second, v);
+    return iterator(this, res.first);
+  }
+
+  ///
+  /// @brief Insert after the equal keys, a key not less than the rightmost
+  /// one is appended without descending the tree.
+  ///
+  /// @param v
+  /// @return iterator
+  ///
+  iterator insert_equal(const Value &v) {
+    if (size() > 0 && !keyCompare(KeyOfValue()(v), key(rightmost())))
+      return insert_(0, rightmost(), v);
+    pair<node_ptr, node_ptr> res = get_insert_equal_pos(KeyOfValue()(v));
+    return insert_(res.first, res.second, v);
+  }
+
+  template <class II> void insert_equal(II first, II last) {
+    for (; first != last; ++first)
+      insert_equal(end(), *first);
+  }
+
+  iterator insert_equal(const_iterator pos, const value_type &v) {
+    pair<node_ptr, node_ptr> res =
+        get_insert_hint_equal_pos(pos.node, KeyOfValue()(v));
+    if (res.second)
+      return insert_(res.first, res.second, v);
+    res = get_insert_equal_lower_pos(KeyOfValue()(v));
+    return insert_(res.first, res.second, v);
+  }
+
+  ///
+  /// @brief Erase the position from the tree.
+  ///
+  /// @param position
+  ///
+  void erase(const_iterator position) { erase_internal_helper(position.node); }
+
+  ///
+  /// @brief Erase all keys of the same value.
+  ///
+  /// @param x
+  /// @return size_type
+  ///
+  size_type erase(const Key &x) {
+    pair<const_iterator, const_iterator> p =
+        static_cast<const CompactRedBlackTree &>(*this).equal_range(x);
+    const size_type oldsize = size();
+    erase(p.first, p.second);
+    return oldsize - size();
+  }
+
+  ///
+  /// @brief Erase a range of values.
+  ///
+  /// @param first
+  /// @param last
+  ///
+  void erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end())
+      clear();
+    else
+      while (first != last)
+        erase_internal_helper((first++).node);
+  }
+
+  ///
+  /// @brief Empty the tree, the arena is kept for the next insertions.
+  ///
+  void clear() {
+    if (nodes == 0)
+      return;
+    destroyValues(trivial_type());
+    resetArena();
+  }
+
+  // Set operations
+
+  iterator find(const Key &k) { return iterator(this, find_internal(k)); }
+  const_iterator find(const Key &k) const {
+    return const_iterator(this, find_internal(k));
+  }
+
+  size_type count(const Key &k) const {
+    pair<const_iterator, const_iterator> p = equal_range(k);
+    // Never step past the range: an empty tree has no arena to walk.
+    size_type n = 0;
+    for (; p.first != p.second; ++p.first)
+      ++n;
+    return n;
+  }
+
+  iterator lower_bound(const key_type &k) {
+    return iterator(this, lower_bound_internal(root(), header_node, k));
+  }
+  const_iterator lower_bound(const key_type &k) const {
+    return const_iterator(this, lower_bound_internal(root(), header_node, k));
+  }
+  iterator upper_bound(const key_type &k) {
+    return iterator(this, upper_bound_internal(root(), header_node, k));
+  }
+  const_iterator upper_bound(const key_type &k) const {
+    return const_iterator(this, upper_bound_internal(root(), header_node, k));
+  }
+
+  pair<iterator, iterator> equal_range(const Key &k) {
+    pair<node_ptr, node_ptr> p = equal_range_internal(k);
+    return pair<iterator, iterator>(iterator(this, p.first),
+                                    iterator(this, p.second));
+  }
+  pair<const_iterator, const_iterator> equal_range(const Key &k) const {
+    pair<node_ptr, node_ptr> p = equal_range_internal(k);
+    return pair<const_iterator, const_iterator>(const_iterator(this, p.first),
+                                                const_iterator(this, p.second));
+  }
+
+  /// Nothing is derived from the values.
+  void refresh(const_iterator) {}
+
+protected:
+  algorithms_type algorithms() const {
+    return algorithms_type(CompactRedBlackTreeLinks<Value>(nodes));
+  }
+
+  // With no arena yet the header is virtual: an empty tree.
+  node_ptr root() const {
+    return nodes ? nodes[header_node].parentColor >> 1 : 0;
+  }
+  node_ptr leftmost() const {
+    return nodes ? nodes[header_node].left : node_ptr(header_node);
+  }
+  node_ptr rightmost() const {
+    return nodes ? nodes[header_node].right : node_ptr(header_node);
+  }
+  node_ptr left(node_ptr x) const { return nodes[x].left; }
+  node_ptr right(node_ptr x) const { return nodes[x].right; }
+  reference value(node_ptr x) { return nodes[x].value; }
+  const_reference value(node_ptr x) const { return nodes[x].value; }
+  const Key &key(node_ptr x) const { return KeyOfValue()(nodes[x].value); }
+
+  ///
+  /// @brief Take a slot from the free list, or the next unused one.
+  ///
+  /// @return node_ptr
+  ///
+  node_ptr get_node() {
+    if (freeList != null_node) {
+      node_ptr x = freeList;
+      freeList = nodes[x].left;
+      return x;
+    }
+    if (used == capacity)
+      grow();
+    return used++;
+  }
+
+  void put_node(node_ptr x) {
+    nodes[x].left = freeList;
+    freeList = x;
+  }
+
+  node_ptr create_node(const value_type &v) {
+    node_ptr x = get_node();
+    try {
+      get_allocator().construct(&nodes[x].value, v);
+    } catch (...) {
+      put_node(x);
+      __throw_exception_again;
+    }
+    return x;
+  }
+
+  ///
+  /// @brief Double the arena, the first one holds 16 slots.
+  ///
+  void grow() {
+    size_type n = capacity ? size_type(capacity) * 2 : 16;
+    if (n > size_type(max_slots))
+      n = max_slots;
+    if (n <= capacity || n > nodeAlloc.max_size())
+      throw std::length_error("CompactRedBlackTree::grow");
+    node *fresh = nodeAlloc.allocate(n);
+    if (nodes == 0) {
+      nodes = fresh;
+      capacity = node_ptr(n);
+      resetArena();
+      return;
+    }
+    try {
+      copyArena(fresh, nodes, used, trivial_type());
+    } catch (...) {
+      nodeAlloc.deallocate(fresh, n);
+      __throw_exception_again;
+    }
+    destroyValues(trivial_type());
+    nodeAlloc.deallocate(nodes, capacity);
+    nodes = fresh;
+    capacity = node_ptr(n);
+  }
+
+  /// Only the null node and an empty header, the rest of the arena is free.
+  void resetArena() {
+    nodes[null_node].parentColor = 0;
+    nodes[null_node].left = null_node;
+    nodes[null_node].right = null_node;
+    nodes[header_node].parentColor = Red;
+    nodes[header_node].left = header_node;
+    nodes[header_node].right = header_node;
+    used = 2;
+    freeList = null_node;
+    nodeCount = 0;
+  }
+
+  ///
+  /// @brief Copy the slots [0, n) of src to dst, values included.
+  ///
+  void copyArena(node *dst, const node *src, node_ptr n, ft::true_type) {
+    std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                n * sizeof(node));
+  }
+  void copyArena(node *dst, const node *src, node_ptr n, ft::false_type) {
+    for (node_ptr i = 0; i < n; ++i) {
+      dst[i].parentColor = src[i].parentColor;
+      dst[i].left = src[i].left;
+      dst[i].right = src[i].right;
+    }
+    algorithms_type algo((CompactRedBlackTreeLinks<Value>(dst)));
+    allocator_type alloc = get_allocator();
+    node_ptr x = dst[header_node].left;
+    try {
+      for (; x != header_node; x = algo.increment(x))
+        alloc.construct(&dst[x].value, src[x].value);
+    } catch (...) {
+      for (node_ptr y = dst[header_node].left; y != x; y = algo.increment(y))
+        alloc.destroy(&dst[y].value);
+      __throw_exception_again;
+    }
+  }
+
+  /// Destroy the value of every node in the tree.
+  void destroyValues(ft::true_type) {}
+  void destroyValues(ft::false_type) {
+    algorithms_type algo = algorithms();
+    allocator_type alloc = get_allocator();
+    for (node_ptr x = leftmost(); x != header_node; x = algo.increment(x))
+      alloc.destroy(&nodes[x].value);
+  }
+
+  iterator insert_(node_ptr x, node_ptr p, const Value &v) {
+    bool insert_left = (x != 0 || p == header_node ||
+                        keyCompare(KeyOfValue()(v), key(p)));
+    // May grow the arena, indices stay valid.
+    node_ptr z = create_node(v);
+    algorithms().insert_and_rebalance(insert_left, z, p, header_node);
+    ++nodeCount;
+    return iterator(this, z);
+  }
+
+  void erase_internal_helper(node_ptr position) {
+    node_ptr y = algorithms().rebalance_for_erase(position, header_node);
+    get_allocator().destroy(&nodes[y].value);
+    put_node(y);
+    // Once empty, start again from the front of the arena.
+    if (--nodeCount == 0)
+      resetArena();
+  }
+
+  node_ptr find_internal(const Key &k) const {
+    node_ptr j = lower_bound_internal(root(), header_node, k);
+    return (j == header_node || keyCompare(k, key(j))) ? node_ptr(header_node)
+                                                       : j;
+  }
+
+  node_ptr lower_bound_internal(node_ptr x, node_ptr y, const Key &k) const {
+    while (x != 0)
+      if (!keyCompare(key(x), k))
+        y = x, x = left(x);
+      else
+        x = right(x);
+    return y;
+  }
+
+  node_ptr upper_bound_internal(node_ptr x, node_ptr y, const Key &k) const {
+    while (x != 0)
+      if (keyCompare(k, key(x)))
+        y = x, x = left(x);
+      else
+        x = right(x);
+    return y;
+  }
+
+  pair<node_ptr, node_ptr> equal_range_internal(const Key &k) const {
+    node_ptr x = root();
+    node_ptr y = header_node;
+    while (x != 0) {
+      if (keyCompare(key(x), k))
+        x = right(x);
+      else if (keyCompare(k, key(x)))
+        y = x, x = left(x);
+      else {
+        node_ptr xu = right(x);
+        return pair<node_ptr, node_ptr>(lower_bound_internal(left(x), x, k),
+                                        upper_bound_internal(xu, y, k));
+      }
+    }
+    return pair<node_ptr, node_ptr>(y, y);
+  }
+
+  ///
+  /// @brief Get the unique position to insert the new node, second is 0 if
+  /// the key is already in first.
+  ///
+  /// @param k
+  /// @return pair<node_ptr, node_ptr>
+  ///
+  pair<node_ptr, node_ptr> get_insert_unique_pos(const key_type &k) const {
+    typedef pair<node_ptr, node_ptr> Res;
+    node_ptr x = root();
+    node_ptr y = header_node;
+    bool comp = true;
+    while (x != 0) {
+      y = x;
+      comp = keyCompare(k, key(x));
+      x = comp ? left(x) : right(x);
+    }
+    node_ptr j = y;
+    if (comp) {
+      if (j == leftmost())
+        return Res(x, y);
+      else
+        j = algorithms().decrement(j);
+    }
+    if (keyCompare(key(j), k))
+      return Res(x, y);
+    /// Key already exists.
+    return Res(j, 0);
+  }
+
+  pair<node_ptr, node_ptr> get_insert_hint_unique_pos(node_ptr pos,
+                                                      const key_type &k) const {
+    typedef pair<node_ptr, node_ptr> Res;
+    // end()
+    if (pos == header_node) {
+      if (size() > 0 && keyCompare(key(rightmost()), k))
+        return Res(0, rightmost());
+      else
+        return get_insert_unique_pos(k);
+    } else if (keyCompare(k, key(pos))) {
+      // First, try before...
+      if (pos == leftmost()) // begin()
+        return Res(leftmost(), leftmost());
+      node_ptr before = algorithms().decrement(pos);
+      if (keyCompare(key(before), k)) {
+        if (right(before) == 0)
+          return Res(0, before);
+        else
+          return Res(pos, pos);
+      } else
+        return get_insert_unique_pos(k);
+    } else if (keyCompare(key(pos), k)) {
+      // ... then try after.
+      if (pos == rightmost())
+        return Res(0, rightmost());
+      node_ptr after = algorithms().increment(pos);
+      if (keyCompare(k, key(after))) {
+        if (right(pos) == 0)
+          return Res(0, pos);
+        else
+          return Res(after, after);
+      } else
+        return get_insert_unique_pos(k);
+    } else
+      // Equivalent keys.
+      return Res(pos, 0);
+  }
+
+  ///
+  /// @brief Get the position after the equal keys.
+  ///
+  /// @param k
+  /// @return pair<node_ptr, node_ptr>
+  ///
+  pair<node_ptr, node_ptr> get_insert_equal_pos(const key_type &k) const {
+    node_ptr x = root();
+    node_ptr y = header_node;
+    while (x != 0) {
+      y = x;
+      x = keyCompare(k, key(x)) ? left(x) : right(x);
+    }
+    return pair<node_ptr, node_ptr>(x, y);
+  }
+
+  ///
+  /// @brief Get the position before the equal keys, the fallback of a hint
+  /// that lies after them.
+  ///
+  /// @param k
+  /// @return pair<node_ptr, node_ptr>
+  ///
+  pair<node_ptr, node_ptr> get_insert_equal_lower_pos(const key_type &k) const {
+    node_ptr x = root();
+    node_ptr y = header_node;
+    while (x != 0) {
+      y = x;
+      x = !keyCompare(key(x), k) ? left(x) : right(x);
+    }
+    // insert_ only goes left on x != 0, make it so for an equal parent.
+    if (y != header_node && !keyCompare(key(y), k))
+      return pair<node_ptr, node_ptr>(y, y);
+    return pair<node_ptr, node_ptr>(x, y);
+  }
+
+  pair<node_ptr, node_ptr> get_insert_hint_equal_pos(node_ptr pos,
+                                                     const key_type &k) const {
+    typedef pair<node_ptr, node_ptr> Res;
+    // end()
+    if (pos == header_node) {
+      if (size() > 0 && !keyCompare(k, key(rightmost())))
+        return Res(0, rightmost());
+      else
+        return get_insert_equal_pos(k);
+    } else if (!keyCompare(key(pos), k)) {
+      // First, try before...
+      if (pos == leftmost()) // begin()
+        return Res(leftmost(), leftmost());
+      node_ptr before = algorithms().decrement(pos);
+      if (!keyCompare(k, key(before))) {
+        if (right(before) == 0)
+          return Res(0, before);
+        else
+          return Res(pos, pos);
+      } else
+        return get_insert_equal_pos(k);
+    } else {
+      // ... then try after.
+      if (pos == rightmost())
+        return Res(0, rightmost());
+      node_ptr after = algorithms().increment(pos);
+      if (!keyCompare(key(after), k)) {
+        if (right(pos) == 0)
+          return Res(0, pos);
+        else
+          return Res(after, after);
+      } else
+        return Res(0, 0);
+    }
+  }
+
+  ///
+  /// @brief Verify if the CompactRedBlackTree is according to the rules.
+  ///
+  /// @return true
+  /// @return false
+  ///
+  bool rb_verify() const {
+    if (nodeCount == 0 || begin() == end())
+      return nodeCount == 0 && begin() == end() &&
+             leftmost() == header_node && rightmost() == header_node;
+    algorithms_type algo = algorithms();
+    unsigned int len = algo.black_count(leftmost(), root());
+    for (const_iterator it = begin(); it != end(); ++it) {
+      node_ptr x = it.node;
+      node_ptr L = left(x);
+      node_ptr R = right(x);
+      // Check if the children of a red node are black.
+      if (algo.color(x) == Red)
+        if ((L && algo.color(L) == Red) || (R && algo.color(R) == Red))
+          return false;
+      // Check that Left and Right have different values.
+      if (L && keyCompare(key(x), key(L)))
+        return false;
+      if (R && keyCompare(key(R), key(x)))
+        return false;
+      // Check if the amount of black nodes is correct.
+      if (!L && !R && algo.black_count(x, root()) != len)
+        return false;
+    }
+    // Check if the leftmost is the minimum node / rightmost is the maximum
+    // node.
+    if (leftmost() != algo.minimum(root()))
+      return false;
+    if (rightmost() != algo.maximum(root()))
+      return false;
+    return true;
+  }
+};
+
+template <typename Key, typename Val, typename KeyOfValue, typename Compare,
+          typename Alloc>
+inline bool
+operator==(const CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
+           const CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+  return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+template <typename Key, typename Val, typename KeyOfValue, typename Compare,
+          typename Alloc>
+inline bool
+operator<(const CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
+          const CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+  return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+template <typename Key, typename Val, typename KeyOfValue, typename Compare,
+          typename Alloc>
+inline void
+swap(CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
+     CompactRedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+  x.swap(y);
+}
+
+///
+/// @brief Node policy of ft::map and ft::set for a CompactRedBlackTree.
+///
+///    ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int,
+///    int> >, ft::compact_nodes>
+///
+struct compact_nodes {
+  template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+            typename Alloc>
+  struct tree {
+    typedef CompactRedBlackTree<Key, Value, KeyOfValue, Compare, Alloc> type;
+  };
+};
+
+} // namespace ft
+
+#endif
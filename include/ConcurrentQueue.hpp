@@ -0,0 +1,387 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConcurrentQueue.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONCURRENTQUEUE_HPP
+#define CONCURRENTQUEUE_HPP
+
+#include "AlignedAllocator.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+///
+/// @brief Bounded lock-free queues for handing values between threads.
+///
+///    spsc_queue: one producer thread and one consumer thread, every
+///    operation is wait-free.
+///    mpmc_queue: any number of producers and consumers, lock-free (a sequence
+///    number per slot, one CAS per operation or per batch).
+///
+///    Both have a power of two capacity fixed at construction. try_push fails
+///    when the queue is full and try_pop when it is empty, callers choose how
+///    to wait. The producer and consumer indices live on separate cache lines.
+///    T's copy constructor must not throw.
+///
+///    C++98 has no <atomic>, the GCC/clang __atomic builtins are used.
+///
+
+namespace ft {
+
+///
+/// @brief Round n up to a power of two, at least 2.
+///
+inline std::size_t queueCapacity(std::size_t n, const char *s) {
+  if (n > (std::size_t(-1) >> 1) + 1)
+    throw std::length_error(s);
+  std::size_t cap = 2;
+  while (cap < n)
+    cap <<= 1;
+  return cap;
+}
+
+///
+/// @brief Wait-free single-producer/single-consumer ring queue.
+///
+/// Each side keeps a cached copy of the other side's index and only reloads
+/// it when the queue looks full (producer) or empty (consumer).
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <class T, class Allocator = ft::aligned_allocator<T> >
+class spsc_queue {
+
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef std::size_t size_type;
+
+  ///
+  /// @brief Construct a new spsc_queue holding at least capacity values.
+  ///
+  /// @param capacity Rounded up to a power of two
+  /// @param alloc
+  ///
+  explicit spsc_queue(size_type capacity,
+                      const allocator_type &alloc = allocator_type())
+      : alloc(alloc), mask(queueCapacity(capacity, "spsc_queue") - 1),
+        slots(this->alloc.allocate(mask + 1)) {
+    producer.index = 0;
+    producer.cache = 0;
+    consumer.index = 0;
+    consumer.cache = 0;
+  }
+
+  ~spsc_queue() {
+    for (size_type i = consumer.index; i != producer.index; ++i)
+      alloc.destroy(slots + (i & mask));
+    alloc.deallocate(slots, mask + 1);
+  }
+
+  size_type capacity() const { return mask + 1; }
+
+  ///
+  /// @brief Number of values queued, exact only when both sides are idle.
+  ///
+  size_type size_approx() const {
+    return __atomic_load_n(&producer.index, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&consumer.index, __ATOMIC_ACQUIRE);
+  }
+  bool empty() const { return size_approx() == 0; }
+
+  /// ---------- Producer side
+
+  ///
+  /// @brief Enqueue a copy of val.
+  ///
+  /// @param val
+  /// @return false if the queue is full
+  ///
+  bool try_push(const value_type &val) {
+    if (freeSlots(1) == 0)
+      return false;
+    const size_type tail = producer.index;
+    alloc.construct(slots + (tail & mask), val);
+    __atomic_store_n(&producer.index, tail + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  ///
+  /// @brief Enqueue up to n values from src, published with one store.
+  ///
+  /// @param src
+  /// @param n
+  /// @return size_type Number of values enqueued
+  ///
+  size_type push_many(const value_type *src, size_type n) {
+    const size_type k = std::min(n, freeSlots(n));
+    const size_type tail = producer.index;
+    for (size_type i = 0; i < k; i++)
+      alloc.construct(slots + ((tail + i) & mask), src[i]);
+    __atomic_store_n(&producer.index, tail + k, __ATOMIC_RELEASE);
+    return k;
+  }
+
+  /// ---------- Consumer side
+
+  ///
+  /// @brief Dequeue the oldest value into out.
+  ///
+  /// @param out
+  /// @return false if the queue is empty
+  ///
+  bool try_pop(value_type &out) {
+    if (usedSlots(1) == 0)
+      return false;
+    const size_type head = consumer.index;
+    out = slots[head & mask];
+    alloc.destroy(slots + (head & mask));
+    __atomic_store_n(&consumer.index, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  ///
+  /// @brief Dequeue up to n values into dst, released with one store.
+  ///
+  /// @param dst
+  /// @param n
+  /// @return size_type Number of values dequeued
+  ///
+  size_type pop_many(value_type *dst, size_type n) {
+    const size_type k = std::min(n, usedSlots(n));
+    const size_type head = consumer.index;
+    for (size_type i = 0; i < k; i++) {
+      dst[i] = slots[(head + i) & mask];
+      alloc.destroy(slots + ((head + i) & mask));
+    }
+    __atomic_store_n(&consumer.index, head + k, __ATOMIC_RELEASE);
+    return k;
+  }
+
+private:
+  spsc_queue(const spsc_queue &);
+  spsc_queue &operator=(const spsc_queue &);
+
+  /// One side's own index and its cached copy of the other side's index.
+  struct Side {
+    size_type index;
+    size_type cache;
+    char pad[ft::cache_line_size - 2 * sizeof(size_type)];
+  };
+
+  /// Free slots seen by the producer, the consumer index is only reloaded if
+  /// the cached one shows less than wanted.
+  size_type freeSlots(size_type wanted) {
+    size_type free = capacity() - (producer.index - producer.cache);
+    if (free < wanted) {
+      producer.cache = __atomic_load_n(&consumer.index, __ATOMIC_ACQUIRE);
+      free = capacity() - (producer.index - producer.cache);
+    }
+    return free;
+  }
+
+  /// Queued values seen by the consumer.
+  size_type usedSlots(size_type wanted) {
+    size_type used = consumer.cache - consumer.index;
+    if (used < wanted) {
+      consumer.cache = __atomic_load_n(&producer.index, __ATOMIC_ACQUIRE);
+      used = consumer.cache - consumer.index;
+    }
+    return used;
+  }
+
+  char pad0[ft::cache_line_size];
+  Side producer;
+  Side consumer;
+  allocator_type alloc;
+  const size_type mask;
+  const pointer slots;
+};
+
+///
+/// @brief Bounded lock-free multi-producer/multi-consumer queue.
+///
+///    Every slot carries a sequence number telling which lap of the ring may
+///    use it next: a producer claims position pos when seq == pos, a consumer
+///    when seq == pos + 1. Claiming is one CAS on the shared enqueue or
+///    dequeue position, a batch claims a run of ready slots with one CAS.
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <class T, class Allocator = ft::aligned_allocator<T> >
+class mpmc_queue {
+  typedef typename Allocator::template rebind<std::size_t>::other
+      seq_allocator;
+
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef std::size_t size_type;
+
+  ///
+  /// @brief Construct a new mpmc_queue holding at least capacity values.
+  ///
+  /// @param capacity Rounded up to a power of two
+  /// @param alloc
+  ///
+  explicit mpmc_queue(size_type capacity,
+                      const allocator_type &alloc = allocator_type())
+      : alloc(alloc), mask(queueCapacity(capacity, "mpmc_queue") - 1),
+        slots(this->alloc.allocate(mask + 1)) {
+    try {
+      seq = seq_allocator(alloc).allocate(mask + 1);
+    } catch (...) {
+      this->alloc.deallocate(slots, mask + 1);
+      __throw_exception_again;
+    }
+    for (size_type i = 0; i <= mask; i++)
+      seq[i] = i;
+    enqueuePos.value = 0;
+    dequeuePos.value = 0;
+  }
+
+  ~mpmc_queue() {
+    for (size_type i = dequeuePos.value; i != enqueuePos.value; ++i)
+      alloc.destroy(slots + (i & mask));
+    seq_allocator(alloc).deallocate(seq, mask + 1);
+    alloc.deallocate(slots, mask + 1);
+  }
+
+  size_type capacity() const { return mask + 1; }
+
+  ///
+  /// @brief Number of values claimed by producers and not yet by consumers,
+  /// exact only when no thread is working on the queue.
+  ///
+  size_type size_approx() const {
+    const size_type tail = __atomic_load_n(&enqueuePos.value, __ATOMIC_ACQUIRE);
+    const size_type head = __atomic_load_n(&dequeuePos.value, __ATOMIC_ACQUIRE);
+    return tail > head ? tail - head : 0;
+  }
+  bool empty() const { return size_approx() == 0; }
+
+  ///
+  /// @brief Enqueue a copy of val.
+  ///
+  /// @param val
+  /// @return false if the queue is full
+  ///
+  bool try_push(const value_type &val) { return push_many(&val, 1) == 1; }
+
+  ///
+  /// @brief Enqueue up to n values from src, claiming their slots with one
+  /// CAS. The values are consecutive in the queue.
+  ///
+  /// @param src
+  /// @param n
+  /// @return size_type Number of values enqueued
+  ///
+  size_type push_many(const value_type *src, size_type n) {
+    size_type pos;
+    const size_type k = claim(enqueuePos.value, 0, n, pos);
+    for (size_type i = 0; i < k; i++) {
+      alloc.construct(slots + ((pos + i) & mask), src[i]);
+      __atomic_store_n(seq + ((pos + i) & mask), pos + i + 1, __ATOMIC_RELEASE);
+    }
+    return k;
+  }
+
+  ///
+  /// @brief Dequeue the oldest value into out.
+  ///
+  /// @param out
+  /// @return false if the queue is empty
+  ///
+  bool try_pop(value_type &out) { return pop_many(&out, 1) == 1; }
+
+  ///
+  /// @brief Dequeue up to n consecutive values into dst, claiming their slots
+  /// with one CAS.
+  ///
+  /// @param dst
+  /// @param n
+  /// @return size_type Number of values dequeued
+  ///
+  size_type pop_many(value_type *dst, size_type n) {
+    size_type pos;
+    const size_type k = claim(dequeuePos.value, 1, n, pos);
+    for (size_type i = 0; i < k; i++) {
+      const size_type s = (pos + i) & mask;
+      dst[i] = slots[s];
+      alloc.destroy(slots + s);
+      __atomic_store_n(seq + s, pos + i + mask + 1, __ATOMIC_RELEASE);
+    }
+    return k;
+  }
+
+private:
+  mpmc_queue(const mpmc_queue &);
+  mpmc_queue &operator=(const mpmc_queue &);
+
+  struct PaddedIndex {
+    size_type value;
+    char pad[ft::cache_line_size - sizeof(size_type)];
+  };
+
+  ///
+  /// @brief Claim up to n consecutive slots starting at the shared position
+  /// shared. A slot at position p is ready when its sequence is p + lag.
+  ///
+  /// @param shared enqueuePos or dequeuePos
+  /// @param lag 0 for producers, 1 for consumers
+  /// @param n
+  /// @param pos Set to the first claimed position
+  /// @return size_type Number of slots claimed, 0 if none is ready
+  ///
+  size_type claim(size_type &shared, size_type lag, size_type n,
+                  size_type &pos) {
+    if (n == 0)
+      return 0;
+    pos = __atomic_load_n(&shared, __ATOMIC_RELAXED);
+    for (;;) {
+      const std::ptrdiff_t dif = std::ptrdiff_t(
+          __atomic_load_n(seq + (pos & mask), __ATOMIC_ACQUIRE) - (pos + lag));
+      if (dif < 0)
+        return 0;
+      if (dif > 0) {
+        // Another thread claimed pos already.
+        pos = __atomic_load_n(&shared, __ATOMIC_RELAXED);
+        continue;
+      }
+      size_type k = 1;
+      while (k < n && k <= mask &&
+             __atomic_load_n(seq + ((pos + k) & mask), __ATOMIC_ACQUIRE) ==
+                 pos + k + lag)
+        ++k;
+      if (__atomic_compare_exchange_n(&shared, &pos, pos + k, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        return k;
+    }
+  }
+
+  char pad0[ft::cache_line_size];
+  PaddedIndex enqueuePos;
+  PaddedIndex dequeuePos;
+  allocator_type alloc;
+  const size_type mask;
+  const pointer slots;
+  size_type *seq;
+};
+
+} // namespace ft
+
+#endif
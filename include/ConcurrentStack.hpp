@@ -0,0 +1,299 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConcurrentStack.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONCURRENTSTACK_HPP
+#define CONCURRENTSTACK_HPP
+
+#include "AlignedAllocator.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <pthread.h>
+#include <stdint.h>
+
+namespace ft {
+
+///
+/// @brief Lock-free stack (Treiber stack) for any number of threads.
+///
+///    Nodes come from a pool owned by the stack and are never freed before
+///    the stack is destroyed, they are named by 32-bit indices. The top of
+///    the stack and the pool's free list are 64-bit words holding an index
+///    and a tag bumped by every change, so a CAS cannot succeed on a top
+///    that was popped and pushed back in between (ABA).
+///
+///    When the CAS on the top fails, push and try_pop try to meet in an
+///    elimination array: a push offers its node in a random slot for a
+///    short while and a concurrent try_pop can take it without touching the
+///    top at all.
+///
+///    The pool grows by chunks of doubling size, that takes a mutex. Call
+///    reserve() up front to stay lock-free. T's copy constructor must not
+///    throw once a node is taken.
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <class T, class Allocator = std::allocator<T> >
+class concurrent_stack {
+
+  struct Node {
+    T value;
+    uint32_t next;
+  };
+  typedef typename Allocator::template rebind<Node>::other node_allocator;
+
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef std::size_t size_type;
+
+  explicit concurrent_stack(const allocator_type &alloc = allocator_type())
+      : alloc(alloc), top(0), free(0), chunkCount(0) {
+    pthread_mutex_init(&growLock, NULL);
+    for (size_type i = 0; i < elimination_slots; i++)
+      exchanger[i].value = empty_slot;
+  }
+
+  ~concurrent_stack() {
+    for (uint32_t i = uint32_t(top); i != 0; i = node(i).next)
+      alloc.destroy(&node(i).value);
+    node_allocator nodeAlloc(alloc);
+    for (size_type c = 0; c < chunkCount; c++)
+      nodeAlloc.deallocate(chunks[c], chunkLength(c));
+    pthread_mutex_destroy(&growLock);
+  }
+
+  ///
+  /// @brief Push a copy of val.
+  ///
+  /// @param val
+  ///
+  void push(const value_type &val) {
+    const uint32_t index = takeNode();
+    alloc.construct(&node(index).value, val);
+    for (;;) {
+      if (tryLink(top, index))
+        return;
+      if (offer(index))
+        return;
+    }
+  }
+
+  ///
+  /// @brief Pop the top value into out.
+  ///
+  /// @param out
+  /// @return false if the stack was empty
+  ///
+  bool try_pop(value_type &out) {
+    for (;;) {
+      uint32_t index;
+      const int res = tryUnlink(top, index);
+      if (res < 0)
+        return false;
+      if (res == 0 && !takeOffer(index))
+        continue;
+      Node &n = node(index);
+      out = n.value;
+      alloc.destroy(&n.value);
+      releaseNode(index);
+      return true;
+    }
+  }
+
+  ///
+  /// @brief True if the stack looked empty.
+  ///
+  bool empty() const {
+    return uint32_t(__atomic_load_n(&top, __ATOMIC_ACQUIRE)) == 0;
+  }
+
+  ///
+  /// @brief Grow the node pool to at least n nodes.
+  ///
+  /// @param n
+  ///
+  void reserve(size_type n) {
+    pthread_mutex_lock(&growLock);
+    while (poolSize() < n && chunkCount < max_chunks)
+      addChunk();
+    pthread_mutex_unlock(&growLock);
+  }
+
+private:
+  concurrent_stack(const concurrent_stack &);
+  concurrent_stack &operator=(const concurrent_stack &);
+
+  enum { first_chunk = 64, max_chunks = 26, elimination_slots = 8 };
+  enum { elimination_spins = 64 };
+  static const uint32_t empty_slot = 0;
+  static const uint32_t taken_slot = 0xFFFFFFFFu;
+
+  struct PaddedSlot {
+    uint32_t value;
+    char pad[ft::cache_line_size - sizeof(uint32_t)];
+  };
+
+  /// ---------- Tagged list heads: high 32 bits tag, low 32 bits index + 1
+
+  static uint64_t makeHead(uint64_t old, uint32_t index) {
+    return (((old >> 32) + 1) << 32) | index;
+  }
+
+  /// Push the node index on the list head, one attempt.
+  bool tryLink(uint64_t &head, uint32_t index) {
+    uint64_t old = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    // Racy readers may still see this node in the list, hence the atomic.
+    __atomic_store_n(&node(index).next, uint32_t(old), __ATOMIC_RELAXED);
+    return __atomic_compare_exchange_n(&head, &old, makeHead(old, index), false,
+                                       __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+  }
+
+  /// Pop a node index off the list head, one attempt: 1 on success, 0 if
+  /// the CAS lost, -1 if the list is empty.
+  int tryUnlink(uint64_t &head, uint32_t &index) {
+    uint64_t old = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    index = uint32_t(old);
+    if (index == 0)
+      return -1;
+    // The node may be popped and reused meanwhile, the read stays in the
+    // pool and the tag makes the CAS fail then.
+    const uint32_t next = __atomic_load_n(&node(index).next, __ATOMIC_RELAXED);
+    return __atomic_compare_exchange_n(&head, &old, makeHead(old, next), false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+  }
+
+  /// ---------- Node pool
+
+  /// Node index (1 based) -> chunk c holds indices from
+  /// first_chunk * (2^c - 1) + 1, chunk c has first_chunk * 2^c nodes.
+  Node &node(uint32_t index) const {
+    const uint32_t i = index - 1;
+    const unsigned c = 31 - __builtin_clz(i / first_chunk + 1);
+    Node *chunk = __atomic_load_n(&chunks[c], __ATOMIC_ACQUIRE);
+    return chunk[i - first_chunk * ((1u << c) - 1)];
+  }
+  static size_type chunkLength(size_type c) {
+    return size_type(first_chunk) << c;
+  }
+  size_type poolSize() const {
+    return size_type(first_chunk) * ((size_type(1) << chunkCount) - 1);
+  }
+
+  uint32_t takeNode() {
+    for (;;) {
+      uint32_t index;
+      const int res = tryUnlink(free, index);
+      if (res > 0)
+        return index;
+      if (res < 0) {
+        pthread_mutex_lock(&growLock);
+        try {
+          if (uint32_t(__atomic_load_n(&free, __ATOMIC_ACQUIRE)) == 0)
+            addChunk();
+        } catch (...) {
+          pthread_mutex_unlock(&growLock);
+          __throw_exception_again;
+        }
+        pthread_mutex_unlock(&growLock);
+      }
+    }
+  }
+
+  void releaseNode(uint32_t index) {
+    while (!tryLink(free, index))
+      ;
+  }
+
+  /// Add the next chunk to the pool and its nodes to the free list, called
+  /// with growLock held.
+  void addChunk() {
+    if (chunkCount == max_chunks)
+      throw std::bad_alloc();
+    const size_type c = chunkCount;
+    Node *chunk = node_allocator(alloc).allocate(chunkLength(c));
+    __atomic_store_n(&chunks[c], chunk, __ATOMIC_RELEASE);
+    ++chunkCount;
+    const uint32_t first = uint32_t(first_chunk * ((1u << c) - 1) + 1);
+    const uint32_t last = uint32_t(first + chunkLength(c) - 1);
+    for (uint32_t i = first; i < last; i++)
+      chunk[i - first].next = i + 1;
+    // Splice the whole chain in front of the free list with one CAS.
+    uint64_t old = __atomic_load_n(&free, __ATOMIC_RELAXED);
+    do
+      chunk[last - first].next = uint32_t(old);
+    while (!__atomic_compare_exchange_n(&free, &old, makeHead(old, first),
+                                        false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+  }
+
+  /// ---------- Elimination
+
+  size_type randomSlot() const {
+    static __thread uint32_t seed = 0;
+    if (seed == 0)
+      seed = uint32_t(reinterpret_cast<uintptr_t>(&seed)) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed % elimination_slots;
+  }
+
+  /// Offer the node to a popper for a while, true if one took it.
+  bool offer(uint32_t index) {
+    uint32_t &slot = exchanger[randomSlot()].value;
+    uint32_t expected = empty_slot;
+    if (!__atomic_compare_exchange_n(&slot, &expected, index, false,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+      return false;
+    for (int i = 0; i < elimination_spins; i++)
+      if (__atomic_load_n(&slot, __ATOMIC_RELAXED) == taken_slot)
+        break;
+    expected = index;
+    if (__atomic_compare_exchange_n(&slot, &expected, empty_slot, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      return false;
+    // A popper took the node, free the slot for the next offer.
+    __atomic_store_n(&slot, empty_slot, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /// Take a node offered by a pusher, true on success.
+  bool takeOffer(uint32_t &index) {
+    uint32_t &slot = exchanger[randomSlot()].value;
+    uint32_t offered = __atomic_load_n(&slot, __ATOMIC_ACQUIRE);
+    if (offered == empty_slot || offered == taken_slot)
+      return false;
+    if (!__atomic_compare_exchange_n(&slot, &offered, taken_slot, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      return false;
+    index = offered;
+    return true;
+  }
+
+  allocator_type alloc;
+  char pad0[ft::cache_line_size];
+  uint64_t top;
+  char pad1[ft::cache_line_size - sizeof(uint64_t)];
+  uint64_t free;
+  char pad2[ft::cache_line_size - sizeof(uint64_t)];
+  PaddedSlot exchanger[elimination_slots];
+  Node *chunks[max_chunks];
+  size_type chunkCount;
+  pthread_mutex_t growLock;
+};
+
+} // namespace ft
+
+#endif
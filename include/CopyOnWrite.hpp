@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CopyOnWrite.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:10:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef COPYONWRITE_HPP
+#define COPYONWRITE_HPP
+
+#include "utility.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace ft {
+
+///
+/// @brief Shares one Container between its copies until one of them writes.
+///
+///    Copying the wrapper takes a reference on the shared block, O(1),
+///    however big the container is. Reads go through operator* and
+///    operator->, which only give const access. write() first detaches: a
+///    shared container is copied once, then the writer owns its copy. A
+///    table that is built once and then passed around read-only is never
+///    copied again.
+///
+///    ft::copy_on_write<ft::vector<int> > v;
+///    ft::copy_on_write<ft::map<std::string, int> > m;
+///
+///    The reference returned by write(), and iterators taken from it, must
+///    not be kept across a copy of the wrapper: the copy would see the
+///    later writes. The reference count is atomic (the __atomic builtins),
+///    so wrappers sharing a container can be used, written and dropped on
+///    different threads; one wrapper object is not thread-safe.
+///
+/// @tparam Container A copyable container with an allocator_type
+///
+template <typename Container> class copy_on_write {
+
+  struct Block {
+    explicit Block(const Container &c) : refs(1), value(c) {}
+    std::size_t refs;
+    Container value;
+  };
+  typedef typename Container::allocator_type::template rebind<Block>::other
+      block_allocator;
+
+public:
+  typedef Container container_type;
+  typedef std::size_t size_type;
+
+  /// ---------- Ctors & operators
+
+  copy_on_write() : block(makeBlock(Container())) {}
+  explicit copy_on_write(const Container &c) : block(makeBlock(c)) {}
+  /// Shares the container of x, O(1).
+  copy_on_write(const copy_on_write &x) : block(x.block) { retain(block); }
+  copy_on_write &operator=(const copy_on_write &x) {
+    retain(x.block);
+    release(block);
+    block = x.block;
+    return *this;
+  }
+  copy_on_write &operator=(const Container &c) {
+    if (unique())
+      block->value = c;
+    else {
+      Block *b = makeBlock(c);
+      release(block);
+      block = b;
+    }
+    return *this;
+  }
+  ~copy_on_write() { release(block); }
+
+  /// ---------- Access
+
+  const Container &operator*() const { return block->value; }
+  const Container *operator->() const { return &block->value; }
+  const Container &read() const { return block->value; }
+
+  ///
+  /// @brief Mutable access, copies the container first if it is shared.
+  ///
+  /// @return Container& Valid until this wrapper is copied or destroyed
+  ///
+  Container &write() {
+    if (!unique()) {
+      Block *b = makeBlock(block->value);
+      release(block);
+      block = b;
+    }
+    return block->value;
+  }
+
+  /// Whether no other wrapper shares the container, write() is then free.
+  bool unique() const {
+    return __atomic_load_n(&block->refs, __ATOMIC_ACQUIRE) == 1;
+  }
+  size_type use_count() const {
+    return __atomic_load_n(&block->refs, __ATOMIC_ACQUIRE);
+  }
+
+  void swap(copy_on_write &x) { ft::swap(block, x.block); }
+
+  /// Wrappers sharing their container are equal without a walk.
+  friend bool operator==(const copy_on_write &x, const copy_on_write &y) {
+    return x.block == y.block || x.block->value == y.block->value;
+  }
+  friend bool operator!=(const copy_on_write &x, const copy_on_write &y) {
+    return !(x == y);
+  }
+  friend bool operator<(const copy_on_write &x, const copy_on_write &y) {
+    return x.block != y.block && x.block->value < y.block->value;
+  }
+
+private:
+  static Block *makeBlock(const Container &c) {
+    block_allocator alloc;
+    Block *b = alloc.allocate(1);
+    try {
+      ::new (static_cast<void *>(b)) Block(c);
+    } catch (...) {
+      alloc.deallocate(b, 1);
+      __throw_exception_again;
+    }
+    return b;
+  }
+
+  static void retain(Block *b) {
+    __atomic_add_fetch(&b->refs, 1, __ATOMIC_RELAXED);
+  }
+
+  static void release(Block *b) {
+    if (__atomic_sub_fetch(&b->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+      b->~Block();
+      block_allocator().deallocate(b, 1);
+    }
+  }
+
+  Block *block;
+};
+
+template <typename Container>
+inline void swap(copy_on_write<Container> &x, copy_on_write<Container> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
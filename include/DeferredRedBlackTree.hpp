@@ -0,0 +1,316 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DeferredRedBlackTree.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:40:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 19:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DEFERREDREDBLACKTREE_HPP
+#define DEFERREDREDBLACKTREE_HPP
+
+#include "RedBlackTree.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <pthread.h>
+#include <stdexcept>
+
+namespace ft {
+
+///
+/// @brief Frees the nodes of detached trees a bounded amount at a time,
+/// from collect() calls or from a background thread.
+///
+///    A tree retired here was unlinked from its container in O(1), only
+///    its root is queued. collect(budget) then does at most budget units
+///    of work, one unit per node freed or per rotation, so the caller
+///    decides how long a pause may be; start() runs the same loop on a
+///    reclaimer thread instead. The values are destroyed by whichever
+///    thread collects them.
+///
+///    The reclaimer must outlive the trees that use it. Its destructor
+///    stops the thread and frees whatever is still queued.
+///
+class tree_reclaimer {
+public:
+  typedef std::size_t size_type;
+  /// Frees up to budget units of the tree rooted at x, updates x and
+  /// returns the units done.
+  typedef size_type (*drop_function)(RedBlackTreeNodeBase *&x,
+                                     size_type budget);
+
+  tree_reclaimer()
+      : head(0), tail(0), queued(0), busy(0), batch(0), running(false),
+        stopping(false) {
+    pthread_mutex_init(&lock, 0);
+    pthread_cond_init(&wake, 0);
+  }
+  ~tree_reclaimer() {
+    stop();
+    collect_all();
+    pthread_cond_destroy(&wake);
+    pthread_mutex_destroy(&lock);
+  }
+
+  ///
+  /// @brief Queues a detached tree, O(1). When the queue entry cannot be
+  /// allocated the tree is freed right away.
+  ///
+  void retire(RedBlackTreeNodeBase *root, drop_function drop) {
+    Entry *e = 0;
+    try {
+      e = std::allocator<Entry>().allocate(1);
+    } catch (...) {
+      while (root != 0)
+        drop(root, size_type(-1));
+      return;
+    }
+    e->root = root;
+    e->drop = drop;
+    e->next = 0;
+    pthread_mutex_lock(&lock);
+    if (tail != 0)
+      tail->next = e;
+    else
+      head = e;
+    tail = e;
+    ++queued;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+  }
+
+  ///
+  /// @brief Frees queued nodes for at most budget units of work.
+  ///
+  /// @return size_type Units done, less than budget once the queue is empty
+  ///
+  size_type collect(size_type budget) {
+    size_type done = 0;
+    while (done < budget) {
+      pthread_mutex_lock(&lock);
+      Entry *e = head;
+      if (e != 0) {
+        head = e->next;
+        if (head == 0)
+          tail = 0;
+        --queued;
+        ++busy;
+      }
+      pthread_mutex_unlock(&lock);
+      if (e == 0)
+        break;
+      done += e->drop(e->root, budget - done);
+      pthread_mutex_lock(&lock);
+      --busy;
+      if (e->root != 0)
+        push(e);
+      pthread_mutex_unlock(&lock);
+      if (e->root == 0)
+        std::allocator<Entry>().deallocate(e, 1);
+    }
+    return done;
+  }
+  void collect_all() {
+    while (collect(size_type(-1)) != 0)
+      ;
+  }
+
+  /// Number of retired trees not completely freed yet.
+  size_type pending() const {
+    pthread_mutex_lock(&lock);
+    const size_type n = queued + busy;
+    pthread_mutex_unlock(&lock);
+    return n;
+  }
+
+  ///
+  /// @brief Starts the reclaimer thread, it collects batch units at a time
+  /// while the queue is not empty.
+  ///
+  /// @throw std::runtime_error if the thread cannot be created
+  ///
+  void start(size_type units = 4096) {
+    if (running)
+      return;
+    batch = units;
+    stopping = false;
+    if (pthread_create(&thread, 0, &reclaimerMain, this) != 0)
+      throw std::runtime_error("tree_reclaimer::start");
+    running = true;
+  }
+  /// Joins the reclaimer thread, the queue is kept.
+  void stop() {
+    if (!running)
+      return;
+    pthread_mutex_lock(&lock);
+    stopping = true;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(thread, 0);
+    running = false;
+  }
+
+private:
+  struct Entry {
+    RedBlackTreeNodeBase *root;
+    drop_function drop;
+    Entry *next;
+  };
+
+  tree_reclaimer(const tree_reclaimer &);
+  tree_reclaimer &operator=(const tree_reclaimer &);
+
+  /// A partly freed tree goes back in front, it is the oldest one.
+  void push(Entry *e) {
+    e->next = head;
+    head = e;
+    if (tail == 0)
+      tail = e;
+    ++queued;
+  }
+
+  static void *reclaimerMain(void *arg) {
+    tree_reclaimer *r = static_cast<tree_reclaimer *>(arg);
+    for (;;) {
+      pthread_mutex_lock(&r->lock);
+      while (r->head == 0 && !r->stopping)
+        pthread_cond_wait(&r->wake, &r->lock);
+      const bool stop = r->stopping;
+      pthread_mutex_unlock(&r->lock);
+      if (stop)
+        return 0;
+      r->collect(r->batch);
+    }
+  }
+
+  Entry *head;
+  Entry *tail;
+  size_type queued;
+  size_type busy;
+  size_type batch;
+  bool running;
+  bool stopping;
+  mutable pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_t thread;
+};
+
+///
+/// @brief RedBlackTree whose clear(), assignment and destruction hand the
+/// nodes to a tree_reclaimer instead of freeing them on the spot.
+///
+///    Without a reclaimer (the default) it behaves as RedBlackTree. With
+///    one, dropping a tree of any size costs the caller O(1): the header is
+///    reset and the root queued. The reclaimer is set per tree and stays
+///    with the tree object through swap() and assignment, a copy
+///    constructed tree uses the same one.
+///
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc = std::allocator<Value> >
+class DeferredRedBlackTree
+    : public RedBlackTree<Key, Value, KeyOfValue, Compare, Alloc> {
+  typedef RedBlackTree<Key, Value, KeyOfValue, Compare, Alloc> base;
+
+public:
+  typedef typename base::allocator_type allocator_type;
+  typedef typename base::node_allocator_type node_allocator_type;
+  typedef typename base::size_type size_type;
+  typedef typename base::iterator iterator;
+  typedef typename base::const_iterator const_iterator;
+
+  DeferredRedBlackTree() : base(), reclaimer(0) {}
+  DeferredRedBlackTree(const Compare &comp,
+                       const allocator_type &a = allocator_type())
+      : base(comp, a), reclaimer(0) {}
+  DeferredRedBlackTree(const DeferredRedBlackTree &x)
+      : base(x), reclaimer(x.reclaimer) {}
+  ~DeferredRedBlackTree() { retire(); }
+
+  DeferredRedBlackTree &operator=(const DeferredRedBlackTree &x) {
+    if (this != &x) {
+      // Nothing left for the base to reuse or free.
+      retire();
+      base::operator=(x);
+    }
+    return *this;
+  }
+
+  void clear() { retire(); }
+  using base::erase;
+  void erase(iterator first, iterator last) {
+    if (first == this->begin() && last == this->end())
+      clear();
+    else
+      base::erase(first, last);
+  }
+  void erase(const_iterator first, const_iterator last) {
+    if (first == this->begin() && last == this->end())
+      clear();
+    else
+      base::erase(first, last);
+  }
+
+  /// The reclaimer that frees the dropped nodes, 0 to free them at once.
+  void set_reclaimer(tree_reclaimer *r) { reclaimer = r; }
+  tree_reclaimer *get_reclaimer() const { return reclaimer; }
+
+private:
+  typedef typename base::node node;
+
+  void retire() {
+    RedBlackTreeNodeBase *r = this->root();
+    if (r == 0)
+      return;
+    if (reclaimer == 0) {
+      base::clear();
+      return;
+    }
+    this->internalData.reset();
+    reclaimer->retire(r, &dropNodes);
+  }
+
+  ///
+  /// @brief Frees the tree x without recursion: a node with a left child
+  /// is rotated right, a node without one is freed and x moves right.
+  ///
+  static size_type dropNodes(RedBlackTreeNodeBase *&x, size_type budget) {
+    size_type done = 0;
+    for (; x != 0 && done < budget; ++done) {
+      RedBlackTreeNodeBase *y = x->left;
+      if (y != 0) {
+        x->left = y->right;
+        y->right = x;
+        x = y;
+      } else {
+        node *n = static_cast<node *>(x);
+        x = x->right;
+        allocator_type(node_allocator_type()).destroy(n->valPtr());
+        node_allocator_type().deallocate(n, 1);
+      }
+    }
+    return done;
+  }
+
+  tree_reclaimer *reclaimer;
+};
+
+///
+/// @brief Node policy of ft::map and ft::set for a DeferredRedBlackTree,
+/// see map::set_reclaimer().
+///
+struct deferred_nodes {
+  template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+            typename Alloc>
+  struct tree {
+    typedef DeferredRedBlackTree<Key, Value, KeyOfValue, Compare, Alloc> type;
+  };
+};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FirstTouchAllocator.hpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:40:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FIRSTTOUCHALLOCATOR_HPP
+#define FIRSTTOUCHALLOCATOR_HPP
+
+#include "AlignedAllocator.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <memory>
+
+namespace ft {
+
+///
+/// @brief std::allocator opting ft::vector into parallel first touch on
+/// the threads of ft::parallel::default_pool().
+///
+/// @tparam T
+/// @tparam ThresholdBytes See allocator_first_touch, 64 MiB by default
+///
+template <typename T, std::size_t ThresholdBytes = std::size_t(1) << 26>
+class first_touch_allocator : public std::allocator<T> {
+public:
+  template <typename U> struct rebind {
+    typedef first_touch_allocator<U, ThresholdBytes> other;
+  };
+
+  first_touch_allocator() throw() {}
+  first_touch_allocator(const first_touch_allocator &x) throw()
+      : std::allocator<T>(x) {}
+  template <typename U>
+  first_touch_allocator(const first_touch_allocator<U, ThresholdBytes> &) throw() {}
+  ~first_touch_allocator() throw() {}
+};
+
+///
+/// @brief Runs the chunks on ft::parallel::default_pool(). An element that
+/// throws reaches the caller as std::runtime_error.
+///
+template <typename T, std::size_t ThresholdBytes>
+struct allocator_first_touch<first_touch_allocator<T, ThresholdBytes> > {
+  static const std::size_t threshold = ThresholdBytes ? ThresholdBytes : 1;
+  static std::size_t workers() { return ft::parallel::thread_count(); }
+  template <typename Body> static void run(std::size_t chunks, Body &body) {
+    ft::parallel::default_pool().run(chunks, body);
+  }
+};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,505 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GapVector.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GAPVECTOR_HPP
+#define GAPVECTOR_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+///
+/// @brief Random access iterator over a gap_vector, it walks the logical
+/// positions 0..size() and steps over the gap.
+///
+/// @tparam Buffer gap_vector or const gap_vector
+/// @tparam T value_type, const qualified for the const_iterator
+///
+template <typename Buffer, typename T> struct GapVector_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef ft::random_access_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef GapVector_iterator<Buffer, T> Self;
+
+  GapVector_iterator() : buf(), index() {}
+  GapVector_iterator(Buffer *b, std::size_t i) : buf(b), index(i) {}
+  /// Enable conversion to const_iterator.
+  operator GapVector_iterator<const Buffer, const T>() const {
+    return GapVector_iterator<const Buffer, const T>(buf, index);
+  }
+
+  reference operator*() const { return (*buf)[index]; }
+  pointer operator->() const { return &(*buf)[index]; }
+  reference operator[](difference_type n) const { return (*buf)[index + n]; }
+
+  Self &operator++() {
+    ++index;
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    ++index;
+    return tmp;
+  }
+  Self &operator--() {
+    --index;
+    return *this;
+  }
+  Self operator--(int) {
+    Self tmp = *this;
+    --index;
+    return tmp;
+  }
+  Self &operator+=(difference_type n) {
+    index += n;
+    return *this;
+  }
+  Self &operator-=(difference_type n) {
+    index -= n;
+    return *this;
+  }
+  Self operator+(difference_type n) const { return Self(buf, index + n); }
+  Self operator-(difference_type n) const { return Self(buf, index - n); }
+  friend Self operator+(difference_type n, const Self &it) { return it + n; }
+  friend difference_type operator-(const Self &lhs, const Self &rhs) {
+    return difference_type(lhs.index) - difference_type(rhs.index);
+  }
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.index == rhs.index;
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.index != rhs.index;
+  }
+  friend bool operator<(const Self &lhs, const Self &rhs) {
+    return lhs.index < rhs.index;
+  }
+  friend bool operator>(const Self &lhs, const Self &rhs) { return rhs < lhs; }
+  friend bool operator<=(const Self &lhs, const Self &rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const Self &lhs, const Self &rhs) {
+    return !(lhs < rhs);
+  }
+
+  Buffer *buf;
+  std::size_t index;
+};
+
+///
+/// @brief Sequence with a movable gap at the last edit position.
+///
+///    The storage comes from vectorBase, its finish pointer is left at
+///    start: the elements are [start, gapBegin) then [gapEnd, capacity()).
+///    An insert or erase first moves the gap to its position, which costs
+///    the distance from the previous edit, so edits at a moving cursor are
+///    O(1) amortized instead of shifting the whole tail.
+///
+///    Gap moves use memmove for trivially copyable types, otherwise each
+///    element is copied across the gap and destroyed.
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <class T, class Allocator = std::allocator<T> >
+class gap_vector : protected vectorBase<T, Allocator> {
+
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::difference_type difference_type;
+  typedef GapVector_iterator<gap_vector, T> iterator;
+  typedef GapVector_iterator<const gap_vector, const T> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  /// Contiguous run of elements: pointer and length.
+  typedef ft::pair<pointer, size_type> array_range;
+  typedef ft::pair<const_pointer, size_type> const_array_range;
+  typedef vectorBase<T, Allocator> Base;
+
+  using Base::get_allocator;
+  using Base::max_size;
+
+  /// ---------- Ctors & operators
+
+  explicit gap_vector(const allocator_type &alloc = allocator_type())
+      : Base(alloc), gapBegin(0), gapEnd(0) {}
+
+  explicit gap_vector(size_type n, const value_type &val = value_type(),
+                      const allocator_type &alloc = allocator_type())
+      : Base(checkLength(n, alloc), alloc), gapBegin(0), gapEnd(n) {
+    try {
+      for (; gapBegin < n; ++gapBegin)
+        Base::construct(Base::start, val, gapBegin);
+    } catch (...) {
+      clear();
+      __throw_exception_again;
+    }
+  }
+
+  template <class InputIt>
+  gap_vector(InputIt first, InputIt last,
+             const allocator_type &alloc = allocator_type(),
+             typename ft::enable_if<!ft::is_integral<InputIt>::value>::type * = 0)
+      : Base(alloc), gapBegin(0), gapEnd(0) {
+    try {
+      insert(end(), first, last);
+    } catch (...) {
+      clear();
+      __throw_exception_again;
+    }
+  }
+
+  gap_vector(const gap_vector &other)
+      : Base(other.size(), other.get_allocator()), gapBegin(0),
+        gapEnd(other.size()) {
+    try {
+      for (; gapBegin < gapEnd; ++gapBegin)
+        Base::construct(Base::start, other[gapBegin], gapBegin);
+    } catch (...) {
+      clear();
+      __throw_exception_again;
+    }
+  }
+
+  ~gap_vector() { clear(); }
+
+  gap_vector &operator=(const gap_vector &other) {
+    if (&other != this) {
+      gap_vector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// ---------- Iterators
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator end() const { return const_iterator(this, size()); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+  size_type size() const { return capacity() - (gapEnd - gapBegin); }
+  size_type capacity() const { return Base::capacity(); }
+  bool empty() const { return size() == 0; }
+  ///
+  /// @brief Logical position of the gap, where the next edit is cheapest.
+  ///
+  size_type gap_position() const { return gapBegin; }
+
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("gap_vector::reserve");
+    if (n > capacity())
+      reallocate(n);
+  }
+
+  /// ---------- Element access
+
+  reference operator[](size_type n) { return Base::start[slot(n)]; }
+  const_reference operator[](size_type n) const {
+    return Base::start[slot(n)];
+  }
+  reference at(size_type n) {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  reference front() {
+    requireNonEmpty();
+    return (*this)[0];
+  }
+  const_reference front() const {
+    requireNonEmpty();
+    return (*this)[0];
+  }
+  reference back() {
+    requireNonEmpty();
+    return (*this)[size() - 1];
+  }
+  const_reference back() const {
+    requireNonEmpty();
+    return (*this)[size() - 1];
+  }
+
+  ///
+  /// @brief The elements as two contiguous runs: array_one() before the
+  /// gap, array_two() after it. Copying both in order gives the whole
+  /// content.
+  ///
+  /// @return array_range
+  ///
+  array_range array_one() { return array_range(Base::start, gapBegin); }
+  const_array_range array_one() const {
+    return const_array_range(Base::start, gapBegin);
+  }
+  array_range array_two() {
+    return array_range(Base::start + gapEnd, capacity() - gapEnd);
+  }
+  const_array_range array_two() const {
+    return const_array_range(Base::start + gapEnd, capacity() - gapEnd);
+  }
+
+  /// ---------- Modifiers
+
+  void push_back(const value_type &val) { insert(end(), val); }
+  void pop_back() {
+    requireNonEmpty();
+    erase(end() - 1);
+  }
+
+  ///
+  /// @brief Insert val before position, O(1) plus the distance the gap
+  /// moves.
+  ///
+  /// @return iterator to the new element
+  ///
+  iterator insert(iterator position, const value_type &val) {
+    const size_type index = position.index;
+    // val may live in this vector, moving the gap can shift or destroy it.
+    value_type tmp(val);
+    if (gapBegin == gapEnd)
+      grow(1);
+    moveGap(index);
+    Base::construct(Base::start, tmp, gapBegin);
+    ++gapBegin;
+    return iterator(this, index);
+  }
+  void insert(iterator position, size_type n, const value_type &val) {
+    const size_type index = position.index;
+    value_type tmp(val);
+    if (gapEnd - gapBegin < n)
+      grow(n);
+    moveGap(index);
+    for (; n > 0; --n, ++gapBegin)
+      Base::construct(Base::start, tmp, gapBegin);
+  }
+  ///
+  /// @brief Insert [first, last) before position, each element lands at
+  /// the gap so the gap moves once.
+  ///
+  template <class InputIt>
+  typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
+  insert(iterator position, InputIt first, InputIt last) {
+    moveGap(position.index);
+    for (; first != last; ++first) {
+      if (gapBegin == gapEnd) {
+        value_type tmp(*first);
+        grow(1);
+        Base::construct(Base::start, tmp, gapBegin);
+      } else
+        Base::construct(Base::start, *first, gapBegin);
+      ++gapBegin;
+    }
+  }
+
+  ///
+  /// @brief Erase the element at position, the gap moves next to it.
+  ///
+  /// @return iterator to the element that followed it
+  ///
+  iterator erase(iterator position) { return erase(position, position + 1); }
+  iterator erase(iterator first, iterator last) {
+    const size_type index = first.index;
+    moveGap(last.index);
+    for (; gapBegin > index; --gapBegin)
+      Base::destroy(Base::start, gapBegin - 1);
+    return iterator(this, index);
+  }
+
+  void clear() {
+    for (size_type i = 0; i < gapBegin; ++i)
+      Base::destroy(Base::start, i);
+    for (size_type i = gapEnd; i < capacity(); ++i)
+      Base::destroy(Base::start, i);
+    gapBegin = 0;
+    gapEnd = capacity();
+  }
+
+  void swap(gap_vector &other) {
+    this->swapData(other);
+    ft::swap(gapBegin, other.gapBegin);
+    ft::swap(gapEnd, other.gapEnd);
+  }
+
+protected:
+  /// Elements are relocated with memmove when copying them is a memcpy
+  typedef ft::integral_constant<bool, __has_trivial_copy(T) &&
+                                          __has_trivial_destructor(T)>
+      trivial_type;
+
+  static size_type checkLength(size_type n, const allocator_type &alloc) {
+    if (n > alloc.max_size())
+      throw std::length_error("gap_vector::gap_vector");
+    return n;
+  }
+
+  /// Storage index of the logical position n.
+  size_type slot(size_type n) const {
+    return n < gapBegin ? n : n + (gapEnd - gapBegin);
+  }
+
+  ///
+  /// @brief Moves the gap so it starts at logical position index.
+  ///
+  void moveGap(size_type index) { moveGap(index, trivial_type()); }
+  void moveGap(size_type index, ft::true_type) {
+    pointer p = Base::start;
+    if (index < gapBegin) {
+      const size_type n = gapBegin - index;
+      std::memmove(static_cast<void *>(p + gapEnd - n),
+                   static_cast<const void *>(p + index), n * sizeof(T));
+      gapBegin -= n;
+      gapEnd -= n;
+    } else if (index > gapBegin) {
+      const size_type n = index - gapBegin;
+      std::memmove(static_cast<void *>(p + gapBegin),
+                   static_cast<const void *>(p + gapEnd), n * sizeof(T));
+      gapBegin += n;
+      gapEnd += n;
+    }
+  }
+  /// One element at a time, so a throwing copy leaves a valid gap.
+  void moveGap(size_type index, ft::false_type) {
+    while (gapBegin > index) {
+      Base::construct(Base::start, Base::start[gapBegin - 1], gapEnd - 1);
+      Base::destroy(Base::start, gapBegin - 1);
+      --gapBegin;
+      --gapEnd;
+    }
+    while (gapBegin < index) {
+      Base::construct(Base::start, Base::start[gapEnd], gapBegin);
+      Base::destroy(Base::start, gapEnd);
+      ++gapBegin;
+      ++gapEnd;
+    }
+  }
+
+  ///
+  /// @brief Makes the gap hold at least n elements, with the vector growth
+  /// policy.
+  ///
+  void grow(size_type n) {
+    reallocate(Base::growLength(size(), n, max_size(), "gap_vector::insert"));
+  }
+
+  ///
+  /// @brief Moves the elements to storage of len elements, keeping the gap
+  /// at the same logical position.
+  ///
+  void reallocate(size_type len) {
+    const size_type tail = capacity() - gapEnd;
+    pointer newStart = Base::allocate(len);
+    try {
+      relocate(newStart, Base::start, gapBegin, trivial_type());
+      try {
+        relocate(newStart + len - tail, Base::start + gapEnd, tail,
+                 trivial_type());
+      } catch (...) {
+        destroyRun(newStart, gapBegin, trivial_type());
+        __throw_exception_again;
+      }
+    } catch (...) {
+      Base::deallocate(newStart, len);
+      __throw_exception_again;
+    }
+    destroyRun(Base::start, gapBegin, trivial_type());
+    destroyRun(Base::start + gapEnd, tail, trivial_type());
+    Base::deallocate(Base::start, capacity());
+    Base::start = Base::finish = newStart;
+    Base::endOfStorage = newStart + len;
+    gapEnd = len - tail;
+  }
+
+  void relocate(pointer dst, pointer src, size_type n, ft::true_type) {
+    if (n)
+      std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                  n * sizeof(T));
+  }
+  void relocate(pointer dst, pointer src, size_type n, ft::false_type) {
+    size_type i = 0;
+    try {
+      for (; i < n; ++i)
+        Base::construct(dst, src[i], i);
+    } catch (...) {
+      destroyRun(dst, i, ft::false_type());
+      __throw_exception_again;
+    }
+  }
+
+  void destroyRun(pointer p, size_type n, ft::true_type) {
+    (void)p;
+    (void)n;
+  }
+  void destroyRun(pointer p, size_type n, ft::false_type) {
+    for (size_type i = 0; i < n; ++i)
+      Base::destroy(p, i);
+  }
+
+  void rangeCheck(size_type n) const {
+    if (n >= size())
+      throw std::out_of_range("gap_vector::rangeCheck");
+  }
+
+  void requireNonEmpty() const {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+  }
+
+  size_type gapBegin;
+  size_type gapEnd;
+};
+
+template <class T, class Alloc>
+inline bool operator==(const gap_vector<T, Alloc> &lhs,
+                       const gap_vector<T, Alloc> &rhs) {
+  return lhs.size() == rhs.size() &&
+         ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <class T, class Alloc>
+inline bool operator!=(const gap_vector<T, Alloc> &lhs,
+                       const gap_vector<T, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+inline void swap(gap_vector<T, Alloc> &x, gap_vector<T, Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
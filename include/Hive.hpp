@@ -0,0 +1,784 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Hive.hpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HIVE_HPP
+#define HIVE_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+///
+/// @brief A hive (a.k.a. colony / bucket array) is an unordered container
+/// that never moves its elements once they are inserted.
+///
+///    Its properties:
+///    1. Elements live in blocks that are allocated once and never grown, so
+///    pointers and iterators stay valid until the element itself is erased.
+///    2. Erasing an element only marks its slot in the block's skipfield, so
+///    erase is O(1) and never shifts other elements.
+///    3. Erased slots are kept in a free list per block and are reused by the
+///    next insertions before any new slot is taken.
+///    4. Iteration jumps over runs of erased slots in one step, thanks to the
+///    jump-counting skipfield.
+///
+
+namespace ft {
+
+///
+/// @brief A hive block: a fixed array of element slots plus its skipfield.
+///
+/// The element storage is provided by vectorBase. The base is kept "empty"
+/// (finish == start) so its destructor only frees the storage: the block
+/// itself knows which slots are alive and destroys those.
+///
+/// skipfield layout (jump-counting): a live slot holds 0, and the first and
+/// last slot of a run of erased slots both hold the length of that run.
+/// Every run is also linked in a doubly linked free list by its first slot.
+///
+template <typename T, typename Allocator>
+struct HiveBlock : public vectorBase<T, Allocator> {
+  typedef vectorBase<T, Allocator> Base;
+  typedef typename Allocator::pointer pointer;
+  typedef typename Allocator::size_type size_type;
+  typedef unsigned short skipfield_type;
+  typedef typename Allocator::template rebind<skipfield_type>::other
+      skipfield_allocator_type;
+
+  /// Largest block size whose run lengths and indexes fit a skipfield_type.
+  static size_type max_block_capacity() { return 32768; }
+  static skipfield_type none() { return skipfield_type(-1); }
+
+  HiveBlock(size_type cap, const Allocator &a)
+      : Base(cap, a), next(NULL), prev(NULL), nextErased(NULL),
+        prevErased(NULL), skipAlloc(a), skip(), nextFree(), prevFree(),
+        freeHead(none()), highWater(0), count(0) {
+    // skip[cap] stays 0 so an iterator sitting at highWater never jumps.
+    skip = skipAlloc.allocate(3 * cap + 1);
+    nextFree = skip + cap + 1;
+    prevFree = nextFree + cap;
+    std::fill(skip, skip + cap + 1, skipfield_type(0));
+  }
+
+  ~HiveBlock() {
+    destroyLive();
+    skipAlloc.deallocate(skip, 3 * Base::capacity() + 1);
+  }
+
+  pointer slot(size_type i) const { return Base::start + i; }
+  bool hasFree() const { return freeHead != none(); }
+
+  ///
+  /// @brief Index of the first live slot (highWater if there is none).
+  ///
+  size_type first() const { return skip[0]; }
+
+  ///
+  /// @brief Construct a value in the first reusable slot, or after the
+  /// highest slot ever used.
+  ///
+  /// @param val
+  /// @return size_type index of the new element
+  ///
+  size_type insert(const T &val) {
+    if (!hasFree()) {
+      Base::construct(Base::start, val, highWater);
+      ++count;
+      return highWater++;
+    }
+    const size_type s = freeHead;
+    Base::construct(Base::start, val, s);
+    const size_type len = skip[s];
+    if (len == 1)
+      unlinkRun(s);
+    else {
+      // The run now starts one slot further.
+      skip[s + 1] = skip[s + len - 1] = skipfield_type(len - 1);
+      moveRun(s, s + 1);
+    }
+    skip[s] = 0;
+    ++count;
+    return s;
+  }
+
+  ///
+  /// @brief Destroy the element at index i and merge its slot with the
+  /// neighbouring runs of erased slots.
+  ///
+  /// @param i
+  ///
+  void erase(size_type i) {
+    Base::destroy(Base::start, i);
+    const size_type left = (i > 0) ? skip[i - 1] : 0;
+    const size_type right = (i + 1 < highWater) ? skip[i + 1] : 0;
+    if (!left && !right) {
+      skip[i] = 1;
+      linkRun(i);
+    } else if (!right) {
+      skip[i - left] = skip[i] = skipfield_type(left + 1);
+    } else if (!left) {
+      skip[i] = skip[i + right] = skipfield_type(right + 1);
+      moveRun(i + 1, i);
+    } else {
+      skip[i - left] = skip[i + right] = skipfield_type(left + right + 1);
+      unlinkRun(i + 1);
+    }
+    --count;
+  }
+
+  ///
+  /// @brief Destroy every live element and make the block brand new.
+  ///
+  void reset() {
+    destroyLive();
+    std::fill(skip, skip + highWater + 1, skipfield_type(0));
+    freeHead = none();
+    highWater = 0;
+    count = 0;
+  }
+
+  HiveBlock *next;
+  HiveBlock *prev;
+  HiveBlock *nextErased; // Blocks that have reusable slots.
+  HiveBlock *prevErased;
+  skipfield_allocator_type skipAlloc;
+  skipfield_type *skip;
+  skipfield_type *nextFree;
+  skipfield_type *prevFree;
+  skipfield_type freeHead;
+  size_type highWater; // Slots [0, highWater) have been used at least once.
+  size_type count;
+
+private:
+  HiveBlock(const HiveBlock &);
+  HiveBlock &operator=(const HiveBlock &);
+
+  void destroyLive() {
+    size_type i = skip[0];
+    while (i < highWater) {
+      Base::destroy(Base::start, i);
+      ++i;
+      i += skip[i];
+    }
+  }
+
+  void linkRun(size_type s) {
+    nextFree[s] = freeHead;
+    prevFree[s] = none();
+    if (freeHead != none())
+      prevFree[freeHead] = skipfield_type(s);
+    freeHead = skipfield_type(s);
+  }
+
+  void unlinkRun(size_type s) {
+    if (prevFree[s] != none())
+      nextFree[prevFree[s]] = nextFree[s];
+    else
+      freeHead = nextFree[s];
+    if (nextFree[s] != none())
+      prevFree[nextFree[s]] = prevFree[s];
+  }
+
+  void moveRun(size_type from, size_type to) {
+    nextFree[to] = nextFree[from];
+    prevFree[to] = prevFree[from];
+    if (prevFree[to] != none())
+      nextFree[prevFree[to]] = skipfield_type(to);
+    else
+      freeHead = skipfield_type(to);
+    if (nextFree[to] != none())
+      prevFree[nextFree[to]] = skipfield_type(to);
+  }
+};
+
+template <typename T, typename Allocator> struct Hive_const_iterator;
+
+///
+/// @brief Bidirectional iterator over the live slots of a hive.
+///
+/// Stepping is ++index followed by one jump over the run of erased slots
+/// (if any), and a hop to the next block when the block is exhausted.
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <typename T, typename Allocator> struct Hive_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef Hive_iterator<T, Allocator> Hive_it;
+  typedef HiveBlock<T, Allocator> *block_ptr;
+  typedef typename HiveBlock<T, Allocator>::size_type size_type;
+
+  Hive_iterator() : block(), index() {}
+  Hive_iterator(block_ptr b, size_type i) : block(b), index(i) {}
+  reference operator*() const { return *block->slot(index); }
+  pointer operator->() const { return block->slot(index); }
+  Hive_it &operator++() {
+    increment(block, index);
+    return *this;
+  }
+  Hive_it operator++(int) {
+    Hive_it tmp = *this;
+    increment(block, index);
+    return tmp;
+  }
+  Hive_it &operator--() {
+    decrement(block, index);
+    return *this;
+  }
+  Hive_it operator--(int) {
+    Hive_it tmp = *this;
+    decrement(block, index);
+    return tmp;
+  }
+  bool operator==(const Hive_it &x) const {
+    return block == x.block && index == x.index;
+  }
+  bool operator!=(const Hive_it &x) const { return !(*this == x); }
+
+  static void increment(block_ptr &b, size_type &i) {
+    ++i;
+    i += b->skip[i];
+    if (i == b->highWater && b->next) {
+      b = b->next;
+      i = b->first();
+    }
+  }
+
+  static void decrement(block_ptr &b, size_type &i) {
+    if (i != 0) {
+      const size_type j = i - 1;
+      if (j >= b->skip[j]) {
+        i = j - b->skip[j];
+        return;
+      }
+    }
+    b = b->prev;
+    i = b->highWater - 1;
+    i -= b->skip[i];
+  }
+
+  block_ptr block;
+  size_type index;
+};
+
+template <typename T, typename Allocator> struct Hive_const_iterator {
+  typedef T value_type;
+  typedef const T &reference;
+  typedef const T *pointer;
+  typedef Hive_iterator<T, Allocator> iterator;
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef Hive_const_iterator<T, Allocator> Hive_It;
+  typedef HiveBlock<T, Allocator> *block_ptr;
+  typedef typename HiveBlock<T, Allocator>::size_type size_type;
+
+  Hive_const_iterator() : block(), index() {}
+  Hive_const_iterator(block_ptr b, size_type i) : block(b), index(i) {}
+  Hive_const_iterator(const iterator &it) : block(it.block), index(it.index) {}
+  iterator iterator_const_cast() const { return iterator(block, index); }
+  reference operator*() const { return *block->slot(index); }
+  pointer operator->() const { return block->slot(index); }
+  Hive_It &operator++() {
+    iterator::increment(block, index);
+    return *this;
+  }
+  Hive_It operator++(int) {
+    Hive_It tmp = *this;
+    iterator::increment(block, index);
+    return tmp;
+  }
+  Hive_It &operator--() {
+    iterator::decrement(block, index);
+    return *this;
+  }
+  Hive_It operator--(int) {
+    Hive_It tmp = *this;
+    iterator::decrement(block, index);
+    return tmp;
+  }
+  bool operator==(const Hive_It &x) const {
+    return block == x.block && index == x.index;
+  }
+  bool operator!=(const Hive_It &x) const { return !(*this == x); }
+
+  block_ptr block;
+  size_type index;
+};
+
+template <typename T, typename Allocator>
+inline bool operator==(const Hive_iterator<T, Allocator> &x,
+                       const Hive_const_iterator<T, Allocator> &y) {
+  return x.block == y.block && x.index == y.index;
+}
+template <typename T, typename Allocator>
+inline bool operator!=(const Hive_iterator<T, Allocator> &x,
+                       const Hive_const_iterator<T, Allocator> &y) {
+  return !(x == y);
+}
+
+///
+/// @brief Hive class
+///
+/// @tparam T
+/// @tparam Allocator
+///
+template <typename T, typename Allocator = std::allocator<T> > class hive {
+public:
+  typedef T value_type;
+  typedef Allocator allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::difference_type difference_type;
+  typedef Hive_iterator<T, Allocator> iterator;
+  typedef Hive_const_iterator<T, Allocator> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+protected:
+  typedef HiveBlock<T, Allocator> block;
+  typedef block *block_ptr;
+  typedef typename Allocator::template rebind<block>::other
+      block_allocator_type;
+
+public:
+  /// ---------- Ctors & operators
+
+  ///
+  /// @brief Construct a new hive object -> Default
+  ///
+  /// @param alloc
+  ///
+  explicit hive(const allocator_type &alloc = allocator_type())
+      : alloc(alloc), head(), tail(), erased(), spare(), nodeCount(0),
+        totalCapacity(0) {}
+
+  ///
+  /// @brief Construct a new hive object -> Fill constructor
+  ///
+  /// @param n
+  /// @param val
+  /// @param alloc
+  ///
+  explicit hive(size_type n, const value_type &val = value_type(),
+                const allocator_type &alloc = allocator_type())
+      : alloc(alloc), head(), tail(), erased(), spare(), nodeCount(0),
+        totalCapacity(0) {
+    reserve(n);
+    while (n--)
+      insert(val);
+  }
+
+  ///
+  /// @brief Construct a new hive object through a range constructor
+  ///
+  /// @tparam InputIt
+  /// @param first
+  /// @param last
+  /// @param alloc
+  ///
+  template <typename InputIt>
+  hive(InputIt first, InputIt last,
+       const allocator_type &alloc = allocator_type(),
+       typename ft::enable_if<!ft::is_integral<InputIt>::value>::type * = 0)
+      : alloc(alloc), head(), tail(), erased(), spare(), nodeCount(0),
+        totalCapacity(0) {
+    insert(first, last);
+  }
+
+  ///
+  /// @brief Copy constructor, the copy is compacted: it has no erased slots.
+  ///
+  /// @param other
+  ///
+  hive(const hive &other)
+      : alloc(other.alloc), head(), tail(), erased(), spare(), nodeCount(0),
+        totalCapacity(0) {
+    reserve(other.size());
+    insert(other.begin(), other.end());
+  }
+
+  ///
+  /// @brief Destroy the hive object, frees every block (spare ones included).
+  ///
+  ~hive() {
+    freeBlocks(head);
+    freeBlocks(spare);
+  }
+
+  ///
+  /// @brief Copy Assignment operator
+  ///
+  /// @param other
+  /// @return hive&
+  ///
+  hive &operator=(const hive &other) {
+    if (&other != this) {
+      clear();
+      reserve(other.size());
+      insert(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return alloc; }
+
+  /// ---------- Iterators
+  iterator begin() { return head ? iterator(head, head->first()) : end(); }
+  const_iterator begin() const {
+    return head ? const_iterator(head, head->first()) : end();
+  }
+  iterator end() { return iterator(tail, tail ? tail->highWater : 0); }
+  const_iterator end() const {
+    return const_iterator(tail, tail ? tail->highWater : 0);
+  }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+
+  bool empty() const { return nodeCount == 0; }
+  size_type size() const { return nodeCount; }
+  size_type max_size() const { return alloc.max_size(); }
+
+  ///
+  /// @brief Number of slots owned by the hive, spare blocks included.
+  ///
+  /// @return size_type
+  ///
+  size_type capacity() const { return totalCapacity; }
+
+  ///
+  /// @brief Make sure at least n elements fit without allocating, the extra
+  /// blocks are kept aside until they are needed.
+  ///
+  /// @param n
+  ///
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("hive::reserve");
+    while (totalCapacity < n) {
+      size_type cap = n - totalCapacity;
+      if (cap > block::max_block_capacity())
+        cap = block::max_block_capacity();
+      if (cap < minBlockCapacity())
+        cap = minBlockCapacity();
+      block_ptr b = createBlock(cap);
+      b->next = spare;
+      spare = b;
+    }
+  }
+
+  ///
+  /// @brief Free the spare blocks (the ones without any element).
+  ///
+  void shrink_to_fit() {
+    freeBlocks(spare);
+    spare = NULL;
+  }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Insert a copy of val. Erased slots are reused first, then the
+  /// last block is filled, then a new block is taken.
+  ///
+  /// @param val
+  /// @return iterator to the new element
+  ///
+  iterator insert(const value_type &val) {
+    block_ptr b = erased;
+    if (!b) {
+      if (!tail || tail->highWater == tail->capacity())
+        appendBlock();
+      b = tail;
+    }
+    const size_type i = b->insert(val);
+    if (b == erased && !b->hasFree())
+      unlinkErased(b);
+    ++nodeCount;
+    return iterator(b, i);
+  }
+
+  ///
+  /// @brief Insert n copies of val.
+  ///
+  /// @param n
+  /// @param val
+  ///
+  void insert(size_type n, const value_type &val) {
+    reserve(size() + n);
+    while (n--)
+      insert(val);
+  }
+
+  ///
+  /// @brief Insert the given range.
+  ///
+  /// @tparam InputIt
+  /// @param first
+  /// @param last
+  ///
+  template <typename InputIt>
+  typename ft::enable_if<!ft::is_integral<InputIt>::value>::type
+  insert(InputIt first, InputIt last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  ///
+  /// @brief Erase the element at the given position, no other element moves.
+  ///
+  /// @param position
+  /// @return iterator to the next element
+  ///
+  iterator erase(const_iterator position) {
+    block_ptr b = position.block;
+    iterator next = position.iterator_const_cast();
+    ++next;
+    const bool hadFree = b->hasFree();
+    b->erase(position.index);
+    --nodeCount;
+    if (b->count == 0) {
+      if (hadFree)
+        unlinkErased(b);
+      const bool wasTail = (b == tail);
+      retireBlock(b);
+      return wasTail ? end() : next;
+    }
+    if (!hadFree)
+      linkErased(b);
+    return next;
+  }
+
+  ///
+  /// @brief Erase the given range.
+  ///
+  /// @param first
+  /// @param last
+  /// @return iterator
+  ///
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    // end() moves when the tail block is retired, so it is re-read each time.
+    const bool toEnd = (last == end());
+    while (toEnd ? first != end() : first != last)
+      first = erase(first);
+    return toEnd ? end() : last.iterator_const_cast();
+  }
+
+  ///
+  /// @brief Empty the hive, the blocks are kept as spare capacity.
+  ///
+  void clear() {
+    while (head)
+      retireBlock(head);
+    erased = NULL;
+    nodeCount = 0;
+  }
+
+  ///
+  /// @brief Swap the data with the one of another hive.
+  ///
+  /// @param other
+  ///
+  void swap(hive &other) {
+    ft::swap(head, other.head);
+    ft::swap(tail, other.tail);
+    ft::swap(erased, other.erased);
+    ft::swap(spare, other.spare);
+    ft::swap(nodeCount, other.nodeCount);
+    ft::swap(totalCapacity, other.totalCapacity);
+    ft::swap(alloc, other.alloc);
+  }
+
+  /// ---------- Operations
+
+  ///
+  /// @brief Get the iterator of an element from its address.
+  /// Linear in the number of blocks.
+  ///
+  /// @param p
+  /// @return iterator, or end() if p is not in the hive.
+  ///
+  iterator get_iterator(const_pointer p) {
+    for (block_ptr b = head; b; b = b->next) {
+      if (p >= b->slot(0) && p < b->slot(b->highWater))
+        return iterator(b, p - b->slot(0));
+    }
+    return end();
+  }
+  const_iterator get_iterator(const_pointer p) const {
+    return const_cast<hive *>(this)->get_iterator(p);
+  }
+
+protected:
+  static size_type minBlockCapacity() { return 8; }
+
+  ///
+  /// @brief Allocate and construct an empty block.
+  ///
+  /// @param cap
+  /// @return block_ptr
+  ///
+  block_ptr createBlock(size_type cap) {
+    block_allocator_type blockAlloc(alloc);
+    block_ptr b = blockAlloc.allocate(1);
+    try {
+      ::new (static_cast<void *>(b)) block(cap, alloc);
+    } catch (...) {
+      blockAlloc.deallocate(b, 1);
+      __throw_exception_again;
+    }
+    totalCapacity += cap;
+    return b;
+  }
+
+  ///
+  /// @brief Destroy and deallocate a list of blocks chained by next.
+  ///
+  /// @param b
+  ///
+  void freeBlocks(block_ptr b) {
+    block_allocator_type blockAlloc(alloc);
+    while (b) {
+      block_ptr next = b->next;
+      totalCapacity -= b->capacity();
+      b->~block();
+      blockAlloc.deallocate(b, 1);
+      b = next;
+    }
+  }
+
+  ///
+  /// @brief Add a block after the tail, a spare one if there is one, else a
+  /// new one as big as the whole hive so far (the capacity doubles).
+  ///
+  void appendBlock() {
+    block_ptr b = spare;
+    if (b)
+      spare = b->next;
+    else {
+      size_type cap = totalCapacity;
+      if (cap < minBlockCapacity())
+        cap = minBlockCapacity();
+      if (cap > block::max_block_capacity())
+        cap = block::max_block_capacity();
+      b = createBlock(cap);
+    }
+    b->next = NULL;
+    b->prev = tail;
+    if (tail)
+      tail->next = b;
+    else
+      head = b;
+    tail = b;
+  }
+
+  ///
+  /// @brief Unlink a block from the hive and keep it as spare capacity.
+  ///
+  /// @param b
+  ///
+  void retireBlock(block_ptr b) {
+    if (b->prev)
+      b->prev->next = b->next;
+    else
+      head = b->next;
+    if (b->next)
+      b->next->prev = b->prev;
+    else
+      tail = b->prev;
+    b->reset();
+    b->prev = NULL;
+    b->nextErased = b->prevErased = NULL;
+    b->next = spare;
+    spare = b;
+  }
+
+  void linkErased(block_ptr b) {
+    b->prevErased = NULL;
+    b->nextErased = erased;
+    if (erased)
+      erased->prevErased = b;
+    erased = b;
+  }
+
+  void unlinkErased(block_ptr b) {
+    if (b->prevErased)
+      b->prevErased->nextErased = b->nextErased;
+    else
+      erased = b->nextErased;
+    if (b->nextErased)
+      b->nextErased->prevErased = b->prevErased;
+    b->nextErased = b->prevErased = NULL;
+  }
+
+  allocator_type alloc;
+  block_ptr head;
+  block_ptr tail;
+  block_ptr erased; // Blocks with reusable slots.
+  block_ptr spare;  // Blocks without any element, chained by next.
+  size_type nodeCount;
+  size_type totalCapacity;
+};
+
+///
+/// @brief Static swap function for two hives.
+///
+/// @tparam T
+/// @tparam Alloc
+/// @param x
+/// @param y
+///
+template <class T, class Alloc> void swap(hive<T, Alloc> &x, hive<T, Alloc> &y) {
+  x.swap(y);
+}
+
+///
+/// @brief Hives are equal when they hold the same elements in the same
+/// iteration order.
+///
+template <class T, class Alloc>
+bool operator==(const hive<T, Alloc> &lhs, const hive<T, Alloc> &rhs) {
+  return lhs.size() == rhs.size() &&
+         ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator!=(const hive<T, Alloc> &lhs, const hive<T, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,401 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   IntervalMap.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:10:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 18:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INTERVALMAP_HPP
+#define INTERVALMAP_HPP
+
+#include "AggregateRedBlackTree.hpp"
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ft {
+
+///
+/// @brief Orders the intervals by low endpoint, then by high endpoint.
+///
+/// @tparam Key Endpoint type
+/// @tparam Compare Endpoint ordering
+///
+template <typename Key, typename Compare> struct IntervalMapCompare {
+  typedef ft::pair<Key, Key> interval_type;
+
+  IntervalMapCompare() : comp() {}
+  IntervalMapCompare(const Compare &c) : comp(c) {}
+
+  bool operator()(const interval_type &a, const interval_type &b) const {
+    return comp(a.first, b.first) ||
+           (!comp(b.first, a.first) && comp(a.second, b.second));
+  }
+
+  Compare comp;
+};
+
+///
+/// @brief Monoid keeping the largest high endpoint of a subtree.
+///
+///    The combine is static, so the endpoint ordering is a default
+///    constructed Compare: a comparator carrying state is not supported.
+///
+template <typename Key, typename Compare> struct IntervalMapEnd {
+  struct value_type {
+    Key end;
+    /// False for the identity, an empty subtree.
+    bool some;
+  };
+
+  static value_type identity() {
+    value_type v;
+    v.end = Key();
+    v.some = false;
+    return v;
+  }
+  static value_type combine(const value_type &a, const value_type &b) {
+    if (!a.some)
+      return b;
+    if (!b.some)
+      return a;
+    return Compare()(a.end, b.end) ? b : a;
+  }
+  template <typename Value> static value_type lift(const Value &v) {
+    value_type r;
+    r.end = v.first.second;
+    r.some = true;
+    return r;
+  }
+};
+
+///
+/// @brief Forward iterator over the intervals of an interval_map overlapping
+/// a query interval, in key order.
+///
+/// @tparam Map interval_map
+/// @tparam T value_type, const qualified for the const_overlap_iterator
+///
+template <typename Map, typename T> struct IntervalMap_overlap_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef ft::forward_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef IntervalMap_overlap_iterator<Map, T> Self;
+  typedef typename Map::key_type interval_type;
+  typedef RedBlackTreeNodeBase *base_ptr;
+
+  IntervalMap_overlap_iterator() : map(), node(), query() {}
+  IntervalMap_overlap_iterator(const Map *m, base_ptr x,
+                               const interval_type &q)
+      : map(m), node(x), query(q) {}
+  /// Enable conversion to const_overlap_iterator.
+  operator IntervalMap_overlap_iterator<Map, const T>() const {
+    return IntervalMap_overlap_iterator<Map, const T>(map, node, query);
+  }
+
+  reference operator*() const { return Map::valueOf(node); }
+  pointer operator->() const { return &Map::valueOf(node); }
+  Self &operator++() {
+    node = map->nextOverlap(node, query);
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    node = map->nextOverlap(node, query);
+    return tmp;
+  }
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.node == rhs.node;
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.node != rhs.node;
+  }
+
+  const Map *map;
+  base_ptr node;
+  interval_type query;
+};
+
+///
+/// @brief Map from closed intervals [first, second] to values, answering
+/// which intervals overlap a range or contain a point.
+///
+///    The intervals are ordered by low endpoint on the RedBlackTree of
+///    ft::map, every node also keeps the largest high endpoint of its
+///    subtree through the AggregateRedBlackTreeNode, so rotations and
+///    erasures keep it without extra passes. A query skips each subtree
+///    whose largest high endpoint is below the query, and stops at the
+///    first low endpoint above it: the first overlap costs O(log n), each
+///    following one at most O(log n), so k results take
+///    O(min(n, (k + 1) log n)) instead of the full scan of a map.
+///
+///    Equal intervals are kept in insertion order, like in ft::multimap.
+///    Mapped values may be changed in place, the endpoints may not. Key is
+///    copied into the node aggregates, it must be trivially copyable.
+///
+/// @tparam Key Endpoint type
+/// @tparam T Mapped type
+/// @tparam Compare Endpoint ordering, default constructible and stateless
+/// @tparam Alloc
+///
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc =
+              std::allocator<ft::pair<const ft::pair<Key, Key>, T> > >
+class interval_map {
+public:
+  typedef ft::pair<Key, Key> key_type;
+  typedef Key endpoint_type;
+  typedef T mapped_type;
+  typedef ft::pair<const key_type, T> value_type;
+  typedef Compare endpoint_compare;
+  typedef IntervalMapCompare<Key, Compare> key_compare;
+  typedef Alloc allocator_type;
+
+private:
+  typedef AggregateRedBlackTreeNode<value_type, IntervalMapEnd<Key, Compare> >
+      node_type;
+  typedef RedBlackTree<key_type, value_type, std::_Select1st<value_type>,
+                       key_compare, allocator_type, node_type>
+      tree_type;
+  typedef RedBlackTreeNodeBase *base_ptr;
+
+  template <typename M, typename U> friend struct IntervalMap_overlap_iterator;
+
+  tree_type tree;
+
+public:
+  typedef typename Alloc::pointer pointer;
+  typedef typename Alloc::const_pointer const_pointer;
+  typedef typename Alloc::reference reference;
+  typedef typename Alloc::const_reference const_reference;
+  typedef typename tree_type::iterator iterator;
+  typedef typename tree_type::const_iterator const_iterator;
+  typedef typename tree_type::size_type size_type;
+  typedef typename tree_type::difference_type difference_type;
+  typedef typename tree_type::reverse_iterator reverse_iterator;
+  typedef typename tree_type::const_reverse_iterator const_reverse_iterator;
+  typedef IntervalMap_overlap_iterator<interval_map, value_type>
+      overlap_iterator;
+  typedef IntervalMap_overlap_iterator<interval_map, const value_type>
+      const_overlap_iterator;
+
+  /// ---------- Ctors & operators
+
+  interval_map() : tree() {}
+  explicit interval_map(const Compare &comp,
+                        const allocator_type &a = allocator_type())
+      : tree(key_compare(comp), a) {}
+  template <typename InputIterator>
+  interval_map(InputIterator first, InputIterator last) : tree() {
+    tree.insert_equal(first, last);
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(tree.get_allocator());
+  }
+
+  /// ---------- Iterators
+  iterator begin() { return tree.begin(); }
+  const_iterator begin() const { return tree.begin(); }
+  iterator end() { return tree.end(); }
+  const_iterator end() const { return tree.end(); }
+  reverse_iterator rbegin() { return tree.rbegin(); }
+  const_reverse_iterator rbegin() const { return tree.rbegin(); }
+  reverse_iterator rend() { return tree.rend(); }
+  const_reverse_iterator rend() const { return tree.rend(); }
+
+  /// ---------- Capacity
+  bool empty() const { return tree.empty(); }
+  size_type size() const { return tree.size(); }
+  size_type max_size() const { return tree.max_size(); }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Inserts an interval after the equal ones, O(log n).
+  ///
+  /// @param x Interval, first not greater than second, and its value
+  /// @return iterator to the inserted element
+  ///
+  iterator insert(const value_type &x) { return tree.insert_equal(x); }
+  iterator insert(const Key &lo, const Key &hi, const T &x) {
+    return tree.insert_equal(value_type(key_type(lo, hi), x));
+  }
+  iterator insert(iterator position, const value_type &x) {
+    return tree.insert_equal(position, x);
+  }
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    tree.insert_equal(first, last);
+  }
+
+  void erase(iterator position) { tree.erase(position); }
+  /// Erases every interval equal to k.
+  size_type erase(const key_type &k) { return tree.erase(k); }
+  void erase(iterator first, iterator last) { tree.erase(first, last); }
+  void swap(interval_map &x) { tree.swap(x.tree); }
+  void clear() { tree.clear(); }
+
+  /// ---------- Observers
+  key_compare key_comp() const { return tree.key_comp(); }
+  endpoint_compare endpoint_comp() const { return tree.key_comp().comp; }
+
+  /// ---------- Lookup of whole intervals
+
+  iterator find(const key_type &k) { return tree.find(k); }
+  const_iterator find(const key_type &k) const { return tree.find(k); }
+  size_type count(const key_type &k) const { return tree.count(k); }
+  iterator lower_bound(const key_type &k) { return tree.lower_bound(k); }
+  const_iterator lower_bound(const key_type &k) const {
+    return tree.lower_bound(k);
+  }
+  iterator upper_bound(const key_type &k) { return tree.upper_bound(k); }
+  const_iterator upper_bound(const key_type &k) const {
+    return tree.upper_bound(k);
+  }
+  ft::pair<iterator, iterator> equal_range(const key_type &k) {
+    return tree.equal_range(k);
+  }
+  ft::pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+    return tree.equal_range(k);
+  }
+
+  /// ---------- Overlap queries
+
+  ///
+  /// @brief The intervals sharing at least one point with [lo, hi], in key
+  /// order.
+  ///
+  ///    The range stays valid while the map is not modified, erasing the
+  ///    element of an overlap_iterator invalidates it.
+  ///
+  /// @param lo
+  /// @param hi
+  /// @return pair<overlap_iterator, overlap_iterator> [first, last)
+  ///
+  ft::pair<overlap_iterator, overlap_iterator> overlapping(const Key &lo,
+                                                           const Key &hi) {
+    key_type q(lo, hi);
+    return ft::pair<overlap_iterator, overlap_iterator>(
+        overlap_iterator(this, firstOverlap(root(), q), q),
+        overlap_iterator(this, header(), q));
+  }
+  ft::pair<const_overlap_iterator, const_overlap_iterator>
+  overlapping(const Key &lo, const Key &hi) const {
+    key_type q(lo, hi);
+    return ft::pair<const_overlap_iterator, const_overlap_iterator>(
+        const_overlap_iterator(this, firstOverlap(root(), q), q),
+        const_overlap_iterator(this, header(), q));
+  }
+
+  ///
+  /// @brief The intervals containing point, in key order.
+  ///
+  ft::pair<overlap_iterator, overlap_iterator> stabbing(const Key &point) {
+    return overlapping(point, point);
+  }
+  ft::pair<const_overlap_iterator, const_overlap_iterator>
+  stabbing(const Key &point) const {
+    return overlapping(point, point);
+  }
+
+  /// Whether any interval overlaps [lo, hi], O(log n).
+  bool overlaps(const Key &lo, const Key &hi) const {
+    return firstOverlap(root(), key_type(lo, hi)) != header();
+  }
+
+private:
+  static value_type &valueOf(base_ptr x) {
+    return static_cast<node_type *>(x)->value;
+  }
+  static const key_type &keyOf(base_ptr x) { return valueOf(x).first; }
+
+  base_ptr header() const { return const_cast<base_ptr>(tree.end().node); }
+  base_ptr root() const { return header()->parent(); }
+
+  /// Whether some interval of the subtree x ends at or after lo.
+  bool reaches(base_ptr x, const Key &lo) const {
+    return x != 0 && !tree.key_comp().comp(node_type::subtree(x).end, lo);
+  }
+  bool overlap(base_ptr x, const key_type &q) const {
+    const key_type &k = keyOf(x);
+    return !tree.key_comp().comp(q.second, k.first) &&
+           !tree.key_comp().comp(k.second, q.first);
+  }
+  bool startsAfter(base_ptr x, const key_type &q) const {
+    return tree.key_comp().comp(q.second, keyOf(x).first);
+  }
+
+  ///
+  /// @brief Leftmost interval of the subtree x overlapping q.
+  ///
+  /// @return base_ptr The node, header() if there is none
+  ///
+  base_ptr firstOverlap(base_ptr x, const key_type &q) const {
+    while (reaches(x, q.first)) {
+      // A left subtree reaching lo holds an overlap unless x, and so all of
+      // its right side, starts after hi.
+      if (reaches(x->left, q.first))
+        x = x->left;
+      else if (startsAfter(x, q))
+        break;
+      else if (overlap(x, q))
+        return x;
+      else
+        x = x->right;
+    }
+    return header();
+  }
+
+  ///
+  /// @brief Next interval after x in key order overlapping q.
+  ///
+  base_ptr nextOverlap(base_ptr x, const key_type &q) const {
+    base_ptr h = header();
+    base_ptr y = firstOverlap(x->right, q);
+    if (y != h)
+      return y;
+    for (base_ptr p = x->parent(); p != h; x = p, p = p->parent()) {
+      if (x != p->left)
+        continue;
+      if (startsAfter(p, q))
+        break;
+      if (overlap(p, q))
+        return p;
+      if ((y = firstOverlap(p->right, q)) != h)
+        return y;
+    }
+    return h;
+  }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline bool operator==(const interval_map<Key, T, Compare, Alloc> &lhs,
+                       const interval_map<Key, T, Compare, Alloc> &rhs) {
+  return lhs.size() == rhs.size() &&
+         ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline bool operator!=(const interval_map<Key, T, Compare, Alloc> &lhs,
+                       const interval_map<Key, T, Compare, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline void swap(interval_map<Key, T, Compare, Alloc> &x,
+                 interval_map<Key, T, Compare, Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
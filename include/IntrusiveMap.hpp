@@ -0,0 +1,370 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   IntrusiveMap.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INTRUSIVEMAP_HPP
+#define INTRUSIVEMAP_HPP
+
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <functional>
+
+namespace ft {
+
+/// Tag of the hook of objects linked into a single kind of tree.
+struct intrusive_map_default_tag {};
+
+///
+/// @brief Hook the objects indexed by an intrusive_map derive from. An object
+/// has one hook per tree it can be linked into, told apart by their Tag:
+///
+///    struct Order : ft::intrusive_map_hook<ById>,
+///                   ft::intrusive_map_hook<ByPrice> { ... };
+///
+///    The map goes from a hook to its object with static_cast, so the hook
+///    must be a public, non-virtual base of the object.
+///
+/// @tparam Tag
+///
+template <typename Tag = intrusive_map_default_tag>
+struct intrusive_map_hook : public RedBlackTreeNodeBase {
+  intrusive_map_hook() : RedBlackTreeNodeBase() {}
+  /// Copying an object does not copy its memberships.
+  intrusive_map_hook(const intrusive_map_hook &) : RedBlackTreeNodeBase() {}
+  intrusive_map_hook &operator=(const intrusive_map_hook &) { return *this; }
+
+  bool is_linked() const { return parent() != NULL; }
+};
+
+///
+/// @brief Bidirectional iterator over an intrusive_map, it walks the hooks and
+/// dereferences to the objects holding them.
+///
+/// @tparam Map intrusive_map
+/// @tparam T value_type, const qualified for the const_iterator
+///
+template <typename Map, typename T> struct IntrusiveMap_iterator {
+  typedef T value_type;
+  typedef T &reference;
+  typedef T *pointer;
+  typedef ft::bidirectional_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef IntrusiveMap_iterator<Map, T> Self;
+  typedef RedBlackTreeNodeBase *base_ptr;
+
+  IntrusiveMap_iterator() : node() {}
+  explicit IntrusiveMap_iterator(base_ptr x) : node(x) {}
+  /// Enable conversion to const_iterator.
+  operator IntrusiveMap_iterator<Map, const T>() const {
+    return IntrusiveMap_iterator<Map, const T>(node);
+  }
+
+  reference operator*() const { return *Map::owner(node); }
+  pointer operator->() const { return Map::owner(node); }
+  Self &operator++() {
+    node = RedBlackTreeNodeBase::increment(node);
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    node = RedBlackTreeNodeBase::increment(node);
+    return tmp;
+  }
+  Self &operator--() {
+    node = RedBlackTreeNodeBase::decrement(node);
+    return *this;
+  }
+  Self operator--(int) {
+    Self tmp = *this;
+    node = RedBlackTreeNodeBase::decrement(node);
+    return tmp;
+  }
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.node == rhs.node;
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.node != rhs.node;
+  }
+
+  base_ptr node;
+};
+
+///
+/// @brief Ordered index over objects the user owns, with unique keys.
+///
+///    The tree links the intrusive_map_hook bases of the objects instead
+///    of copying them into nodes: insert and erase never allocate, and an
+///    object with several hooks can sit in several trees at once. Balancing
+///    reuses the RedBlackTreeNodeBase algorithms of ft::map.
+///
+///    The map does not own its elements: an object must be erased (or the
+///    map cleared or destroyed) before the object goes away.
+///
+/// @tparam Key
+/// @tparam T Type of the indexed objects
+/// @tparam Tag Tag of the intrusive_map_hook base of T linking it into this
+/// tree
+/// @tparam KeyOfValue Functor returning a const reference to the key of a T
+/// @tparam Compare
+///
+template <typename Key, typename T, typename Tag, typename KeyOfValue,
+          typename Compare = std::less<Key> >
+class intrusive_map {
+public:
+  typedef intrusive_map_hook<Tag> hook_type;
+  typedef Key key_type;
+  typedef T value_type;
+  typedef Compare key_compare;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef IntrusiveMap_iterator<intrusive_map, T> iterator;
+  typedef IntrusiveMap_iterator<intrusive_map, const T> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  /// ---------- Ctors & operators
+
+  explicit intrusive_map(const Compare &comp = Compare())
+      : keyCompare(comp), nodeCount(0) {
+    reset();
+  }
+
+  /// Unlinks the remaining objects.
+  ~intrusive_map() { clear(); }
+
+  /// ---------- Iterators
+  iterator begin() { return iterator(header.left); }
+  const_iterator begin() const { return const_iterator(header.left); }
+  iterator end() { return iterator(&header); }
+  const_iterator end() const {
+    return const_iterator(const_cast<base_ptr>(&header));
+  }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  ///
+  /// @brief Iterator to an object linked in this tree, O(1).
+  ///
+  iterator iterator_to(T &obj) { return iterator(hook(obj)); }
+  const_iterator iterator_to(const T &obj) const {
+    return const_iterator(hook(const_cast<T &>(obj)));
+  }
+
+  /// ---------- Capacity
+  bool empty() const { return nodeCount == 0; }
+  size_type size() const { return nodeCount; }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Links obj into the tree unless its key is already present.
+  ///
+  /// @param obj Object whose hook is not linked in this tree
+  /// @return pair<iterator, bool> Position of the object with that key and
+  /// whether obj was linked
+  ///
+  ft::pair<iterator, bool> insert(T &obj) {
+    const Key &k = KeyOfValue()(obj);
+    base_ptr x = header.parent();
+    base_ptr y = &header;
+    bool comp = true;
+    while (x != 0) {
+      y = x;
+      comp = keyCompare(k, key(x));
+      x = comp ? x->left : x->right;
+    }
+    iterator j(y);
+    if (comp) {
+      if (j == begin())
+        return ft::pair<iterator, bool>(link(obj, y, true), true);
+      --j;
+    }
+    if (keyCompare(key(j.node), k))
+      return ft::pair<iterator, bool>(link(obj, y, comp), true);
+    return ft::pair<iterator, bool>(j, false);
+  }
+
+  ///
+  /// @brief Unlinks the object at position, the object itself is untouched.
+  ///
+  /// @return iterator following position
+  ///
+  iterator erase(iterator position) {
+    iterator next = position;
+    ++next;
+    unlink(position.node);
+    return next;
+  }
+  void erase(T &obj) { unlink(hook(obj)); }
+  size_type erase(const key_type &k) {
+    iterator it = find(k);
+    if (it == end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+  void erase(iterator first, iterator last) {
+    while (first != last)
+      first = erase(first);
+  }
+
+  ///
+  /// @brief Unlinks every object, without rebalancing.
+  ///
+  void clear() {
+    clearHooks(header.parent());
+    reset();
+  }
+
+  void swap(intrusive_map &other) {
+    ft::swap(keyCompare, other.keyCompare);
+    RedBlackTreeNodeBase tmp = header;
+    size_type count = nodeCount;
+    takeTree(other.header, other.nodeCount);
+    other.takeTree(tmp, count);
+  }
+
+  /// ---------- Lookup
+
+  iterator find(const key_type &k) {
+    iterator j = lower_bound(k);
+    return (j == end() || keyCompare(k, key(j.node))) ? end() : j;
+  }
+  const_iterator find(const key_type &k) const {
+    const_iterator j = lower_bound(k);
+    return (j == end() || keyCompare(k, key(j.node))) ? end() : j;
+  }
+  size_type count(const key_type &k) const { return find(k) != end(); }
+  iterator lower_bound(const key_type &k) {
+    return iterator(lowerBound(k));
+  }
+  const_iterator lower_bound(const key_type &k) const {
+    return const_iterator(lowerBound(k));
+  }
+  iterator upper_bound(const key_type &k) {
+    return iterator(upperBound(k));
+  }
+  const_iterator upper_bound(const key_type &k) const {
+    return const_iterator(upperBound(k));
+  }
+
+  key_compare key_comp() const { return keyCompare; }
+
+  /// ---------- Hook conversions
+
+  ///
+  /// @brief The object holding a hook of this tree.
+  ///
+  static T *owner(RedBlackTreeNodeBase *x) {
+    return static_cast<T *>(static_cast<hook_type *>(x));
+  }
+
+private:
+  typedef RedBlackTreeNodeBase *base_ptr;
+
+  intrusive_map(const intrusive_map &);
+  intrusive_map &operator=(const intrusive_map &);
+
+  /// The hook of obj linking it into this tree.
+  static base_ptr hook(T &obj) { return static_cast<hook_type *>(&obj); }
+
+  static const Key &key(base_ptr x) { return KeyOfValue()(*owner(x)); }
+
+  void reset() {
+    header.parentColor = Red;
+    header.left = &header;
+    header.right = &header;
+    nodeCount = 0;
+  }
+
+  void takeTree(const RedBlackTreeNodeBase &h, size_type count) {
+    if (h.parent() == 0) {
+      reset();
+      return;
+    }
+    header.parentColor = h.parentColor;
+    header.left = h.left;
+    header.right = h.right;
+    header.parent()->set_parent(&header);
+    nodeCount = count;
+  }
+
+  iterator link(T &obj, base_ptr parent, bool insertLeft) {
+    base_ptr x = hook(obj);
+    RedBlackTreeNodeBase::insert_and_rebalance(insertLeft, x, parent, header);
+    ++nodeCount;
+    return iterator(x);
+  }
+
+  void unlink(base_ptr x) {
+    RedBlackTreeNodeBase::rebalance_for_erase(x, header);
+    x->parentColor = 0;
+    x->left = x->right = 0;
+    --nodeCount;
+  }
+
+  static void clearHooks(base_ptr x) {
+    while (x != 0) {
+      clearHooks(x->right);
+      base_ptr y = x->left;
+      x->parentColor = 0;
+      x->left = x->right = 0;
+      x = y;
+    }
+  }
+
+  base_ptr lowerBound(const key_type &k) const {
+    base_ptr x = header.parent();
+    base_ptr y = const_cast<base_ptr>(&header);
+    while (x != 0)
+      if (!keyCompare(key(x), k))
+        y = x, x = x->left;
+      else
+        x = x->right;
+    return y;
+  }
+  base_ptr upperBound(const key_type &k) const {
+    base_ptr x = header.parent();
+    base_ptr y = const_cast<base_ptr>(&header);
+    while (x != 0)
+      if (keyCompare(k, key(x)))
+        y = x, x = x->left;
+      else
+        x = x->right;
+    return y;
+  }
+
+  Compare keyCompare;
+  RedBlackTreeNodeBase header;
+  size_type nodeCount;
+};
+
+template <typename Key, typename T, typename Tag, typename KeyOfValue,
+          typename Compare>
+inline void swap(intrusive_map<Key, T, Tag, KeyOfValue, Compare> &x,
+                 intrusive_map<Key, T, Tag, KeyOfValue, Compare> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/01/13 17:13:16 by bcosters          #+#    #+#             */
-/*   Updated: 2022/08/02 10:19:21 by bcosters         ###   ########.fr       */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,6 +14,7 @@
 #define ITERATORS_HPP
 
 #include "utility.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <iterator>
@@ -374,8 +375,7 @@ public:
     return tmp;
   };
   random_access_iterator<T> &operator+=(difference_type sz) {
-    while (sz--)
-      ++*this;
+    this->_ptr += sz;
     return *this;
   };
   random_access_iterator<T> operator+(difference_type sz) const {
@@ -388,8 +388,7 @@ public:
     return (src + sz);
   };
   random_access_iterator<T> &operator-=(difference_type sz) {
-    while (sz--)
-      --*this;
+    this->_ptr -= sz;
     return *this;
   };
   random_access_iterator<T> operator-(difference_type sz) const {
@@ -562,7 +561,7 @@ template <class Iter>
 typename iterator_traits<Iter>::difference_type _distance(Iter first, Iter last,
                                                           ft::input_iterator_tag) {
   typename iterator_traits<Iter>::difference_type dist = 0;
-  while (first++ != last)
+  for (; first != last; ++first)
     dist++;
   return dist;
 }
@@ -765,6 +764,57 @@ public:
 protected:
   iterator_type baseIt;
 };
+
+///
+/// @brief Output iterator appending to a container, it reserves room for at
+/// least chunk more elements whenever the container is full so the
+/// container grows geometrically and only O(log n) times.
+///
+/// @tparam Container Needs size, capacity, reserve and push_back
+///
+template <class Container> class chunked_back_insert_iterator {
+
+public:
+  // std category so the std algorithms accept it as an output iterator
+  typedef std::output_iterator_tag iterator_category;
+  typedef void value_type;
+  typedef void difference_type;
+  typedef void pointer;
+  typedef void reference;
+  typedef Container container_type;
+  typedef typename Container::size_type size_type;
+
+  chunked_back_insert_iterator(Container &c, size_type chunk)
+      : container(&c), chunk(chunk ? chunk : 1) {}
+
+  chunked_back_insert_iterator &
+  operator=(const typename Container::value_type &value) {
+    const size_type size = container->size();
+    if (size == container->capacity())
+      container->reserve(size + std::max(size, chunk));
+    container->push_back(value);
+    return *this;
+  }
+  chunked_back_insert_iterator &operator*() { return *this; }
+  chunked_back_insert_iterator &operator++() { return *this; }
+  chunked_back_insert_iterator operator++(int) { return *this; }
+
+protected:
+  Container *container;
+  size_type chunk;
+};
+
+///
+/// @brief Make a chunked_back_insert_iterator for c.
+///
+/// @param c
+/// @param chunk Minimum number of slots reserved at a time
+///
+template <class Container>
+inline chunked_back_insert_iterator<Container>
+chunked_back_inserter(Container &c, typename Container::size_type chunk = 64) {
+  return chunked_back_insert_iterator<Container>(c, chunk);
+}
 } // namespace ft
 
 #endif
\ No newline at end of file
@@ -6,13 +6,16 @@
 /*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/01/13 16:44:54 by bcosters          #+#    #+#             */
-/*   Updated: 2022/07/28 11:18:08 by bcosters         ###   ########.fr       */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef MAP_HPP
 #define MAP_HPP
 
+#include "AggregateRedBlackTree.hpp"
+#include "CompactRedBlackTree.hpp"
+#include "DeferredRedBlackTree.hpp"
 #include "Iterators.hpp"
 #include "RedBlackTree.hpp"
 #include "utility.hpp"
@@ -28,8 +31,24 @@
 #include <stdexcept>
 namespace ft {
 
+///
+/// @brief Iterators of an ft::map over Tree.  When the nodes aggregate the
+/// values, a value may only change through map::update(), so the map's
+/// iterators are the read-only ones.
+///
+template <typename Tree, typename Aggregate = typename Tree::aggregate_type>
+struct MapIterators {
+  typedef typename Tree::const_iterator iterator;
+  typedef typename Tree::const_reverse_iterator reverse_iterator;
+};
+template <typename Tree> struct MapIterators<Tree, RedBlackTreeNoAggregate> {
+  typedef typename Tree::iterator iterator;
+  typedef typename Tree::reverse_iterator reverse_iterator;
+};
+
 template <typename Key, typename T, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<ft::pair<const Key, T> > >
+          typename Alloc = std::allocator<ft::pair<const Key, T> >,
+          typename Nodes = ft::pointer_nodes>
 class map {
 public:
   typedef Key key_type;
@@ -41,7 +60,7 @@ public:
 public:
   class value_compare
       : public std::binary_function<value_type, value_type, bool> {
-    friend class map<Key, T, Compare, Alloc>;
+    friend class map<Key, T, Compare, Alloc, Nodes>;
 
   protected:
     Compare comp;
@@ -55,11 +74,22 @@ public:
 
 private:
   /// This turns a red-black tree into a map.
-  typedef ft::RedBlackTree<key_type, value_type, std::_Select1st<value_type>,
-                           key_compare, allocator_type>
+  typedef typename Nodes::template tree<key_type, value_type,
+                                        std::_Select1st<value_type>,
+                                        key_compare, allocator_type>::type
       tree_type;
   /// The actual tree structure.
   tree_type tree;
+  /// Does not compile with an aggregating node policy: writable references
+  /// to the values would bypass the aggregates.
+  static void requirePlainValues() {
+    typedef char aggregated_values_are_read_only
+        [is_same<typename tree_type::aggregate_type,
+                 RedBlackTreeNoAggregate>::value
+             ? 1
+             : -1];
+    (void)sizeof(aggregated_values_are_read_only);
+  }
 
 public:
   // many of these are specified differently in ISO, but the following are
@@ -68,12 +98,14 @@ public:
   typedef typename Alloc::const_pointer const_pointer;
   typedef typename Alloc::reference reference;
   typedef typename Alloc::const_reference const_reference;
-  typedef typename tree_type::iterator iterator;
+  typedef typename MapIterators<tree_type>::iterator iterator;
   typedef typename tree_type::const_iterator const_iterator;
   typedef typename tree_type::size_type size_type;
   typedef typename tree_type::difference_type difference_type;
-  typedef typename tree_type::reverse_iterator reverse_iterator;
+  typedef typename MapIterators<tree_type>::reverse_iterator reverse_iterator;
   typedef typename tree_type::const_reverse_iterator const_reverse_iterator;
+  /// Only usable with a node policy that aggregates, see aggregate().
+  typedef typename tree_type::aggregate_type aggregate_type;
 
   map() : tree() {}
   explicit map(const Compare &comp, const allocator_type &a = allocator_type())
@@ -203,9 +235,11 @@ public:
   /// subscript.  If the key does not exist, a pair with that key
   /// is created using default values, which is then returned.
   ///
-  /// Lookup requires logarithmic time.
+  /// Lookup requires logarithmic time.  Not available with an
+  /// aggregating node policy, see update().
   ///
   mapped_type &operator[](const key_type &k) {
+    requirePlainValues();
     iterator i = lower_bound(k);
     // i->first is greater than or equivalent to k.
     if (i == end() || key_comp()(k, (*i).first))
@@ -220,6 +254,7 @@ public:
   /// @throw  std::out_of_range  If no such data is present.
   ///
   mapped_type &at(const key_type &k) {
+    requirePlainValues();
     iterator i = lower_bound(k);
     if (i == end() || key_comp()(k, (*i).first))
       std::__throw_out_of_range(__N("map::at"));
@@ -484,6 +519,57 @@ public:
   equal_range(const key_type &x) const {
     return tree.equal_range(x);
   }
+
+  // aggregates
+
+  ///
+  /// @brief Combines the values of the keys in [lo, hi) in key order.
+  /// @param  lo  First key of the range.
+  /// @param  hi  Key past the range.
+  /// @return  The Monoid of ft::aggregate_nodes<Monoid> folded over the
+  ///          range, its identity for an empty range.
+  ///
+  /// Each node keeps the aggregate of its subtree, so this takes
+  /// logarithmic time whatever the size of the range.  Only maps with the
+  /// ft::aggregate_nodes node policy provide it.
+  ///
+  aggregate_type aggregate(const key_type &lo, const key_type &hi) const {
+    return tree.aggregate(lo, hi);
+  }
+
+  ///
+  /// @brief Assigns the mapped value of an element.
+  /// @param  position  An iterator pointing to the element.
+  /// @param  x  The new mapped value.
+  ///
+  /// With an aggregating node policy this is the only way to change a
+  /// mapped value: the iterators are read-only and operator[] does not
+  /// compile.  It refreshes the aggregates in logarithmic time.
+  ///
+  void update(iterator position, const mapped_type &x) {
+    const_cast<mapped_type &>(position->second) = x;
+    tree.refresh(position);
+  }
+
+  // deferred destruction
+
+  ///
+  /// @brief Hands the nodes dropped by clear(), assignment and destruction
+  /// to a reclaimer.
+  /// @param  r  The reclaimer, 0 to free the nodes at once again.
+  ///
+  /// The map is then emptied in constant time and @a r frees the nodes later,
+  /// a bounded amount per r.collect() call or on its own thread.  Only maps
+  /// with the ft::deferred_nodes node policy provide it.
+  ///
+  void set_reclaimer(tree_reclaimer *r) { tree.set_reclaimer(r); }
+
+  template <typename K1, typename T1, typename C1, typename A1, typename N1>
+  friend bool operator==(const map<K1, T1, C1, A1, N1> &,
+                         const map<K1, T1, C1, A1, N1> &);
+  template <typename K1, typename T1, typename C1, typename A1, typename N1>
+  friend bool operator<(const map<K1, T1, C1, A1, N1> &,
+                        const map<K1, T1, C1, A1, N1> &);
 };
 
 ///
@@ -496,9 +582,10 @@ public:
 /// maps.  Maps are considered equivalent if their sizes are equal,
 /// and if corresponding elements compare equal.
 ///
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator==(const map<Key, T, Compare, Alloc> &x,
-                       const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator==(const map<Key, T, Compare, Alloc, Nodes> &x,
+                       const map<Key, T, Compare, Alloc, Nodes> &y) {
   return x.tree == y.tree;
 }
 ///
@@ -512,39 +599,45 @@ inline bool operator==(const map<Key, T, Compare, Alloc> &x,
 ///
 /// See std::lexicographical_compare() for how the determination is made.
 ///
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator<(const map<Key, T, Compare, Alloc> &x,
-                      const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator<(const map<Key, T, Compare, Alloc, Nodes> &x,
+                      const map<Key, T, Compare, Alloc, Nodes> &y) {
   return x.tree < y.tree;
 }
 /// Based on operator==
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator!=(const map<Key, T, Compare, Alloc> &x,
-                       const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator!=(const map<Key, T, Compare, Alloc, Nodes> &x,
+                       const map<Key, T, Compare, Alloc, Nodes> &y) {
   return !(x == y);
 }
 /// Based on operator<
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator>(const map<Key, T, Compare, Alloc> &x,
-                      const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator>(const map<Key, T, Compare, Alloc, Nodes> &x,
+                      const map<Key, T, Compare, Alloc, Nodes> &y) {
   return y < x;
 }
 /// Based on operator<
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator<=(const map<Key, T, Compare, Alloc> &x,
-                       const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator<=(const map<Key, T, Compare, Alloc, Nodes> &x,
+                       const map<Key, T, Compare, Alloc, Nodes> &y) {
   return !(y < x);
 }
 /// Based on operator<
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline bool operator>=(const map<Key, T, Compare, Alloc> &x,
-                       const map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline bool operator>=(const map<Key, T, Compare, Alloc, Nodes> &x,
+                       const map<Key, T, Compare, Alloc, Nodes> &y) {
   return !(x < y);
 }
 /// See std::map::swap().
-template <typename Key, typename T, typename Compare, typename Alloc>
-inline void swap(map<Key, T, Compare, Alloc> &x,
-                 map<Key, T, Compare, Alloc> &y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Nodes>
+inline void swap(map<Key, T, Compare, Alloc, Nodes> &x,
+                 map<Key, T, Compare, Alloc, Nodes> &y) {
   x.swap(y);
 }
 
@@ -0,0 +1,421 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MmapVector.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MMAPVECTOR_HPP
+#define MMAPVECTOR_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ft {
+
+///
+/// @brief First 64 bytes of an mmap_vector file, the elements follow.
+///
+struct MmapVectorHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t elemSize;
+  uint64_t size;
+  char reserved[40];
+};
+
+///
+/// @brief Vector whose storage is a memory-mapped file.
+///
+///    The file holds a header with the element count, then the elements.
+///    Opening an existing file maps it and reads the header, so a restart
+///    costs the pages touched afterwards instead of reloading every
+///    element. Growing extends the file with ftruncate and the mapping
+///    with mremap, the capacity is whatever fits in the file.
+///
+///    Writes reach the page cache at once and the file when the kernel
+///    writes the pages back; sync() forces that with msync. Iterators and
+///    references are invalidated by anything that grows the storage.
+///
+/// @tparam T Trivially copyable and destructible: elements are stored as
+///         raw bytes and never destroyed
+///
+template <typename T> class mmap_vector {
+  typedef char requires_trivial_type[__has_trivial_copy(T) &&
+                                             __has_trivial_destructor(T)
+                                         ? 1
+                                         : -1];
+
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef ft::random_access_iterator<value_type> iterator;
+  typedef ft::random_access_iterator<const value_type> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  enum { header_bytes = sizeof(MmapVectorHeader) };
+  enum { format_version = 1 };
+
+private:
+  int fd;
+  char *base;
+  size_type mapped;
+
+  mmap_vector(const mmap_vector &);
+  mmap_vector &operator=(const mmap_vector &);
+
+  MmapVectorHeader *header() const {
+    return reinterpret_cast<MmapVectorHeader *>(base);
+  }
+  pointer start() const { return reinterpret_cast<pointer>(base + header_bytes); }
+
+  static void fail(const std::string &what) {
+    throw std::runtime_error("ft::mmap_vector: " + what + ": " +
+                             std::strerror(errno));
+  }
+
+  static size_type pageSize() {
+    long n = sysconf(_SC_PAGESIZE);
+    return n > 0 ? size_type(n) : 4096;
+  }
+
+  ///
+  /// @brief File length holding n elements, rounded up to whole pages.
+  ///
+  static size_type fileLength(size_type n) {
+    size_type page = pageSize();
+    return (header_bytes + n * sizeof(T) + page - 1) / page * page;
+  }
+
+  void open(const char *path) {
+    fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+      fail(std::string("open ") + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+      fail(std::string("fstat ") + path);
+    if (st.st_size == 0) {
+      size_type len = fileLength(0);
+      if (ftruncate(fd, off_t(len)) != 0)
+        fail(std::string("ftruncate ") + path);
+      map(len);
+      std::memcpy(header()->magic, "ftmmvec", 8);
+      header()->version = format_version;
+      header()->elemSize = sizeof(T);
+      header()->size = 0;
+      return;
+    }
+    if (size_type(st.st_size) < size_type(header_bytes)) {
+      errno = EINVAL;
+      fail(std::string("truncated header in ") + path);
+    }
+    map(size_type(st.st_size));
+    if (std::memcmp(header()->magic, "ftmmvec", 8) != 0 ||
+        header()->version != format_version ||
+        header()->elemSize != sizeof(T) || header()->size > capacity()) {
+      errno = EINVAL;
+      fail(std::string("bad header in ") + path);
+    }
+  }
+
+  void map(size_type len) {
+    void *p = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+      fail("mmap");
+    base = static_cast<char *>(p);
+    mapped = len;
+  }
+
+  void close() {
+    if (base)
+      munmap(base, mapped);
+    if (fd >= 0)
+      ::close(fd);
+    base = 0;
+    fd = -1;
+    mapped = 0;
+  }
+
+  ///
+  /// @brief Resizes the file and the mapping to hold n elements.
+  ///
+  void remap(size_type n) {
+    size_type len = fileLength(n);
+    if (len == mapped)
+      return;
+    if (len > mapped && ftruncate(fd, off_t(len)) != 0)
+      fail("ftruncate");
+#ifdef MREMAP_MAYMOVE
+    void *p = mremap(base, mapped, len, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED)
+      fail("mremap");
+#else
+    void *p = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+      fail("mmap");
+    munmap(base, mapped);
+#endif
+    base = static_cast<char *>(p);
+    if (len < mapped && ftruncate(fd, off_t(len)) != 0) {
+      mapped = len;
+      fail("ftruncate");
+    }
+    mapped = len;
+  }
+
+  void setSize(size_type n) { header()->size = n; }
+
+  ///
+  /// @brief Makes room for n more elements with the vector growth policy.
+  ///
+  void reserveMore(size_type n, const char *s) {
+    if (capacity() - size() < n)
+      remap(vectorBase<T>::growLength(size(), n, max_size(), s));
+  }
+
+  void requireNonEmpty() const {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+  }
+
+  void rangeCheck(size_type n) const {
+    if (n >= size())
+      throw std::out_of_range("mmap_vector::rangeCheck");
+  }
+
+public:
+  /// ---------- Ctors & operators
+
+  ///
+  /// @brief Opens the vector stored at path, creating an empty one if the
+  /// file does not exist.
+  ///
+  /// @param path
+  ///
+  explicit mmap_vector(const char *path) : fd(-1), base(0), mapped(0) {
+    try {
+      open(path);
+    } catch (...) {
+      close();
+      __throw_exception_again;
+    }
+  }
+  explicit mmap_vector(const std::string &path) : fd(-1), base(0), mapped(0) {
+    try {
+      open(path.c_str());
+    } catch (...) {
+      close();
+      __throw_exception_again;
+    }
+  }
+  ///
+  /// @brief Unmaps the file, its contents stay in place.
+  ///
+  ~mmap_vector() { close(); }
+
+  /// ---------- Iterators
+
+  iterator begin() { return iterator(start()); }
+  const_iterator begin() const { return const_iterator(start()); }
+  iterator end() { return iterator(start() + size()); }
+  const_iterator end() const { return const_iterator(start() + size()); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+
+  size_type size() const { return size_type(header()->size); }
+  size_type capacity() const { return (mapped - header_bytes) / sizeof(T); }
+  size_type max_size() const {
+    return (size_type(-1) / 2 - header_bytes) / sizeof(T);
+  }
+  bool empty() const { return size() == 0; }
+  ///
+  /// @brief Grows the file so it holds at least n elements.
+  ///
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("mmap_vector::reserve");
+    if (n > capacity())
+      remap(n);
+  }
+  ///
+  /// @brief Truncates the file to the pages holding size() elements.
+  ///
+  void shrink_to_fit() { remap(size()); }
+  void resize(size_type n, value_type val = value_type()) {
+    if (n > size())
+      insert(end(), n - size(), val);
+    else
+      setSize(n);
+  }
+
+  /// ---------- Element access
+
+  reference operator[](size_type n) { return start()[n]; }
+  const_reference operator[](size_type n) const { return start()[n]; }
+  reference at(size_type n) {
+    rangeCheck(n);
+    return start()[n];
+  }
+  const_reference at(size_type n) const {
+    rangeCheck(n);
+    return start()[n];
+  }
+  reference front() {
+    requireNonEmpty();
+    return start()[0];
+  }
+  const_reference front() const {
+    requireNonEmpty();
+    return start()[0];
+  }
+  reference back() {
+    requireNonEmpty();
+    return start()[size() - 1];
+  }
+  const_reference back() const {
+    requireNonEmpty();
+    return start()[size() - 1];
+  }
+  pointer data() { return start(); }
+  const_pointer data() const { return start(); }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Takes val by value: growing may move the mapping it lives in.
+  ///
+  void push_back(value_type val) {
+    reserveMore(1, "mmap_vector::push_back");
+    start()[size()] = val;
+    setSize(size() + 1);
+  }
+  void pop_back() {
+    requireNonEmpty();
+    setSize(size() - 1);
+  }
+  ///
+  /// @brief Appends p[0, n), p may point into this vector.
+  ///
+  void append(const value_type *p, size_type n) {
+    if (n == 0)
+      return;
+    if (capacity() - size() < n) {
+      const char *first = reinterpret_cast<const char *>(p);
+      bool inside = first >= base && first < base + mapped;
+      size_type offset = inside ? first - base : 0;
+      reserveMore(n, "mmap_vector::append");
+      if (inside)
+        p = reinterpret_cast<const value_type *>(base + offset);
+    }
+    std::memmove(static_cast<void *>(start() + size()),
+                 static_cast<const void *>(p), n * sizeof(T));
+    setSize(size() + n);
+  }
+  void assign(size_type n, value_type val) {
+    clear();
+    insert(end(), n, val);
+  }
+  template <typename InputIt>
+  typename ft::enable_if<!ft::is_integral<InputIt>::value, void>::type
+  assign(InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+  iterator insert(iterator position, value_type val) {
+    return insert(position, 1, val);
+  }
+  ///
+  /// @brief Inserts n copies of val, the tail moves with one memmove.
+  ///
+  iterator insert(iterator position, size_type n, value_type val) {
+    size_type index = position - begin();
+    if (n == 0)
+      return position;
+    reserveMore(n, "mmap_vector::insert");
+    pointer p = start() + index;
+    std::memmove(static_cast<void *>(p + n), static_cast<const void *>(p),
+                 (size() - index) * sizeof(T));
+    std::fill(p, p + n, val);
+    setSize(size() + n);
+    return iterator(p);
+  }
+  iterator erase(iterator position) { return erase(position, position + 1); }
+  iterator erase(iterator first, iterator last) {
+    size_type index = first - begin();
+    size_type n = last - first;
+    pointer p = start() + index;
+    std::memmove(static_cast<void *>(p), static_cast<const void *>(p + n),
+                 (size() - index - n) * sizeof(T));
+    setSize(size() - n);
+    return iterator(p);
+  }
+  ///
+  /// @brief Empties the vector, the file keeps its length.
+  ///
+  void clear() { setSize(0); }
+  void swap(mmap_vector &x) {
+    ft::swap(fd, x.fd);
+    ft::swap(base, x.base);
+    ft::swap(mapped, x.mapped);
+  }
+
+  /// ---------- Persistence
+
+  ///
+  /// @brief Writes the dirty pages and the header back to the file.
+  ///
+  /// @param wait Block until written (MS_SYNC), else only schedule it
+  ///
+  void sync(bool wait = true) {
+    if (msync(base, mapped, wait ? MS_SYNC : MS_ASYNC) != 0)
+      fail("msync");
+  }
+};
+
+template <typename T>
+inline bool operator==(const mmap_vector<T> &x, const mmap_vector<T> &y) {
+  return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+template <typename T>
+inline bool operator!=(const mmap_vector<T> &x, const mmap_vector<T> &y) {
+  return !(x == y);
+}
+template <typename T>
+inline void swap(mmap_vector<T> &x, mmap_vector<T> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
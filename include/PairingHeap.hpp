@@ -0,0 +1,530 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PairingHeap.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PAIRINGHEAP_HPP
+#define PAIRINGHEAP_HPP
+
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ft {
+///
+/// @brief Node of a pairing heap.
+///
+///    Children form a doubly linked sibling list: child points at the
+///    leftmost child, prev points at the previous sibling or, for the
+///    leftmost child, at the parent. That makes cutting any node O(1).
+///
+template <typename Value> struct PairingHeapNode {
+  typedef PairingHeapNode *node_ptr;
+
+  Value value;
+  node_ptr child;
+  node_ptr next;
+  node_ptr prev;
+
+  PairingHeapNode(const Value &v) : value(v), child(0), next(0), prev(0) {}
+};
+
+///
+/// @brief Stable reference to an element of a pairing_heap.
+///
+///    Stays valid until the element is popped or erased, whatever else
+///    happens to the heap, including a meld into another heap.
+///
+template <typename Value> class PairingHeapHandle {
+  template <typename, typename, typename> friend class pairing_heap;
+  typedef PairingHeapNode<Value> *node_ptr;
+
+  node_ptr node;
+  explicit PairingHeapHandle(node_ptr n) : node(n) {}
+
+public:
+  PairingHeapHandle() : node(0) {}
+
+  const Value &operator*() const { return node->value; }
+  const Value *operator->() const { return &node->value; }
+
+  bool operator==(const PairingHeapHandle &x) const { return node == x.node; }
+  bool operator!=(const PairingHeapHandle &x) const { return node != x.node; }
+};
+
+///
+/// @brief Addressable heap built as a pairing heap.
+///
+///    push, meld and increase are O(1), pop, decrease and erase are
+///    O(log n) amortized. Nodes never move, so push hands out a handle that
+///    can later be used to change the priority of or erase that element.
+///
+///    Nodes are carved out of chunks that double in size and popped nodes
+///    go to a free list, so a long run of push/pop does not call the
+///    allocator at all.
+///
+/// @tparam T
+/// @tparam Compare The top is the greatest element according to Compare,
+///         use std::greater for a min-heap (increase is then the classic
+///         decrease-key)
+/// @tparam Alloc
+///
+template <typename T, typename Compare = std::less<T>,
+          typename Alloc = std::allocator<T> >
+class pairing_heap {
+  typedef PairingHeapNode<T> Node;
+  typedef Node *node_ptr;
+  typedef typename Alloc::template rebind<Node>::other node_allocator_type;
+
+  /// A run of nodes [first, last) in one chunk
+  struct Range {
+    node_ptr first;
+    node_ptr last;
+    Range(node_ptr f = 0, node_ptr l = 0) : first(f), last(l) {}
+  };
+  typedef typename Alloc::template rebind<Range>::other range_allocator_type;
+  typedef ft::vector<Range, range_allocator_type> range_vector;
+
+  enum { first_chunk = 32 };
+
+public:
+  typedef T value_type;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef Compare value_compare;
+  typedef Alloc allocator_type;
+  typedef PairingHeapHandle<T> handle_type;
+
+private:
+  node_allocator_type alloc;
+  Compare comp;
+  node_ptr root;
+  size_type count;
+  /// Pool: owned chunks, never used runs still to hand out (fresh is the
+  /// current one), and a free list of recycled nodes
+  range_vector chunks;
+  range_vector spare;
+  Range fresh;
+  node_ptr freeList;
+  node_ptr freeTail;
+
+  ///
+  /// @brief Check if the container is not empty.
+  ///
+  ///
+  void requireNonEmpty() const {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+  }
+
+  /// ---------- Node pool
+
+  node_ptr getNode() {
+    if (freeList) {
+      node_ptr n = freeList;
+      freeList = n->next;
+      return n;
+    }
+    if (fresh.first == fresh.last) {
+      if (!spare.empty()) {
+        fresh = spare.back();
+        spare.pop_back();
+      } else
+        fresh = newChunk();
+    }
+    return fresh.first++;
+  }
+
+  Range newChunk() {
+    size_type n = chunks.empty()
+                      ? size_type(first_chunk)
+                      : size_type(chunks.back().last - chunks.back().first) * 2;
+    node_ptr chunk = alloc.allocate(n);
+    try {
+      chunks.push_back(Range(chunk, chunk + n));
+      spare.reserve(chunks.size());
+    } catch (...) {
+      if (!chunks.empty() && chunks.back().first == chunk)
+        chunks.pop_back();
+      alloc.deallocate(chunk, n);
+      __throw_exception_again;
+    }
+    return chunks.back();
+  }
+
+  void putNode(node_ptr n) {
+    if (!freeList)
+      freeTail = n;
+    n->next = freeList;
+    freeList = n;
+  }
+
+  node_ptr createNode(const T &val) {
+    node_ptr n = getNode();
+    try {
+      alloc.construct(n, Node(val));
+    } catch (...) {
+      putNode(n);
+      __throw_exception_again;
+    }
+    return n;
+  }
+
+  void destroyNode(node_ptr n) {
+    alloc.destroy(n);
+    putNode(n);
+  }
+
+  void releasePool() {
+    for (size_type i = 0; i < chunks.size(); ++i)
+      alloc.deallocate(chunks[i].first, chunks[i].last - chunks[i].first);
+    chunks.clear();
+    spare.clear();
+    fresh = Range();
+    freeList = freeTail = 0;
+  }
+
+  /// ---------- Pairing
+
+  ///
+  /// @brief Links two detached roots, the loser becomes the leftmost
+  /// child of the winner.
+  ///
+  node_ptr link(node_ptr a, node_ptr b) {
+    if (comp(a->value, b->value)) {
+      node_ptr tmp = a;
+      a = b;
+      b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child)
+      a->child->prev = b;
+    a->child = b;
+    return a;
+  }
+
+  ///
+  /// @brief Detaches n (and its subtree) from its parent and siblings.
+  ///
+  static void cut(node_ptr n) {
+    if (n->prev->child == n)
+      n->prev->child = n->next;
+    else
+      n->prev->next = n->next;
+    if (n->next)
+      n->next->prev = n->prev;
+    n->next = n->prev = 0;
+  }
+
+  ///
+  /// @brief Two-pass pairing of a sibling list into a single root.
+  ///
+  ///    The first pass links neighbours left to right and stacks the
+  ///    winners, the second pass folds that stack back right to left.
+  ///
+  node_ptr combine(node_ptr first) {
+    node_ptr pairs = 0;
+    while (first) {
+      node_ptr a = first;
+      node_ptr b = a->next;
+      a->prev = 0;
+      if (!b) {
+        a->next = pairs;
+        pairs = a;
+        break;
+      }
+      first = b->next;
+      a->next = b->next = b->prev = 0;
+      a = link(a, b);
+      a->next = pairs;
+      pairs = a;
+    }
+    if (!pairs)
+      return 0;
+    node_ptr r = pairs;
+    pairs = pairs->next;
+    r->next = 0;
+    while (pairs) {
+      node_ptr n = pairs;
+      pairs = pairs->next;
+      n->next = 0;
+      r = link(r, n);
+    }
+    return r;
+  }
+
+  void mergeRoot(node_ptr n) { root = root ? link(root, n) : n; }
+
+  ///
+  /// @brief Calls f on every node, parents before children.
+  ///
+  template <typename F> void walk(F &f) const {
+    if (!root)
+      return;
+    ft::vector<node_ptr> todo;
+    todo.push_back(root);
+    while (!todo.empty()) {
+      node_ptr n = todo.back();
+      todo.pop_back();
+      if (n->next)
+        todo.push_back(n->next);
+      if (n->child)
+        todo.push_back(n->child);
+      f(n);
+    }
+  }
+
+  ///
+  /// @brief Destroys every node without allocating: child and next are
+  /// the left and right links of a binary tree, rotated right until the
+  /// node in hand has no child, which is then destroyed.
+  ///
+  void destroyNodes() {
+    node_ptr n = root;
+    while (n) {
+      if (node_ptr c = n->child) {
+        n->child = c->next;
+        c->next = n;
+        n = c;
+      } else {
+        node_ptr next = n->next;
+        alloc.destroy(n);
+        n = next;
+      }
+    }
+    root = 0;
+    count = 0;
+  }
+
+  struct Copy {
+    pairing_heap &heap;
+    Copy(pairing_heap &h) : heap(h) {}
+    void operator()(node_ptr n) { heap.push(n->value); }
+  };
+
+public:
+  /// ---------- Ctors & operators
+
+  explicit pairing_heap(const Compare &x = Compare(),
+                        const allocator_type &a = allocator_type())
+      : alloc(a), comp(x), root(0), count(0), freeList(0),
+        freeTail(0) {}
+  ///
+  /// @brief Builds a heap from a range, each push is O(1).
+  ///
+  template <typename InputIterator>
+  pairing_heap(InputIterator first, InputIterator last,
+               const Compare &x = Compare(),
+               const allocator_type &a = allocator_type())
+      : alloc(a), comp(x), root(0), count(0), freeList(0),
+        freeTail(0) {
+    try {
+      for (; first != last; ++first)
+        push(*first);
+    } catch (...) {
+      destroyNodes();
+      releasePool();
+      __throw_exception_again;
+    }
+  }
+  ///
+  /// @brief Copies the elements, handles of x do not refer into the copy.
+  ///
+  pairing_heap(const pairing_heap &x)
+      : alloc(x.alloc), comp(x.comp), root(0), count(0), freeList(0),
+        freeTail(0) {
+    try {
+      Copy f(*this);
+      x.walk(f);
+    } catch (...) {
+      destroyNodes();
+      releasePool();
+      __throw_exception_again;
+    }
+  }
+
+  ~pairing_heap() {
+    destroyNodes();
+    releasePool();
+  }
+
+  pairing_heap &operator=(const pairing_heap &x) {
+    if (this != &x) {
+      pairing_heap tmp(x);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// ---------- Capacity
+
+  bool empty() const { return count == 0; }
+  size_type size() const { return count; }
+
+  /// ---------- Element access
+
+  const_reference top() const {
+    requireNonEmpty();
+    return root->value;
+  }
+  handle_type top_handle() const {
+    requireNonEmpty();
+    return handle_type(root);
+  }
+  value_compare value_comp() const { return comp; }
+  allocator_type get_allocator() const { return allocator_type(alloc); }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Adds val in O(1).
+  ///
+  /// @return A handle to the new element
+  ///
+  handle_type push(const value_type &val) {
+    node_ptr n = createNode(val);
+    mergeRoot(n);
+    ++count;
+    return handle_type(n);
+  }
+  ///
+  /// @brief Removes the top element in O(log n) amortized.
+  ///
+  void pop() {
+    requireNonEmpty();
+    node_ptr old = root;
+    root = combine(old->child);
+    destroyNode(old);
+    --count;
+  }
+  ///
+  /// @brief Moves h towards the top (val must not compare below the
+  /// current value), O(1).
+  ///
+  void increase(handle_type h, const value_type &val) {
+    node_ptr n = h.node;
+    n->value = val;
+    if (n == root)
+      return;
+    cut(n);
+    root = link(root, n);
+  }
+  ///
+  /// @brief Moves h away from the top (val must not compare above the
+  /// current value), O(log n) amortized.
+  ///
+  void decrease(handle_type h, const value_type &val) {
+    node_ptr n = h.node;
+    n->value = val;
+    node_ptr kids = n->child;
+    n->child = 0;
+    if (n == root) {
+      root = combine(kids);
+      mergeRoot(n);
+      return;
+    }
+    cut(n);
+    root = link(root, n);
+    if (kids)
+      root = link(root, combine(kids));
+  }
+  ///
+  /// @brief Sets the value of h, moving it whichever way is needed.
+  ///
+  void update(handle_type h, const value_type &val) {
+    if (comp(val, h.node->value))
+      decrease(h, val);
+    else
+      increase(h, val);
+  }
+  ///
+  /// @brief Removes the element of h in O(log n) amortized.
+  ///
+  void erase(handle_type h) {
+    node_ptr n = h.node;
+    if (n == root) {
+      pop();
+      return;
+    }
+    cut(n);
+    if (n->child)
+      root = link(root, combine(n->child));
+    destroyNode(n);
+    --count;
+  }
+  ///
+  /// @brief Moves every element of x into this heap in O(1), plus
+  /// splicing x's node pool (one entry per chunk, so O(log n)).
+  ///
+  ///    Handles into x stay valid and now refer into this heap. x must
+  ///    use an allocator that compares equal to this one.
+  ///
+  void meld(pairing_heap &x) {
+    if (this == &x)
+      return;
+    chunks.reserve(chunks.size() + x.chunks.size());
+    spare.reserve(chunks.size() + x.chunks.size());
+    if (x.root)
+      mergeRoot(x.root);
+    count += x.count;
+    for (size_type i = 0; i < x.chunks.size(); ++i)
+      chunks.push_back(x.chunks[i]);
+    for (size_type i = 0; i < x.spare.size(); ++i)
+      spare.push_back(x.spare[i]);
+    if (x.fresh.first != x.fresh.last)
+      spare.push_back(x.fresh);
+    if (x.freeList) {
+      x.freeTail->next = freeList;
+      if (!freeList)
+        freeTail = x.freeTail;
+      freeList = x.freeList;
+    }
+    x.root = 0;
+    x.count = 0;
+    x.chunks.clear();
+    x.spare.clear();
+    x.fresh = Range();
+    x.freeList = x.freeTail = 0;
+  }
+  ///
+  /// @brief Destroys every element, the node pool is kept for reuse.
+  ///
+  void clear() {
+    destroyNodes();
+    fresh = Range();
+    freeList = freeTail = 0;
+    spare = chunks;
+  }
+
+  void swap(pairing_heap &x) {
+    ft::swap(alloc, x.alloc);
+    ft::swap(comp, x.comp);
+    ft::swap(root, x.root);
+    ft::swap(count, x.count);
+    chunks.swap(x.chunks);
+    spare.swap(x.spare);
+    ft::swap(fresh, x.fresh);
+    ft::swap(freeList, x.freeList);
+    ft::swap(freeTail, x.freeTail);
+  }
+};
+
+template <typename T, typename Compare, typename Alloc>
+inline void swap(pairing_heap<T, Compare, Alloc> &x,
+                 pairing_heap<T, Compare, Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,414 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Parallel.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace ft {
+namespace parallel {
+
+enum {
+  /// Below this many elements per block a range is not worth splitting
+  min_grain = 1 << 14,
+  /// Blocks per thread, the slack lets work stealing even out slow blocks
+  blocks_per_thread = 4
+};
+
+///
+/// @brief Splits n elements into count nearly equal blocks.
+///
+struct Blocks {
+  std::size_t n;
+  std::size_t count;
+
+  Blocks(std::size_t size, std::size_t maxBlocks) : n(size) {
+    count = size / min_grain;
+    if (count > maxBlocks)
+      count = maxBlocks;
+    if (count == 0)
+      count = 1;
+  }
+  std::size_t begin(std::size_t i) const {
+    return i == count ? n : n / count * i + std::min(i, n % count);
+  }
+  std::size_t end(std::size_t i) const { return begin(i + 1); }
+};
+
+inline Blocks blocksFor(std::size_t n) {
+  return Blocks(n, thread_count() * blocks_per_thread);
+}
+
+///
+/// @brief Contiguous ranges are handed to the blocks as plain pointers:
+/// std algorithms do not know ft iterator tags.
+///
+template <typename Iterator>
+inline typename ft::iterator_traits<Iterator>::pointer
+rawPointer(Iterator it) {
+  return &*it;
+}
+
+/// ---------- Bodies, one call per block
+
+/// Pointer is const T * over a read-only range.
+template <typename Pointer, typename F> struct ForEachBody {
+  Pointer data;
+  Blocks blocks;
+  const F &f;
+  ForEachBody(Pointer p, const Blocks &b, const F &fn)
+      : data(p), blocks(b), f(fn) {}
+  void operator()(std::size_t i) {
+    std::for_each(data + blocks.begin(i), data + blocks.end(i), F(f));
+  }
+};
+
+template <typename T, typename U, typename Op> struct TransformBody {
+  const T *in;
+  U *out;
+  Blocks blocks;
+  const Op &op;
+  TransformBody(const T *src, U *dst, const Blocks &b, const Op &o)
+      : in(src), out(dst), blocks(b), op(o) {}
+  void operator()(std::size_t i) {
+    std::transform(in + blocks.begin(i), in + blocks.end(i),
+                   out + blocks.begin(i), op);
+  }
+};
+
+template <typename T1, typename T2, typename U, typename Op>
+struct Transform2Body {
+  const T1 *in1;
+  const T2 *in2;
+  U *out;
+  Blocks blocks;
+  const Op &op;
+  Transform2Body(const T1 *a, const T2 *b, U *dst, const Blocks &bl,
+                 const Op &o)
+      : in1(a), in2(b), out(dst), blocks(bl), op(o) {}
+  void operator()(std::size_t i) {
+    std::transform(in1 + blocks.begin(i), in1 + blocks.end(i),
+                   in2 + blocks.begin(i), out + blocks.begin(i), op);
+  }
+};
+
+///
+/// @brief Folds each block, the partial results are kept in block order so
+/// op only needs to be associative.
+///
+template <typename T, typename U, typename Op> struct ReduceBody {
+  const T *data;
+  Blocks blocks;
+  const Op &op;
+  ft::vector<U> &partial;
+  ReduceBody(const T *p, const Blocks &b, const Op &o, ft::vector<U> &out)
+      : data(p), blocks(b), op(o), partial(out) {}
+  void operator()(std::size_t i) {
+    const T *first = data + blocks.begin(i);
+    const T *last = data + blocks.end(i);
+    U acc = *first;
+    while (++first != last)
+      acc = op(acc, *first);
+    partial[i] = acc;
+  }
+};
+
+template <typename T, typename U, typename Op> struct ScanBody {
+  const T *in;
+  U *out;
+  Blocks blocks;
+  const Op &op;
+  const ft::vector<U> &carry;
+  ScanBody(const T *src, U *dst, const Blocks &b, const Op &o,
+           const ft::vector<U> &c)
+      : in(src), out(dst), blocks(b), op(o), carry(c) {}
+  void operator()(std::size_t i) {
+    std::size_t k = blocks.begin(i);
+    std::size_t last = blocks.end(i);
+    U acc = i ? op(carry[i - 1], in[k]) : U(in[k]);
+    out[k] = acc;
+    while (++k != last) {
+      acc = op(acc, in[k]);
+      out[k] = acc;
+    }
+  }
+};
+
+template <typename T, typename Compare, bool Stable> struct SortBody {
+  T *data;
+  Blocks blocks;
+  const Compare &comp;
+  SortBody(T *p, const Blocks &b, const Compare &c)
+      : data(p), blocks(b), comp(c) {}
+  void operator()(std::size_t i) {
+    if (Stable)
+      std::stable_sort(data + blocks.begin(i), data + blocks.end(i), comp);
+    else
+      std::sort(data + blocks.begin(i), data + blocks.end(i), comp);
+  }
+};
+
+///
+/// @brief Number of elements of a that come before output position k when
+/// a and b are merged stably (ties go to a).
+///
+template <typename T, typename Compare>
+std::size_t mergeSplit(const T *a, std::size_t na, const T *b, std::size_t nb,
+                       std::size_t k, const Compare &comp) {
+  std::size_t lo = k > nb ? k - nb : 0;
+  std::size_t hi = k < na ? k : na;
+  while (lo < hi) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    if (!comp(b[k - mid - 1], a[mid]))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+///
+/// @brief One round of pairwise run merges from src into dst. Each merge
+/// is cut into pieces along the output, so the last round with a single
+/// merge still uses every thread.
+///
+template <typename T, typename Compare> struct MergeBody {
+  const T *src;
+  T *dst;
+  Blocks runs;
+  std::size_t width;
+  std::size_t pieces;
+  const Compare &comp;
+  MergeBody(const T *s, T *d, const Blocks &r, std::size_t w, std::size_t p,
+            const Compare &c)
+      : src(s), dst(d), runs(r), width(w), pieces(p), comp(c) {}
+  void operator()(std::size_t t) {
+    std::size_t pair = t / pieces;
+    std::size_t piece = t % pieces;
+    std::size_t lo = runs.begin(pair * 2 * width);
+    std::size_t mid = runs.begin(std::min(pair * 2 * width + width, runs.count));
+    std::size_t hi = runs.begin(std::min(pair * 2 * width + 2 * width, runs.count));
+    const T *a = src + lo;
+    const T *b = src + mid;
+    std::size_t na = mid - lo;
+    std::size_t nb = hi - mid;
+    std::size_t k0 = (na + nb) * piece / pieces;
+    std::size_t k1 = (na + nb) * (piece + 1) / pieces;
+    std::size_t i0 = mergeSplit(a, na, b, nb, k0, comp);
+    std::size_t i1 = mergeSplit(a, na, b, nb, k1, comp);
+    std::merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + lo + k0,
+               comp);
+  }
+};
+
+///
+/// @brief Identity, turns TransformBody into a parallel copy.
+///
+struct Copy {
+  template <typename T> const T &operator()(const T &x) const { return x; }
+};
+
+///
+/// @brief Sorts blocks in parallel, then merges them pairwise through a
+/// scratch copy, log2(blocks) rounds.
+///
+template <bool Stable, typename T, typename Compare>
+void sortRange(T *data, std::size_t n, const Compare &comp) {
+  thread_pool &pool = default_pool();
+  Blocks runs = blocksFor(n);
+  // A power of two number of runs keeps every merge round balanced.
+  std::size_t count = 1;
+  while (count * 2 <= runs.count)
+    count *= 2;
+  runs.count = count;
+  SortBody<T, Compare, Stable> sorter(data, runs, comp);
+  pool.run(runs.count, sorter);
+  if (runs.count == 1)
+    return;
+  ft::vector<T> scratch(data, data + n);
+  T *src = data;
+  T *dst = scratch.data();
+  for (std::size_t width = 1; width < runs.count; width *= 2) {
+    std::size_t pairs = runs.count / (2 * width);
+    std::size_t pieces = (pool.size() * blocks_per_thread + pairs - 1) / pairs;
+    if (pieces > n / min_grain / pairs)
+      pieces = std::max<std::size_t>(1, n / min_grain / pairs);
+    MergeBody<T, Compare> merger(src, dst, runs, width, pieces, comp);
+    pool.run(pairs * pieces, merger);
+    ft::swap(src, dst);
+  }
+  if (src != data) {
+    Blocks blocks = blocksFor(n);
+    TransformBody<T, T, Copy> copier(src, data, blocks, Copy());
+    pool.run(blocks.count, copier);
+  }
+}
+
+/// ---------- Algorithms
+
+///
+/// @brief Sorts a contiguous range with all threads of the default pool.
+///
+///    Each block is sorted with std::sort, then the sorted runs are merged
+///    pairwise, a merge being split between threads at output positions.
+///    Needs n extra elements of scratch space when more than one block.
+///
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+  std::size_t n = last - first;
+  if (n > 1)
+    sortRange<false>(rawPointer(first), n, comp);
+}
+template <typename RandomIt> void sort(RandomIt first, RandomIt last) {
+  ft::parallel::sort(first, last,
+       std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+///
+/// @brief Like sort, but equal elements keep their order.
+///
+template <typename RandomIt, typename Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+  std::size_t n = last - first;
+  if (n > 1)
+    sortRange<true>(rawPointer(first), n, comp);
+}
+template <typename RandomIt> void stable_sort(RandomIt first, RandomIt last) {
+  ft::parallel::stable_sort(first, last,
+              std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+///
+/// @brief Applies f to every element, each block gets its own copy of f
+/// and blocks run in no particular order.
+///
+template <typename RandomIt, typename Function>
+void for_each(RandomIt first, RandomIt last, Function f) {
+  typedef typename ft::iterator_traits<RandomIt>::pointer Pointer;
+  std::size_t n = last - first;
+  if (n == 0)
+    return;
+  Blocks blocks = blocksFor(n);
+  ForEachBody<Pointer, Function> body(rawPointer(first), blocks, f);
+  default_pool().run(blocks.count, body);
+}
+///
+/// @brief out[i] = op(first[i]), out must be contiguous with room for the
+/// whole range; it may be first.
+///
+/// @return out advanced past the last element written
+///
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt transform(RandomIt first, RandomIt last, OutputIt out, UnaryOp op) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type T;
+  typedef typename ft::iterator_traits<OutputIt>::value_type U;
+  std::size_t n = last - first;
+  if (n == 0)
+    return out;
+  Blocks blocks = blocksFor(n);
+  TransformBody<T, U, UnaryOp> body(rawPointer(first), rawPointer(out),
+                                    blocks, op);
+  default_pool().run(blocks.count, body);
+  return out + n;
+}
+///
+/// @brief out[i] = op(first1[i], first2[i]).
+///
+template <typename RandomIt1, typename RandomIt2, typename OutputIt,
+          typename BinaryOp>
+OutputIt transform(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2,
+                   OutputIt out, BinaryOp op) {
+  typedef typename ft::iterator_traits<RandomIt1>::value_type T1;
+  typedef typename ft::iterator_traits<RandomIt2>::value_type T2;
+  typedef typename ft::iterator_traits<OutputIt>::value_type U;
+  std::size_t n = last1 - first1;
+  if (n == 0)
+    return out;
+  Blocks blocks = blocksFor(n);
+  Transform2Body<T1, T2, U, BinaryOp> body(
+      rawPointer(first1), rawPointer(first2), rawPointer(out), blocks, op);
+  default_pool().run(blocks.count, body);
+  return out + n;
+}
+///
+/// @brief Folds the range with op, which must be associative (it need not
+/// be commutative, blocks are combined in order).
+///
+template <typename RandomIt, typename T, typename BinaryOp>
+T reduce(RandomIt first, RandomIt last, T init, BinaryOp op) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type V;
+  std::size_t n = last - first;
+  if (n == 0)
+    return init;
+  Blocks blocks = blocksFor(n);
+  ft::vector<T> partial(blocks.count, init);
+  ReduceBody<V, T, BinaryOp> body(rawPointer(first), blocks, op, partial);
+  default_pool().run(blocks.count, body);
+  for (std::size_t i = 0; i < blocks.count; ++i)
+    init = op(init, partial[i]);
+  return init;
+}
+template <typename RandomIt, typename T>
+T reduce(RandomIt first, RandomIt last, T init) {
+  return ft::parallel::reduce(first, last, init, std::plus<T>());
+}
+template <typename RandomIt>
+typename ft::iterator_traits<RandomIt>::value_type reduce(RandomIt first,
+                                                          RandomIt last) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type T;
+  return ft::parallel::reduce(first, last, T(), std::plus<T>());
+}
+///
+/// @brief out[i] = first[0] op ... op first[i], op must be associative.
+///
+///    Two passes: blocks are reduced in parallel, the block totals are
+///    scanned on the calling thread, then every block is scanned from its
+///    carry. out may be first.
+///
+/// @return out advanced past the last element written
+///
+template <typename RandomIt, typename OutputIt, typename BinaryOp>
+OutputIt inclusive_scan(RandomIt first, RandomIt last, OutputIt out,
+                        BinaryOp op) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type T;
+  typedef typename ft::iterator_traits<OutputIt>::value_type U;
+  std::size_t n = last - first;
+  if (n == 0)
+    return out;
+  Blocks blocks = blocksFor(n);
+  thread_pool &pool = default_pool();
+  const T *in = rawPointer(first);
+  ft::vector<U> carry(blocks.count, U(in[0]));
+  if (blocks.count > 1) {
+    ReduceBody<T, U, BinaryOp> reducer(in, blocks, op, carry);
+    pool.run(blocks.count, reducer);
+    for (std::size_t i = 1; i < blocks.count; ++i)
+      carry[i] = op(carry[i - 1], carry[i]);
+  }
+  ScanBody<T, U, BinaryOp> scanner(in, rawPointer(out), blocks, op, carry);
+  pool.run(blocks.count, scanner);
+  return out + n;
+}
+template <typename RandomIt, typename OutputIt>
+OutputIt inclusive_scan(RandomIt first, RandomIt last, OutputIt out) {
+  typedef typename ft::iterator_traits<OutputIt>::value_type U;
+  return ft::parallel::inclusive_scan(first, last, out, std::plus<U>());
+}
+
+} // namespace parallel
+} // namespace ft
+
+#endif
@@ -0,0 +1,546 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PersistentMap.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:40:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PERSISTENTMAP_HPP
+#define PERSISTENTMAP_HPP
+
+#include "Iterators.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+///
+/// @brief Node of a persistent_map, shared by every version that reaches it.
+///
+///    There is no parent link: a shared node has one parent per version.
+///    Once linked a node is never modified, except for its reference count.
+///
+template <typename Value> struct PersistentMapNode {
+  /// Owners of the node: parent nodes and maps whose root it is.
+  std::size_t refs;
+  int height;
+  PersistentMapNode *left;
+  PersistentMapNode *right;
+  Value value;
+};
+
+///
+/// @brief Bidirectional iterator over one version of a persistent_map.
+///
+///    Nodes have no parent link, so the iterator carries the path from the
+///    root to its element. It stays valid while some map still holds the
+///    version it was taken from.
+///
+/// @tparam Value
+///
+template <typename Value> struct PersistentMap_iterator {
+  typedef Value value_type;
+  typedef const Value &reference;
+  typedef const Value *pointer;
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef PersistentMap_iterator<Value> Self;
+  typedef const PersistentMapNode<Value> *node_ptr;
+
+  /// Deepest path, see persistent_map::max_size().
+  enum { max_depth = 64 };
+
+  PersistentMap_iterator() : root(), depth(0) {}
+  explicit PersistentMap_iterator(node_ptr r) : root(r), depth(0) {}
+  PersistentMap_iterator(const Self &x) : root(x.root), depth(x.depth) {
+    std::copy(x.path, x.path + depth, path);
+  }
+  Self &operator=(const Self &x) {
+    root = x.root;
+    depth = x.depth;
+    std::copy(x.path, x.path + depth, path);
+    return *this;
+  }
+
+  reference operator*() const { return path[depth - 1]->value; }
+  pointer operator->() const { return &path[depth - 1]->value; }
+
+  Self &operator++() {
+    node_ptr x = path[depth - 1];
+    if (x->right != 0) {
+      pushLeftmost(x->right);
+      return *this;
+    }
+    // Climb while coming from a right child, end() past the root.
+    x = path[--depth];
+    while (depth != 0 && path[depth - 1]->right == x)
+      x = path[--depth];
+    return *this;
+  }
+  Self operator++(int) {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  Self &operator--() {
+    if (depth == 0) {
+      pushRightmost(root);
+      return *this;
+    }
+    node_ptr x = path[depth - 1];
+    if (x->left != 0) {
+      pushRightmost(x->left);
+      return *this;
+    }
+    x = path[--depth];
+    while (depth != 0 && path[depth - 1]->left == x)
+      x = path[--depth];
+    return *this;
+  }
+  Self operator--(int) {
+    Self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const Self &lhs, const Self &rhs) {
+    return lhs.node() == rhs.node();
+  }
+  friend bool operator!=(const Self &lhs, const Self &rhs) {
+    return lhs.node() != rhs.node();
+  }
+
+  node_ptr node() const { return depth != 0 ? path[depth - 1] : 0; }
+  void pushLeftmost(node_ptr x) {
+    for (; x != 0; x = x->left)
+      path[depth++] = x;
+  }
+  void pushRightmost(node_ptr x) {
+    for (; x != 0; x = x->right)
+      path[depth++] = x;
+  }
+
+  node_ptr root;
+  std::size_t depth;
+  node_ptr path[max_depth];
+};
+
+///
+/// @brief Immutable ordered map whose copies and snapshots are O(1).
+///
+///    An update copies the O(log n) nodes on the path to the change and
+///    links the copies to the untouched subtrees, which the previous
+///    version keeps sharing; a node is freed with the last version holding
+///    it. Copying the map, or snapshot(), only takes a reference on the
+///    root. Nodes are reference counted with atomic operations, so
+///    different persistent_map objects sharing nodes can be read, updated
+///    and destroyed on different threads; one object is not thread-safe.
+///
+///    A path copy cannot keep the parent links the RedBlackTree algorithms
+///    rebalance with, so the tree is height balanced (AVL): the height of
+///    the two subtrees of a node differ by at most one, and rebalancing is
+///    done while the copied path is rebuilt.
+///
+///    Elements are read-only, insert_or_assign() replaces a mapped value.
+///
+/// @tparam Key
+/// @tparam T
+/// @tparam Compare
+/// @tparam Alloc
+///
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<ft::pair<const Key, T> > >
+class persistent_map {
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef ft::pair<const Key, T> value_type;
+  typedef Compare key_compare;
+  typedef Alloc allocator_type;
+  typedef typename Alloc::const_pointer pointer;
+  typedef typename Alloc::const_pointer const_pointer;
+  typedef typename Alloc::const_reference reference;
+  typedef typename Alloc::const_reference const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef PersistentMap_iterator<value_type> iterator;
+  typedef PersistentMap_iterator<value_type> const_iterator;
+  typedef ft::reverse_iterator<const_iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+  typedef PersistentMapNode<value_type> node;
+  typedef typename Alloc::template rebind<node>::other node_allocator_type;
+
+public:
+  /// ---------- Ctors & operators
+
+  persistent_map() : nodeAlloc(), keyCompare(), root(0), nodeCount(0) {}
+  explicit persistent_map(const Compare &comp,
+                          const allocator_type &a = allocator_type())
+      : nodeAlloc(a), keyCompare(comp), root(0), nodeCount(0) {}
+  template <typename InputIterator>
+  persistent_map(InputIterator first, InputIterator last)
+      : nodeAlloc(), keyCompare(), root(0), nodeCount(0) {
+    insert(first, last);
+  }
+  /// Shares every node of x, O(1).
+  persistent_map(const persistent_map &x)
+      : nodeAlloc(x.nodeAlloc), keyCompare(x.keyCompare),
+        root(retain(x.root)), nodeCount(x.nodeCount) {}
+  persistent_map &operator=(const persistent_map &x) {
+    node *old = root;
+    root = retain(x.root);
+    release(old);
+    keyCompare = x.keyCompare;
+    nodeCount = x.nodeCount;
+    return *this;
+  }
+  /// Frees the nodes no other version shares.
+  ~persistent_map() { release(root); }
+
+  ///
+  /// @brief Point-in-time view of the map, later updates of either side do
+  /// not show in the other one. O(1).
+  ///
+  persistent_map snapshot() const { return *this; }
+
+  allocator_type get_allocator() const { return allocator_type(nodeAlloc); }
+
+  /// ---------- Iterators
+  const_iterator begin() const {
+    const_iterator it(root);
+    it.pushLeftmost(root);
+    return it;
+  }
+  const_iterator end() const { return const_iterator(root); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+  bool empty() const { return nodeCount == 0; }
+  size_type size() const { return nodeCount; }
+  ///
+  /// @brief Also bounded so that the tree height, which is at most about
+  /// 1.44 log2(n), fits an iterator path.
+  ///
+  size_type max_size() const {
+    // A tree of height h holds at least fib(h + 2) - 1 nodes.
+    const size_type n = nodeAlloc.max_size();
+    size_type a = 0;
+    size_type b = 1;
+    for (int i = 1; i < const_iterator::max_depth + 2 && b < n; i++) {
+      const size_type c = a + b;
+      a = b;
+      b = c;
+    }
+    return std::min(b - 1, n);
+  }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Inserts x unless its key is present, O(log n) new nodes.
+  ///
+  /// @return pair<iterator, bool> Position of the element with that key and
+  /// whether x was inserted
+  ///
+  ft::pair<iterator, bool> insert(const value_type &x) {
+    return update(x, false);
+  }
+  iterator insert(iterator, const value_type &x) { return insert(x).first; }
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  ///
+  /// @brief Inserts (k, x), or replaces the mapped value of k.
+  ///
+  /// @return pair<iterator, bool> Position of k and whether it was inserted
+  ///
+  ft::pair<iterator, bool> insert_or_assign(const key_type &k,
+                                            const mapped_type &x) {
+    return update(value_type(k, x), true);
+  }
+
+  size_type erase(const key_type &k) {
+    node *r = erase(root, k);
+    if (r == root)
+      return 0;
+    release(root);
+    root = r;
+    --nodeCount;
+    return 1;
+  }
+  void erase(iterator position) { erase(position->first); }
+  void erase(iterator first, iterator last) {
+    // The range belongs to the version being replaced, hold it while
+    // walking it.
+    const persistent_map before(*this);
+    while (first != last)
+      erase((first++)->first);
+  }
+  void swap(persistent_map &x) {
+    ft::swap(nodeAlloc, x.nodeAlloc);
+    ft::swap(keyCompare, x.keyCompare);
+    ft::swap(root, x.root);
+    ft::swap(nodeCount, x.nodeCount);
+  }
+  void clear() {
+    release(root);
+    root = 0;
+    nodeCount = 0;
+  }
+
+  /// ---------- Lookup
+  const_iterator find(const key_type &k) const {
+    const_iterator j = lower_bound(k);
+    return (j == end() || keyCompare(k, j->first)) ? end() : j;
+  }
+  size_type count(const key_type &k) const { return find(k) != end(); }
+  const_iterator lower_bound(const key_type &k) const {
+    const_iterator it(root);
+    std::size_t keep = 0;
+    for (const node *x = root; x != 0;) {
+      it.path[it.depth++] = x;
+      if (!keyCompare(x->value.first, k)) {
+        keep = it.depth;
+        x = x->left;
+      } else
+        x = x->right;
+    }
+    it.depth = keep;
+    return it;
+  }
+  const_iterator upper_bound(const key_type &k) const {
+    const_iterator it(root);
+    std::size_t keep = 0;
+    for (const node *x = root; x != 0;) {
+      it.path[it.depth++] = x;
+      if (keyCompare(k, x->value.first)) {
+        keep = it.depth;
+        x = x->left;
+      } else
+        x = x->right;
+    }
+    it.depth = keep;
+    return it;
+  }
+  ft::pair<const_iterator, const_iterator>
+  equal_range(const key_type &k) const {
+    return ft::pair<const_iterator, const_iterator>(lower_bound(k),
+                                                    upper_bound(k));
+  }
+
+  key_compare key_comp() const { return keyCompare; }
+
+  /// Versions sharing their root are equal without a walk.
+  friend bool operator==(const persistent_map &x, const persistent_map &y) {
+    return x.root == y.root ||
+           (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
+  }
+
+private:
+  static int height(const node *x) { return x ? x->height : 0; }
+
+  static node *retain(node *x) {
+    if (x != 0)
+      __atomic_add_fetch(&x->refs, 1, __ATOMIC_RELAXED);
+    return x;
+  }
+
+  void release(node *x) {
+    while (x != 0 && __atomic_sub_fetch(&x->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+      node *right = x->right;
+      release(x->left);
+      get_allocator().destroy(&x->value);
+      nodeAlloc.deallocate(x, 1);
+      x = right;
+    }
+  }
+
+  ///
+  /// @brief New node owning l and r, which it releases if it throws.
+  ///
+  node *makeNode(const value_type &v, node *l, node *r) {
+    node *x = 0;
+    try {
+      x = nodeAlloc.allocate(1);
+      get_allocator().construct(&x->value, v);
+    } catch (...) {
+      if (x != 0)
+        nodeAlloc.deallocate(x, 1);
+      release(l);
+      release(r);
+      __throw_exception_again;
+    }
+    x->refs = 1;
+    x->height = 1 + std::max(height(l), height(r));
+    x->left = l;
+    x->right = r;
+    return x;
+  }
+
+  ///
+  /// @brief Node v over l and r, rotated when their heights differ by two.
+  ///
+  ///    Takes l and r, even if it throws. A rotation copies the dissolved
+  ///    child of the taller side, and its inner child for a double one.
+  ///
+  node *join(const value_type &v, node *l, node *r) {
+    if (height(l) > height(r) + 1)
+      return rotate(v, l, r, &node::left, &node::right);
+    if (height(r) > height(l) + 1)
+      return rotate(v, r, l, &node::right, &node::left);
+    return makeNode(v, l, r);
+  }
+
+  ///
+  /// @brief Rebalances v over the taller subtree t and the shorter s, with
+  /// the outer and inner sides of t named by the member pointers.
+  ///
+  node *rotate(const value_type &v, node *t, node *s, node *node::*outer,
+               node *node::*inner) {
+    node *res;
+    try {
+      if (height(t->*outer) >= height(t->*inner)) {
+        node *down = attach(v, retain(t->*inner), s, outer);
+        res = attach(t->value, retain(t->*outer), down, outer);
+      } else {
+        node *m = t->*inner;
+        node *down = attach(v, retain(m->*inner), s, outer);
+        node *up;
+        try {
+          up = attach(t->value, retain(t->*outer), retain(m->*outer), outer);
+        } catch (...) {
+          release(down);
+          __throw_exception_again;
+        }
+        res = attach(m->value, up, down, outer);
+      }
+    } catch (...) {
+      release(t);
+      __throw_exception_again;
+    }
+    release(t);
+    return res;
+  }
+
+  /// makeNode with o on the side named outer and i on the other one.
+  node *attach(const value_type &v, node *o, node *i, node *node::*outer) {
+    return outer == &node::left ? makeNode(v, o, i) : makeNode(v, i, o);
+  }
+
+  ///
+  /// @brief Copy of the subtree x holding v.
+  ///
+  /// @return node* New subtree, or x itself when k is present and assign is
+  /// false
+  ///
+  node *insert(node *x, const value_type &v, bool assign, bool &added) {
+    if (x == 0) {
+      added = true;
+      return makeNode(v, 0, 0);
+    }
+    if (keyCompare(v.first, x->value.first)) {
+      node *l = insert(x->left, v, assign, added);
+      return l == x->left ? x : join(x->value, l, retain(x->right));
+    }
+    if (keyCompare(x->value.first, v.first)) {
+      node *r = insert(x->right, v, assign, added);
+      return r == x->right ? x : join(x->value, retain(x->left), r);
+    }
+    if (!assign)
+      return x;
+    return makeNode(v, retain(x->left), retain(x->right));
+  }
+
+  ///
+  /// @brief Copy of the subtree x without k.
+  ///
+  /// @return node* New subtree, or x itself when k is absent
+  ///
+  node *erase(node *x, const key_type &k) {
+    if (x == 0)
+      return 0;
+    if (keyCompare(k, x->value.first)) {
+      node *l = erase(x->left, k);
+      return l == x->left ? x : join(x->value, l, retain(x->right));
+    }
+    if (keyCompare(x->value.first, k)) {
+      node *r = erase(x->right, k);
+      return r == x->right ? x : join(x->value, retain(x->left), r);
+    }
+    if (x->left == 0)
+      return retain(x->right);
+    if (x->right == 0)
+      return retain(x->left);
+    // The successor takes the place of x, the old version keeps it alive.
+    const node *next = x->right;
+    while (next->left != 0)
+      next = next->left;
+    node *r = eraseMinimum(x->right);
+    return join(next->value, retain(x->left), r);
+  }
+
+  node *eraseMinimum(node *x) {
+    if (x->left == 0)
+      return retain(x->right);
+    node *l = eraseMinimum(x->left);
+    return join(x->value, l, retain(x->right));
+  }
+
+  ft::pair<iterator, bool> update(const value_type &v, bool assign) {
+    bool added = false;
+    if (nodeCount >= max_size())
+      throw std::length_error("persistent_map::insert");
+    node *r = insert(root, v, assign, added);
+    if (r != root) {
+      release(root);
+      root = r;
+    }
+    nodeCount += added;
+    return ft::pair<iterator, bool>(find(v.first), added);
+  }
+
+  node_allocator_type nodeAlloc;
+  Compare keyCompare;
+  node *root;
+  size_type nodeCount;
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline bool operator!=(const persistent_map<Key, T, Compare, Alloc> &x,
+                       const persistent_map<Key, T, Compare, Alloc> &y) {
+  return !(x == y);
+}
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline bool operator<(const persistent_map<Key, T, Compare, Alloc> &x,
+                      const persistent_map<Key, T, Compare, Alloc> &y) {
+  return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+inline void swap(persistent_map<Key, T, Compare, Alloc> &x,
+                 persistent_map<Key, T, Compare, Alloc> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,204 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PriorityQueue.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PRIORITYQUEUE_HPP
+#define PRIORITYQUEUE_HPP
+
+#include "Vector.hpp"
+#include <cstddef>
+#include <functional>
+
+namespace ft {
+///
+/// @brief Priority queue adapter over a d-ary heap.
+///
+///    Arity picks the number of children per node: 2 is the classic binary
+///    heap, 4 or 8 make the heap shallower and keep a node's children in one
+///    or two cache lines, so a pop touches fewer lines on large heaps.
+///
+/// @tparam T
+/// @tparam Sequence Needs operator[], push_back, pop_back, back, size
+/// @tparam Compare The top is the greatest element according to Compare
+/// @tparam Arity 2, 4 or 8 children per node
+///
+template <typename T, typename Sequence = ft::vector<T>,
+          typename Compare = std::less<typename Sequence::value_type>,
+          std::size_t Arity = 2>
+class priority_queue {
+  typedef char invalid_arity[Arity >= 2 ? 1 : -1];
+
+public:
+  typedef typename Sequence::value_type value_type;
+  typedef typename Sequence::reference reference;
+  typedef typename Sequence::const_reference const_reference;
+  typedef typename Sequence::size_type size_type;
+  typedef Sequence container_type;
+  typedef Compare value_compare;
+
+  enum { arity = Arity };
+
+protected:
+  Sequence c;
+  Compare comp;
+  ///
+  /// @brief Check if the container is not empty.
+  ///
+  ///
+  void requireNonEmpty() const {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+  }
+
+public:
+  ///
+  /// @brief  Default constructor, the heap is built from s in O(n).
+  ///
+  explicit priority_queue(const Compare &x = Compare(),
+                          const Sequence &s = Sequence())
+      : c(s), comp(x) {
+    heapify();
+  }
+  ///
+  /// @brief  Builds a queue from a range in O(n).
+  ///
+  template <typename InputIterator>
+  priority_queue(InputIterator first, InputIterator last,
+                 const Compare &x = Compare(), const Sequence &s = Sequence())
+      : c(s), comp(x) {
+    for (; first != last; ++first)
+      c.push_back(*first);
+    heapify();
+  }
+
+  /// Returns true if the queue is empty.
+  bool empty() const { return c.empty(); }
+  /// Returns the number of elements in the queue.
+  size_type size() const { return c.size(); }
+  ///
+  /// Returns a read-only (constant) reference to the greatest element.
+  ///
+  const_reference top() const {
+    requireNonEmpty();
+    return c[0];
+  }
+  ///
+  /// @brief  Add data to the queue, O(log n).
+  /// @param  x  Data to be added.
+  ///
+  void push(const value_type &x) {
+    c.push_back(x);
+    siftUp(c.size() - 1);
+  }
+  ///
+  /// @brief  Add a range to the queue.
+  ///
+  /// Small batches are sifted up one by one, a batch larger than the heap
+  /// already is triggers one O(n) rebuild instead.
+  ///
+  template <typename InputIterator>
+  void push_many(InputIterator first, InputIterator last) {
+    const size_type old = c.size();
+    for (; first != last; ++first)
+      c.push_back(*first);
+    if (c.size() - old > old)
+      heapify();
+    else
+      for (size_type i = old; i < c.size(); i++)
+        siftUp(i);
+  }
+  ///
+  /// @brief  Removes the greatest element, O(Arity * log n / log Arity).
+  ///
+  void pop() {
+    requireNonEmpty();
+    if (c.size() > 1) {
+      const value_type last = c.back();
+      c.pop_back();
+      siftDown(0, last);
+    } else
+      c.pop_back();
+  }
+  ///
+  /// @brief  Replace the greatest element by x: a pop followed by a push,
+  /// done with a single sift down.
+  /// @param  x  Data to be added.
+  ///
+  void pop_push(const value_type &x) {
+    requireNonEmpty();
+    siftDown(0, x);
+  }
+  ///
+  /// @brief  Rebuild the heap property over the whole container, O(n).
+  ///
+  void heapify() {
+    const size_type n = c.size();
+    if (n < 2)
+      return;
+    for (size_type i = (n - 2) / Arity + 1; i-- > 0;)
+      siftDown(i, c[i]);
+  }
+
+  void swap(priority_queue &other) {
+    ft::swap(c, other.c);
+    ft::swap(comp, other.comp);
+  }
+
+protected:
+  ///
+  /// @brief Move the element at i up to its place, the parents on the way
+  /// move down into the hole.
+  ///
+  void siftUp(size_type i) {
+    value_type val = c[i];
+    while (i > 0) {
+      const size_type parent = (i - 1) / Arity;
+      if (!comp(c[parent], val))
+        break;
+      c[i] = c[parent];
+      i = parent;
+    }
+    c[i] = val;
+  }
+  ///
+  /// @brief Put val in the hole at i and sift it down: the greatest child
+  /// moves up until val is not less than it. val is taken by copy, the
+  /// caller's argument may be an element the loop overwrites.
+  ///
+  void siftDown(size_type i, const value_type val) {
+    const size_type n = c.size();
+    for (;;) {
+      const size_type first = i * Arity + 1;
+      if (first >= n)
+        break;
+      const size_type last = first + Arity < n ? first + Arity : n;
+      size_type best = first;
+      for (size_type j = first + 1; j < last; j++)
+        if (comp(c[best], c[j]))
+          best = j;
+      if (!comp(val, c[best]))
+        break;
+      c[i] = c[best];
+      i = best;
+    }
+    c[i] = val;
+  }
+};
+
+template <typename T, typename Seq, typename Comp, std::size_t Arity>
+inline void swap(priority_queue<T, Seq, Comp, Arity> &x,
+                 priority_queue<T, Seq, Comp, Arity> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
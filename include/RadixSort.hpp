@@ -0,0 +1,355 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RadixSort.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdint.h>
+#include <utility>
+
+namespace ft {
+
+/// Unsigned integer of a given size in bytes
+template <std::size_t Bytes> struct RadixUnsigned;
+template <> struct RadixUnsigned<1> { typedef uint8_t type; };
+template <> struct RadixUnsigned<2> { typedef uint16_t type; };
+template <> struct RadixUnsigned<4> { typedef uint32_t type; };
+template <> struct RadixUnsigned<8> { typedef uint64_t type; };
+
+///
+/// @brief Maps a key to unsigned words whose order is the key's order.
+///
+///    words is the number of 64-bit words, word 0 being the least
+///    significant, bits(w) the number of bits used in word w. Keys that
+///    cannot be mapped have no words and are sorted by comparison.
+///
+template <typename T, bool Integral = ft::is_integral<T>::value,
+          bool Floating = ft::is_floating_point<T>::value>
+struct RadixKey {
+  enum { words = 0 };
+  static unsigned bits(unsigned) { return 0; }
+  static uint64_t word(const T &, unsigned) { return 0; }
+};
+
+///
+/// @brief Integers: the sign bit of signed types is flipped so negative
+/// values come first.
+///
+template <typename T> struct RadixKey<T, true, false> {
+  enum { words = 1 };
+  enum { width = sizeof(T) * CHAR_BIT };
+  static unsigned bits(unsigned) { return width; }
+  static uint64_t word(const T &x, unsigned) {
+    uint64_t u = uint64_t(typename RadixUnsigned<sizeof(T)>::type(x));
+    if (std::numeric_limits<T>::is_signed)
+      u ^= uint64_t(1) << (width - 1);
+    return u;
+  }
+};
+
+///
+/// @brief float and double: negative values have all bits flipped,
+/// positive ones only the sign bit. -0.0 sorts before 0.0, NaNs go to the
+/// end matching their sign. long double is sorted by comparison.
+///
+template <typename T> struct RadixKey<T, false, true> {
+  enum { words = sizeof(T) == 4 || sizeof(T) == 8 };
+  enum { width = sizeof(T) * CHAR_BIT };
+  static unsigned bits(unsigned) { return width; }
+  static uint64_t word(const T &x, unsigned) {
+    typename RadixUnsigned<sizeof(T)>::type u;
+    std::memcpy(&u, &x, sizeof(T));
+    uint64_t sign = uint64_t(1) << (width - 1);
+    uint64_t v = u;
+    if (v & sign)
+      return ~v & (sign | (sign - 1));
+    return v | sign;
+  }
+};
+
+///
+/// @brief Pairs sort on first then second. When second has no radix key
+/// the pair sorts on first only, equal firsts keeping their order.
+///
+template <typename A, typename B> struct RadixPairKey {
+  typedef RadixKey<A> First;
+  typedef RadixKey<B> Second;
+  enum { low = First::words ? int(Second::words) : 0 };
+  enum { words = First::words ? First::words + low : 0 };
+  static unsigned bits(unsigned w) {
+    return w < unsigned(low) ? Second::bits(w) : First::bits(w - low);
+  }
+  template <typename Pair> static uint64_t word(const Pair &p, unsigned w) {
+    return w < unsigned(low) ? Second::word(p.second, w)
+                             : First::word(p.first, w - low);
+  }
+};
+
+template <typename A, typename B>
+struct RadixKey<ft::pair<A, B>, false, false> : RadixPairKey<A, B> {};
+template <typename A, typename B>
+struct RadixKey<std::pair<A, B>, false, false> : RadixPairKey<A, B> {};
+
+///
+/// @brief Sorts on the element itself.
+///
+template <typename T> struct RadixIdentity {
+  typedef T result_type;
+  const T &operator()(const T &x) const { return x; }
+};
+
+///
+/// @brief Orders elements the way the radix passes do, for short ranges
+/// and keys without radix words.
+///
+template <typename T, typename KeyOf> struct RadixLess {
+  typedef typename KeyOf::result_type key_type;
+  typedef RadixKey<key_type> Key;
+  KeyOf keyOf;
+  RadixLess(const KeyOf &k) : keyOf(k) {}
+  bool operator()(const T &a, const T &b) const {
+    return less(keyOf(a), keyOf(b), ft::integral_constant<bool, (Key::words > 0)>());
+  }
+
+private:
+  static bool less(const key_type &a, const key_type &b, ft::true_type) {
+    for (unsigned w = Key::words; w-- > 0;) {
+      uint64_t x = Key::word(a, w);
+      uint64_t y = Key::word(b, w);
+      if (x != y)
+        return x < y;
+    }
+    return false;
+  }
+  static bool less(const key_type &a, const key_type &b, ft::false_type) {
+    return a < b;
+  }
+};
+
+///
+/// @brief One counting pass over digit [shift, shift + bits) of a word.
+///
+struct RadixPass {
+  unsigned word;
+  unsigned shift;
+  unsigned bits;
+  std::size_t offset;
+};
+
+enum {
+  /// Shorter ranges are insertion sorted
+  radix_threshold = 256,
+  /// Elements ahead whose bucket slot is prefetched while scattering
+  radix_prefetch = 8
+};
+
+///
+/// @brief Digit width for a word: 8 bits for small words, else 11 bits (a
+/// 2048 bucket histogram stays in L1) or 16 bits once the range is large
+/// enough to pay for 65536 buckets with fewer passes.
+///
+inline unsigned radixDigitBits(unsigned wordBits, std::size_t n) {
+  if (wordBits <= 8)
+    return wordBits;
+  if (wordBits <= 16)
+    return n >= (std::size_t(1) << 16) ? 16 : 8;
+  return n >= (std::size_t(1) << 22) ? 16 : 11;
+}
+
+template <typename Key, typename T, typename KeyOf>
+inline std::size_t radixDigit(const T &x, const KeyOf &keyOf,
+                              const RadixPass &p) {
+  return std::size_t(Key::word(keyOf(x), p.word) >> p.shift) &
+         ((std::size_t(1) << p.bits) - 1);
+}
+
+///
+/// @brief Stable insertion sort, for runs below radix_threshold.
+///
+template <typename T, typename Less>
+void radixInsertionSort(T *data, std::size_t n, const Less &less) {
+  for (std::size_t i = 1; i < n; ++i) {
+    if (!less(data[i], data[i - 1]))
+      continue;
+    T val = data[i];
+    std::size_t j = i;
+    for (; j > 0 && less(val, data[j - 1]); --j)
+      data[j] = data[j - 1];
+    data[j] = val;
+  }
+}
+
+///
+/// @brief Stable bottom-up merge sort for keys without radix words.
+///
+///    std::stable_sort swaps elements, which is ambiguous between
+///    std::swap and ft::swap for ft types, so runs are merged with
+///    std::merge instead.
+///
+template <typename T, typename Less, typename Alloc>
+void radixMergeSort(T *data, std::size_t n, const Less &less,
+                    const Alloc &alloc) {
+  for (std::size_t i = 0; i < n; i += radix_threshold)
+    radixInsertionSort(data + i, std::min<std::size_t>(radix_threshold, n - i),
+                       less);
+  if (n <= radix_threshold)
+    return;
+  ft::vector<T, Alloc> scratch(alloc);
+  scratch.append(data, n);
+  T *src = data;
+  T *dst = scratch.data();
+  for (std::size_t width = radix_threshold; width < n; width *= 2) {
+    for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+      std::size_t mid = std::min(lo + width, n);
+      std::size_t hi = std::min(lo + 2 * width, n);
+      std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);
+    }
+    ft::swap(src, dst);
+  }
+  if (src != data)
+    std::copy(src, src + n, data);
+}
+
+template <typename T, typename KeyOf, typename Alloc>
+void radixSortRange(T *data, std::size_t n, const KeyOf &keyOf,
+                    const Alloc &alloc, ft::false_type) {
+  radixMergeSort(data, n, RadixLess<T, KeyOf>(keyOf), alloc);
+}
+
+///
+/// @brief LSD radix sort: one read pass builds every histogram, then each
+/// pass whose digit is not the same for all keys scatters the elements
+/// between data and a scratch copy.
+///
+template <typename T, typename KeyOf, typename Alloc>
+void radixSortRange(T *data, std::size_t n, const KeyOf &keyOf,
+                    const Alloc &alloc, ft::true_type) {
+  typedef RadixKey<typename KeyOf::result_type> Key;
+  if (n < radix_threshold) {
+    radixInsertionSort(data, n, RadixLess<T, KeyOf>(keyOf));
+    return;
+  }
+  ft::vector<RadixPass> passes;
+  std::size_t buckets = 0;
+  for (unsigned w = 0; w < unsigned(Key::words); ++w) {
+    unsigned wordBits = Key::bits(w);
+    unsigned digit = radixDigitBits(wordBits, n);
+    for (unsigned shift = 0; shift < wordBits; shift += digit) {
+      RadixPass p = {w, shift, std::min(digit, wordBits - shift), buckets};
+      passes.push_back(p);
+      buckets += std::size_t(1) << p.bits;
+    }
+  }
+  ft::vector<std::size_t> count(buckets, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i + radix_prefetch * 8 < n)
+      __builtin_prefetch(data + i + radix_prefetch * 8);
+    for (std::size_t k = 0; k < passes.size(); ++k)
+      ++count[passes[k].offset + radixDigit<Key>(data[i], keyOf, passes[k])];
+  }
+
+  ft::vector<T, Alloc> scratch(alloc);
+  T *src = data;
+  T *dst = 0;
+  for (std::size_t k = 0; k < passes.size(); ++k) {
+    const RadixPass &p = passes[k];
+    std::size_t *pos = &count[p.offset];
+    // Every key has the same digit: the pass would copy in order.
+    if (pos[radixDigit<Key>(src[0], keyOf, p)] == n)
+      continue;
+    if (!dst) {
+      scratch.append(data, n);
+      dst = scratch.data();
+    }
+    std::size_t sum = 0;
+    for (std::size_t d = 0, end = std::size_t(1) << p.bits; d < end; ++d) {
+      std::size_t c = pos[d];
+      pos[d] = sum;
+      sum += c;
+    }
+    std::size_t i = 0;
+    for (; i + radix_prefetch < n; ++i) {
+      __builtin_prefetch(dst + pos[radixDigit<Key>(src[i + radix_prefetch],
+                                                   keyOf, p)],
+                         1);
+      dst[pos[radixDigit<Key>(src[i], keyOf, p)]++] = src[i];
+    }
+    for (; i < n; ++i)
+      dst[pos[radixDigit<Key>(src[i], keyOf, p)]++] = src[i];
+    ft::swap(src, dst);
+  }
+  if (src != data)
+    std::copy(src, src + n, data);
+}
+
+///
+/// @brief Stable LSD radix sort of a contiguous range.
+///
+///    Integers, float and double are sorted on their bits, pairs of those
+///    on first then second. Digits are 8, 11 or 16 bits depending on the
+///    key width and the range size. Other types fall back to a stable
+///    merge sort with operator<.
+///
+///    Needs a scratch copy of the range, use the ft::vector overload to
+///    allocate it with the vector's allocator.
+///
+template <typename RandomIt> void radix_sort(RandomIt first, RandomIt last) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type T;
+  typedef RadixIdentity<T> KeyOf;
+  std::size_t n = last - first;
+  if (n > 1)
+    radixSortRange(&*first, n, KeyOf(), std::allocator<T>(),
+                   ft::integral_constant<bool, (RadixKey<T>::words > 0)>());
+}
+///
+/// @brief Sorts records on the key keyOf returns.
+///
+/// @param keyOf Function object with a result_type typedef
+///
+template <typename RandomIt, typename KeyOf>
+void radix_sort(RandomIt first, RandomIt last, KeyOf keyOf) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type T;
+  typedef typename KeyOf::result_type K;
+  std::size_t n = last - first;
+  if (n > 1)
+    radixSortRange(&*first, n, keyOf, std::allocator<T>(),
+                   ft::integral_constant<bool, (RadixKey<K>::words > 0)>());
+}
+///
+/// @brief Sorts a whole vector, the scratch buffer comes from its
+/// allocator.
+///
+template <typename T, typename Alloc> void radix_sort(ft::vector<T, Alloc> &v) {
+  typedef RadixIdentity<T> KeyOf;
+  if (v.size() > 1)
+    radixSortRange(v.data(), v.size(), KeyOf(), v.get_allocator(),
+                   ft::integral_constant<bool, (RadixKey<T>::words > 0)>());
+}
+template <typename T, typename Alloc, typename KeyOf>
+void radix_sort(ft::vector<T, Alloc> &v, KeyOf keyOf) {
+  typedef typename KeyOf::result_type K;
+  if (v.size() > 1)
+    radixSortRange(v.data(), v.size(), keyOf, v.get_allocator(),
+                   ft::integral_constant<bool, (RadixKey<K>::words > 0)>());
+}
+
+} // namespace ft
+
+#endif
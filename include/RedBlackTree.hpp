@@ -7,7 +7,7 @@
 /*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/07/21 15:13:00 by bcosters          #+#    #+#             */
-/*   Updated: 2022/07/26 16:24:44 by bcosters         ###   ########.fr       */
+/*   Updated: 2026/10/19 20:10:00 by bcosters         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -42,159 +42,218 @@ enum RedBlackTreeColor { Red = false, Black = true };
 ///
 /// @brief Node Base class + Node operations.
 ///
+///    The links and the balancing algorithms do not depend on the value, so
+///    they also serve the intrusive containers whose hooks are plain
+///    RedBlackTreeNodeBase members of the user's objects.
 ///
-template <typename Value> struct RedBlackTreeNode {
+struct RedBlackTreeNodeBase {
 
-  typedef RedBlackTreeNode *node_ptr;
-  typedef const RedBlackTreeNode *const_node_ptr;
+  typedef RedBlackTreeNodeBase *node_ptr;
+  typedef const RedBlackTreeNodeBase *const_node_ptr;
 
-  Value value;
-  RedBlackTreeColor color;
-  node_ptr parent;
+  /// Parent pointer with the color in its low bit, nodes are at least
+  /// pointer aligned so the bit is always free.
+  std::size_t parentColor;
   node_ptr left;
   node_ptr right;
 
-  RedBlackTreeNode()
-      : value(), color(Red), parent(NULL), left(NULL), right(NULL) {}
+  RedBlackTreeNodeBase() : parentColor(Red), left(NULL), right(NULL) {}
 
-  RedBlackTreeNode& operator=(const RedBlackTreeNode& rhs) {
-    value =  rhs.value;
-    color = rhs.color;
-    parent = rhs.parent;
-    left = rhs.left;
-    right = rhs.right;
+  node_ptr parent() const {
+    return reinterpret_cast<node_ptr>(parentColor & ~std::size_t(1));
   }
-
-  Value *valPtr() { return &value; }
-  const Value *valPtr() const { return &(value); }
-
-  node_ptr minimum() { return minimum(this); }
-  static node_ptr minimum(node_ptr x) {
-    while (x->left != NULL) {
-      x = x->left;
-    }
-    return x;
+  void set_parent(node_ptr p) {
+    parentColor = reinterpret_cast<std::size_t>(p) | (parentColor & 1);
   }
-  static const_node_ptr minimum(const_node_ptr x) {
-    while (x->left != NULL) {
-      x = x->left;
-    }
-    return x;
+  RedBlackTreeColor color() const { return RedBlackTreeColor(parentColor & 1); }
+  void set_color(RedBlackTreeColor c) {
+    parentColor = (parentColor & ~std::size_t(1)) | std::size_t(c);
   }
 
+  node_ptr minimum() { return minimum(this); }
+  const_node_ptr minimum() const { return minimum(this); }
   node_ptr maximum() { return maximum(this); }
-  static node_ptr maximum(node_ptr x) {
-    while (x->right != NULL) {
-      x = x->right;
-    }
+  const_node_ptr maximum() const { return maximum(this); }
+
+  static node_ptr minimum(node_ptr x);
+  static const_node_ptr minimum(const_node_ptr x);
+  static node_ptr maximum(node_ptr x);
+  static const_node_ptr maximum(const_node_ptr x);
+
+  ///
+  /// @brief Increment over the tree.
+  ///
+  /// @param x
+  /// @return RedBlackTreeNodeBase*
+  ///
+  static node_ptr increment(node_ptr x) throw();
+  static const_node_ptr increment(const_node_ptr x) throw();
+
+  ///
+  /// @brief Decrement over the tree.
+  ///
+  /// @param x
+  /// @return RedBlackTreeNodeBase*
+  ///
+  static node_ptr decrement(node_ptr x) throw();
+  static const_node_ptr decrement(const_node_ptr x) throw();
+
+  static void rotate_left(node_ptr const x, node_ptr &root);
+  static void rotate_right(node_ptr const x, node_ptr &root);
+
+  ///
+  /// @brief Insert a value and rebalance the tree accordingly.
+  ///
+  /// @param insert_left
+  /// @param x
+  /// @param p
+  /// @param header
+  ///
+  static void insert_and_rebalance(const bool insert_left, node_ptr x,
+                                   node_ptr p,
+                                   RedBlackTreeNodeBase &header) throw();
+
+  ///
+  /// @brief Rebalance the tree to erase the node.
+  ///
+  /// @param z
+  /// @param header
+  /// @return RedBlackTreeNodeBase*
+  ///
+  static node_ptr rebalance_for_erase(node_ptr const z,
+                                      RedBlackTreeNodeBase &header) throw();
+
+  ///
+  /// @brief Cut the nodes [first, last) out of the tree and rebalance it.
+  ///
+  /// @param first
+  /// @param last
+  /// @param header
+  /// @return RedBlackTreeNodeBase* The cut nodes, as a detached binary tree
+  ///
+  static node_ptr unlink_range(node_ptr first, node_ptr last,
+                               RedBlackTreeNodeBase &header) throw();
+
+  static unsigned int black_count(const_node_ptr node,
+                                  const_node_ptr root) throw();
+};
+
+///
+/// @brief Links of RedBlackTreeNodeBase for RedBlackTreeAlgorithms.
+///
+struct RedBlackTreeNodeLinks {
+  typedef RedBlackTreeNodeBase *node_ptr;
+
+  static node_ptr parent(node_ptr x) { return x->parent(); }
+  static void set_parent(node_ptr x, node_ptr p) { x->set_parent(p); }
+  static node_ptr left(node_ptr x) { return x->left; }
+  static void set_left(node_ptr x, node_ptr l) { x->left = l; }
+  static node_ptr right(node_ptr x) { return x->right; }
+  static void set_right(node_ptr x, node_ptr r) { x->right = r; }
+  static RedBlackTreeColor color(node_ptr x) { return x->color(); }
+  static void set_color(node_ptr x, RedBlackTreeColor c) { x->set_color(c); }
+  /// Called after a rotation moved x under y, augmented nodes update there.
+  static void rotated(node_ptr, node_ptr) {}
+  /// Called after x got new children, augmented nodes update x and its
+  /// ancestors there.
+  static void relinked(node_ptr) {}
+};
+
+///
+/// @brief Red-black tree algorithms over an abstract node link layout.
+///
+///    Links names a node (node_ptr, with 0 as the null node) and reads and
+///    writes its parent, children and color. The same balancing code then
+///    runs on pointer nodes (RedBlackTreeNodeBase) and on nodes linked by
+///    32-bit indices in an arena (CompactRedBlackTree). The header is a node
+///    whose parent is the root and whose left/right are the leftmost and
+///    rightmost nodes, it is told apart by being red with a grandparent equal
+///    to itself.
+///
+/// @tparam Links
+///
+template <typename Links> struct RedBlackTreeAlgorithms : public Links {
+
+  typedef typename Links::node_ptr node_ptr;
+
+  RedBlackTreeAlgorithms() : Links() {}
+  explicit RedBlackTreeAlgorithms(const Links &links) : Links(links) {}
+
+  node_ptr minimum(node_ptr x) const {
+    while (this->left(x) != 0)
+      x = this->left(x);
     return x;
   }
-  static const_node_ptr maximum(const_node_ptr x) {
-    while (x->right != NULL) {
-      x = x->right;
-    }
+
+  node_ptr maximum(node_ptr x) const {
+    while (this->right(x) != 0)
+      x = this->right(x);
     return x;
   }
-  static node_ptr increment_helper(node_ptr x) throw() {
-    if (x->right != 0) {
-      x = x->right;
-      while (x->left != 0)
-        x = x->left;
+
+  ///
+  /// @brief In-order successor, the header follows the rightmost node.
+  ///
+  node_ptr increment(node_ptr x) const throw() {
+    if (this->right(x) != 0) {
+      x = this->right(x);
+      while (this->left(x) != 0)
+        x = this->left(x);
     } else {
-      node_ptr y = x->parent;
-      while (x == y->right) {
+      node_ptr y = this->parent(x);
+      while (x == this->right(y)) {
         x = y;
-        y = y->parent;
+        y = this->parent(y);
       }
-      if (x->right != y)
+      if (this->right(x) != y)
         x = y;
     }
     return x;
   }
 
   ///
-  /// @brief Increment over the tree.
-  ///
-  /// @param x
-  /// @return RedBlackTreeNode*
+  /// @brief In-order predecessor, the header goes back to the rightmost node.
   ///
-  node_ptr increment(node_ptr x) const throw() { return increment_helper(x); }
-  const_node_ptr increment(const_node_ptr x) const throw() {
-    return increment_helper(const_cast<node_ptr>(x));
-  }
-  node_ptr increment() const { return (increment(this)); }
-
-  static node_ptr decrement_helper(node_ptr x) throw() {
-    if (x->color == Red && x->parent->parent == x)
-      x = x->right;
-    else if (x->left != 0) {
-      node_ptr y = x->left;
-      while (y->right != 0)
-        y = y->right;
+  node_ptr decrement(node_ptr x) const throw() {
+    if (this->color(x) == Red && this->parent(this->parent(x)) == x)
+      x = this->right(x);
+    else if (this->left(x) != 0) {
+      node_ptr y = this->left(x);
+      while (this->right(y) != 0)
+        y = this->right(y);
       x = y;
     } else {
-      node_ptr y = x->parent;
-      while (x == y->left) {
+      node_ptr y = this->parent(x);
+      while (x == this->left(y)) {
         x = y;
-        y = y->parent;
+        y = this->parent(y);
       }
       x = y;
     }
     return x;
   }
 
-  ///
-  /// @brief Decrement over the tree.
-  ///
-  /// @param x
-  /// @return RedBlackTreeNode*
-  ///
-  node_ptr decrement(node_ptr x) const throw() { return decrement_helper(x); }
-  const_node_ptr decrement(const_node_ptr x) const  throw() {
-    return decrement_helper(const_cast<node_ptr>(x));
-  }
-  node_ptr decrement() const { return (decrement(this)); }
-
-  static void rotate_left_helper(node_ptr const x, node_ptr &root) {
-    node_ptr const y = x->right;
-    x->right = y->left;
-    if (y->left != 0)
-      y->left->parent = x;
-    y->parent = x->parent;
-    if (x == root)
-      root = y;
-    else if (x == x->parent->left)
-      x->parent->left = y;
-    else
-      x->parent->right = y;
-    y->left = x;
-    x->parent = y;
-  }
-
   ///
   /// @brief Rotate the tree to the left.
   ///
   /// @param x
   /// @param root
   ///
-  static void rotate_left(node_ptr const x, node_ptr &root) {
-    rotate_left_helper(x, root);
-  }
-
-  static void rotate_right_helper(node_ptr const x, node_ptr &root) {
-    node_ptr const y = x->left;
-    x->left = y->right;
-    if (y->right != 0)
-      y->right->parent = x;
-    y->parent = x->parent;
+  void rotate_left(node_ptr const x, node_ptr &root) const {
+    node_ptr const y = this->right(x);
+    this->set_right(x, this->left(y));
+    if (this->left(y) != 0)
+      this->set_parent(this->left(y), x);
+    this->set_parent(y, this->parent(x));
     if (x == root)
       root = y;
-    else if (x == x->parent->right)
-      x->parent->right = y;
+    else if (x == this->left(this->parent(x)))
+      this->set_left(this->parent(x), y);
     else
-      x->parent->left = y;
-    y->right = x;
-    x->parent = y;
+      this->set_right(this->parent(x), y);
+    this->set_left(y, x);
+    this->set_parent(x, y);
+    this->rotated(x, y);
   }
 
   ///
@@ -203,8 +262,21 @@ template <typename Value> struct RedBlackTreeNode {
   /// @param x
   /// @param root
   ///
-  static void rotate_right(node_ptr const x, node_ptr &root) {
-    rotate_right_helper(x, root);
+  void rotate_right(node_ptr const x, node_ptr &root) const {
+    node_ptr const y = this->left(x);
+    this->set_left(x, this->right(y));
+    if (this->right(y) != 0)
+      this->set_parent(this->right(y), x);
+    this->set_parent(y, this->parent(x));
+    if (x == root)
+      root = y;
+    else if (x == this->right(this->parent(x)))
+      this->set_right(this->parent(x), y);
+    else
+      this->set_left(this->parent(x), y);
+    this->set_right(y, x);
+    this->set_parent(x, y);
+    this->rotated(x, y);
   }
 
   ///
@@ -215,68 +287,35 @@ template <typename Value> struct RedBlackTreeNode {
   /// @param p
   /// @param header
   ///
-  static void insert_and_rebalance(const bool insert_left, node_ptr x, node_ptr p,
-                            RedBlackTreeNode &header) throw() {
-    node_ptr &root = header.parent;
+  void insert_and_rebalance(const bool insert_left, node_ptr x, node_ptr p,
+                            node_ptr header) const throw() {
+    // The rotations update this copy of the root, it is stored back in the
+    // header at the end.
+    node_ptr root = this->parent(header);
     // Initialize fields in new node to insert.
-    x->parent = p;
-    x->left = 0;
-    x->right = 0;
-    x->color = Red;
+    this->set_parent(x, p);
+    this->set_left(x, 0);
+    this->set_right(x, 0);
+    this->set_color(x, Red);
     // Insert.
     // Make new node child of parent and maintain root, leftmost and
     // rightmost nodes.
     // N.B. First node is always inserted left.
     if (insert_left) {
-      p->left = x; // also makes leftmost = x when p == &header
-      if (p == &header) {
-        header.parent = x;
-        header.right = x;
-      } else if (p == header.left)
-        header.left = x; // maintain leftmost pointing to min node
+      this->set_left(p, x); // also makes leftmost = x when p == header
+      if (p == header) {
+        root = x;
+        this->set_right(header, x);
+      } else if (p == this->left(header))
+        this->set_left(header, x); // maintain leftmost pointing to min node
     } else {
-      p->right = x;
-      if (p == header.right)
-        header.right = x; // maintain rightmost pointing to max node
+      this->set_right(p, x);
+      if (p == this->right(header))
+        this->set_right(header, x); // maintain rightmost pointing to max node
     }
     // Rebalance.
-    while (x != root && x->parent->color == Red) {
-      node_ptr const xpp = x->parent->parent;
-      if (x->parent == xpp->left) {
-        node_ptr const y = xpp->right;
-        if (y && y->color == Red) {
-          x->parent->color = Black;
-          y->color = Black;
-          xpp->color = Red;
-          x = xpp;
-        } else {
-          if (x == x->parent->right) {
-            x = x->parent;
-            rotate_left(x, root);
-          }
-          x->parent->color = Black;
-          xpp->color = Red;
-          rotate_right(xpp, root);
-        }
-      } else {
-        node_ptr const y = xpp->left;
-        if (y && y->color == Red) {
-          x->parent->color = Black;
-          y->color = Black;
-          xpp->color = Red;
-          x = xpp;
-        } else {
-          if (x == x->parent->left) {
-            x = x->parent;
-            rotate_right(x, root);
-          }
-          x->parent->color = Black;
-          xpp->color = Red;
-          rotate_left(xpp, root);
-        }
-      }
-    }
-    root->color = Black;
+    insertFixup(x, root);
+    this->set_parent(header, root);
   }
 
   ///
@@ -284,139 +323,180 @@ template <typename Value> struct RedBlackTreeNode {
   ///
   /// @param z
   /// @param header
-  /// @return RedBlackTreeNode*
+  /// @return node_ptr The unlinked node, z
   ///
-  static node_ptr rebalance_for_erase(node_ptr const z,
-                               RedBlackTreeNode &header) throw() {
-    node_ptr &root = header.parent;
-    node_ptr &leftmost = header.left;
-    node_ptr &rightmost = header.right;
+  node_ptr rebalance_for_erase(node_ptr const z, node_ptr header) const throw() {
+    node_ptr root = this->parent(header);
     node_ptr y = z;
     node_ptr x = 0;
     node_ptr x_parent = 0;
-    if (y->left == 0)       // z has at most one non-null child. y == z.
-      x = y->right;         // x might be null.
-    else if (y->right == 0) // z has exactly one non-null child. y == z.
-      x = y->left;          // x is not null.
+    if (this->left(y) == 0)       // z has at most one non-null child. y == z.
+      x = this->right(y);         // x might be null.
+    else if (this->right(y) == 0) // z has exactly one non-null child. y == z.
+      x = this->left(y);          // x is not null.
     else {
       // z has two non-null children.  Set y to
-      y = y->right; //   z's successor.  x might be null.
-      while (y->left != 0)
-        y = y->left;
-      x = y->right;
+      y = this->right(y); //   z's successor.  x might be null.
+      while (this->left(y) != 0)
+        y = this->left(y);
+      x = this->right(y);
     }
     if (y != z) {
       // relink y in place of z.  y is z's successor
-      z->left->parent = y;
-      y->left = z->left;
-      if (y != z->right) {
-        x_parent = y->parent;
-        if (x)
-          x->parent = y->parent;
-        y->parent->left = x; // y must be a child of left
-        y->right = z->right;
-        z->right->parent = y;
+      this->set_parent(this->left(z), y);
+      this->set_left(y, this->left(z));
+      if (y != this->right(z)) {
+        x_parent = this->parent(y);
+        if (x != 0)
+          this->set_parent(x, this->parent(y));
+        this->set_left(this->parent(y), x); // y must be a child of left
+        this->set_right(y, this->right(z));
+        this->set_parent(this->right(z), y);
       } else
         x_parent = y;
       if (root == z)
         root = y;
-      else if (z->parent->left == z)
-        z->parent->left = y;
+      else if (this->left(this->parent(z)) == z)
+        this->set_left(this->parent(z), y);
       else
-        z->parent->right = y;
-      y->parent = z->parent;
-      ft::swap(y->color, z->color);
+        this->set_right(this->parent(z), y);
+      this->set_parent(y, this->parent(z));
+      const RedBlackTreeColor yColor = this->color(y);
+      this->set_color(y, this->color(z));
+      this->set_color(z, yColor);
       y = z;
       // y now points to node to be actually deleted
     } else { // y == z
-      x_parent = y->parent;
-      if (x)
-        x->parent = y->parent;
+      x_parent = this->parent(y);
+      if (x != 0)
+        this->set_parent(x, this->parent(y));
       if (root == z)
         root = x;
-      else if (z->parent->left == z)
-        z->parent->left = x;
+      else if (this->left(this->parent(z)) == z)
+        this->set_left(this->parent(z), x);
       else
-        z->parent->right = x;
-      if (leftmost == z) {
-        if (z->right == 0) // z->left must be null also
-          leftmost = z->parent;
+        this->set_right(this->parent(z), x);
+      if (this->left(header) == z) {
+        if (this->right(z) == 0) // z->left must be null also
+          this->set_left(header, this->parent(z));
         // makes leftmost == header if z == root
         else
-          leftmost = minimum(x);
+          this->set_left(header, minimum(x));
       }
-      if (rightmost == z) {
-        if (z->left == 0) // z->right must be null also
-          rightmost = z->parent;
+      if (this->right(header) == z) {
+        if (this->left(z) == 0) // z->right must be null also
+          this->set_right(header, this->parent(z));
         // makes rightmost == header if z == root
         else // x == z->left
-          rightmost = maximum(x);
+          this->set_right(header, maximum(x));
       }
     }
-    if (y->color != Red) {
-      while (x != root && (x == 0 || x->color == Black))
-        if (x == x_parent->left) {
-          node_ptr w = x_parent->right;
-          if (w->color == Red) {
-            w->color = Black;
-            x_parent->color = Red;
-            rotate_left_helper(x_parent, root);
-            w = x_parent->right;
+    if (this->color(y) != Red) {
+      while (x != root && (x == 0 || this->color(x) == Black))
+        if (x == this->left(x_parent)) {
+          node_ptr w = this->right(x_parent);
+          if (this->color(w) == Red) {
+            this->set_color(w, Black);
+            this->set_color(x_parent, Red);
+            rotate_left(x_parent, root);
+            w = this->right(x_parent);
           }
-          if ((w->left == 0 || w->left->color == Black) &&
-              (w->right == 0 || w->right->color == Black)) {
-            w->color = Red;
+          if (isBlack(this->left(w)) && isBlack(this->right(w))) {
+            this->set_color(w, Red);
             x = x_parent;
-            x_parent = x_parent->parent;
+            x_parent = this->parent(x_parent);
           } else {
-            if (w->right == 0 || w->right->color == Black) {
-              w->left->color = Black;
-              w->color = Red;
-              rotate_right_helper(w, root);
-              w = x_parent->right;
+            if (isBlack(this->right(w))) {
+              this->set_color(this->left(w), Black);
+              this->set_color(w, Red);
+              rotate_right(w, root);
+              w = this->right(x_parent);
             }
-            w->color = x_parent->color;
-            x_parent->color = Black;
-            if (w->right)
-              w->right->color = Black;
-            rotate_left_helper(x_parent, root);
+            this->set_color(w, this->color(x_parent));
+            this->set_color(x_parent, Black);
+            if (this->right(w) != 0)
+              this->set_color(this->right(w), Black);
+            rotate_left(x_parent, root);
             break;
           }
         } else {
           // same as above, with right <-> left.
-          node_ptr w = x_parent->left;
-          if (w->color == Red) {
-            w->color = Black;
-            x_parent->color = Red;
-            rotate_right_helper(x_parent, root);
-            w = x_parent->left;
+          node_ptr w = this->left(x_parent);
+          if (this->color(w) == Red) {
+            this->set_color(w, Black);
+            this->set_color(x_parent, Red);
+            rotate_right(x_parent, root);
+            w = this->left(x_parent);
           }
-          if ((w->right == 0 || w->right->color == Black) &&
-              (w->left == 0 || w->left->color == Black)) {
-            w->color = Red;
+          if (isBlack(this->right(w)) && isBlack(this->left(w))) {
+            this->set_color(w, Red);
             x = x_parent;
-            x_parent = x_parent->parent;
+            x_parent = this->parent(x_parent);
           } else {
-            if (w->left == 0 || w->left->color == Black) {
-              w->right->color = Black;
-              w->color = Red;
-              rotate_left_helper(w, root);
-              w = x_parent->left;
+            if (isBlack(this->left(w))) {
+              this->set_color(this->right(w), Black);
+              this->set_color(w, Red);
+              rotate_left(w, root);
+              w = this->left(x_parent);
             }
-            w->color = x_parent->color;
-            x_parent->color = Black;
-            if (w->left)
-              w->left->color = Black;
-            rotate_right_helper(x_parent, root);
+            this->set_color(w, this->color(x_parent));
+            this->set_color(x_parent, Black);
+            if (this->left(w) != 0)
+              this->set_color(this->left(w), Black);
+            rotate_right(x_parent, root);
             break;
           }
         }
-      if (x)
-        x->color = Black;
+      if (x != 0)
+        this->set_color(x, Black);
     }
+    this->set_parent(header, root);
     return y;
   }
 
+  ///
+  /// @brief Cut the nodes [first, last) out of the tree.
+  ///
+  ///    The tree is split before first and before last, and the two outer
+  ///    parts are joined back under last: each split is a series of joins
+  ///    whose costs telescope along the path, so the whole takes O(log n)
+  ///    rebalancing steps whatever the length of the range.
+  ///
+  /// @param first First node of the range, not the header
+  /// @param last Node past the range, may be the header
+  /// @param header
+  /// @return node_ptr first, whose right subtree holds the other cut nodes
+  ///
+  node_ptr unlink_range(node_ptr first, node_ptr last, node_ptr header) const
+      throw() {
+    this->set_parent(this->parent(header), 0);
+    node_ptr before, after, rest;
+    unsigned int hBefore, hAfter, hRest;
+    split(first, before, hBefore, after, hAfter);
+    node_ptr root = before;
+    if (last == header)
+      rest = after;
+    else {
+      split(last, rest, hRest, after, hAfter);
+      root = join(before, hBefore, last, after, hAfter, hBefore);
+    }
+    this->set_left(first, 0);
+    this->set_right(first, rest);
+    if (rest != 0)
+      this->set_parent(rest, first);
+    this->set_parent(header, root);
+    if (root == 0) {
+      this->set_left(header, header);
+      this->set_right(header, header);
+    } else {
+      this->set_parent(root, header);
+      this->set_color(root, Black);
+      this->set_left(header, minimum(root));
+      this->set_right(header, maximum(root));
+    }
+    return first;
+  }
+
   ///
   /// @brief Count the black nodes between the node and root.
   ///
@@ -424,19 +504,276 @@ template <typename Value> struct RedBlackTreeNode {
   /// @param root
   /// @return unsigned int
   ///
-  static unsigned int black_count(const_node_ptr node, const_node_ptr root) throw() {
+  unsigned int black_count(node_ptr node, node_ptr root) const throw() {
     if (node == 0)
       return 0;
     unsigned int sum = 0;
     do {
-      if (node->color == Black)
+      if (this->color(node) == Black)
         ++sum;
       if (node == root)
         break;
-      node = node->parent;
+      node = this->parent(node);
     } while (1);
     return sum;
   }
+
+private:
+  /// Null children count as black.
+  bool isBlack(node_ptr x) const { return x == 0 || this->color(x) == Black; }
+
+  ///
+  /// @brief Restore the red rule above the red node x, then blacken root.
+  ///
+  /// @return true if that turned a red root black: the black height grew
+  ///
+  bool insertFixup(node_ptr x, node_ptr &root) const throw() {
+    while (x != root && this->color(this->parent(x)) == Red) {
+      node_ptr const xp = this->parent(x);
+      node_ptr const xpp = this->parent(xp);
+      if (xp == this->left(xpp)) {
+        node_ptr const y = this->right(xpp);
+        if (y != 0 && this->color(y) == Red) {
+          this->set_color(xp, Black);
+          this->set_color(y, Black);
+          this->set_color(xpp, Red);
+          x = xpp;
+        } else {
+          if (x == this->right(xp)) {
+            x = xp;
+            rotate_left(x, root);
+          }
+          this->set_color(this->parent(x), Black);
+          this->set_color(xpp, Red);
+          rotate_right(xpp, root);
+        }
+      } else {
+        node_ptr const y = this->left(xpp);
+        if (y != 0 && this->color(y) == Red) {
+          this->set_color(xp, Black);
+          this->set_color(y, Black);
+          this->set_color(xpp, Red);
+          x = xpp;
+        } else {
+          if (x == this->left(xp)) {
+            x = xp;
+            rotate_right(x, root);
+          }
+          this->set_color(this->parent(x), Black);
+          this->set_color(xpp, Red);
+          rotate_left(xpp, root);
+        }
+      }
+    }
+    const bool grew = this->color(root) == Red;
+    this->set_color(root, Black);
+    return grew;
+  }
+
+  /// Black nodes on a path from x down to a leaf.
+  unsigned int blackHeight(node_ptr x) const {
+    unsigned int h = 0;
+    for (; x != 0; x = this->left(x))
+      h += isBlack(x);
+    return h;
+  }
+
+  ///
+  /// @brief Join the detached trees l < k < r, of black heights hl and hr,
+  /// into one.
+  ///
+  ///    k goes where the spine of the taller tree meets the black height of
+  ///    the shorter one, then the insertion fixup repairs the red rule: the
+  ///    cost is O(|hl - hr| + 1).
+  ///
+  /// @param h Black height of the result
+  /// @return node_ptr Root of the result, black with a null parent
+  ///
+  node_ptr join(node_ptr l, unsigned int hl, node_ptr k, node_ptr r,
+                unsigned int hr, unsigned int &h) const throw() {
+    if (!isBlack(l)) {
+      this->set_color(l, Black);
+      ++hl;
+    }
+    if (!isBlack(r)) {
+      this->set_color(r, Black);
+      ++hr;
+    }
+    if (hl == hr) {
+      linkChildren(k, l, r);
+      this->set_parent(k, 0);
+      this->set_color(k, Black);
+      this->relinked(k);
+      h = hl + 1;
+      return k;
+    }
+    node_ptr root = hl > hr ? l : r;
+    node_ptr p = 0;
+    node_ptr c = root;
+    unsigned int hc = hl > hr ? hl : hr;
+    if (hl > hr) {
+      while (hc > hr || !isBlack(c)) {
+        hc -= isBlack(c);
+        p = c;
+        c = this->right(c);
+      }
+      linkChildren(k, c, r);
+      this->set_right(p, k);
+    } else {
+      while (hc > hl || !isBlack(c)) {
+        hc -= isBlack(c);
+        p = c;
+        c = this->left(c);
+      }
+      linkChildren(k, l, c);
+      this->set_left(p, k);
+    }
+    this->set_parent(k, p);
+    this->set_color(k, Red);
+    this->relinked(k);
+    h = (hl > hr ? hl : hr) + insertFixup(k, root);
+    return root;
+  }
+
+  void linkChildren(node_ptr k, node_ptr l, node_ptr r) const {
+    this->set_left(k, l);
+    this->set_right(k, r);
+    if (l != 0)
+      this->set_parent(l, k);
+    if (r != 0)
+      this->set_parent(r, k);
+  }
+
+  ///
+  /// @brief Split the tree holding n, whose root has a null parent, into
+  /// the detached trees of the nodes before n and after n.
+  ///
+  ///    Climbing from n, every ancestor is joined with its other subtree to
+  ///    the side it belongs to. Those subtrees grow in black height along
+  ///    the path, so the joins cost O(log n) together.
+  ///
+  void split(node_ptr n, node_ptr &l, unsigned int &hl, node_ptr &r,
+             unsigned int &hr) const throw() {
+    l = this->left(n);
+    r = this->right(n);
+    if (l != 0)
+      this->set_parent(l, 0);
+    if (r != 0)
+      this->set_parent(r, 0);
+    hl = hr = blackHeight(l);
+    // Black height of the original subtree of c, and so of its sibling.
+    unsigned int hc = hl + isBlack(n);
+    for (node_ptr c = n, p = this->parent(n); p != 0;) {
+      node_ptr const next = this->parent(p);
+      const bool black = isBlack(p);
+      if (c == this->left(p)) {
+        node_ptr s = this->right(p);
+        if (s != 0)
+          this->set_parent(s, 0);
+        r = join(r, hr, p, s, hc, hr);
+      } else {
+        node_ptr s = this->left(p);
+        if (s != 0)
+          this->set_parent(s, 0);
+        l = join(s, hc, p, l, hl, hl);
+      }
+      hc += black;
+      c = p;
+      p = next;
+    }
+  }
+};
+
+typedef RedBlackTreeAlgorithms<RedBlackTreeNodeLinks> RedBlackTreeNodeAlgorithms;
+
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::minimum(node_ptr x) {
+  return RedBlackTreeNodeAlgorithms().minimum(x);
+}
+inline RedBlackTreeNodeBase::const_node_ptr
+RedBlackTreeNodeBase::minimum(const_node_ptr x) {
+  return RedBlackTreeNodeAlgorithms().minimum(const_cast<node_ptr>(x));
+}
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::maximum(node_ptr x) {
+  return RedBlackTreeNodeAlgorithms().maximum(x);
+}
+inline RedBlackTreeNodeBase::const_node_ptr
+RedBlackTreeNodeBase::maximum(const_node_ptr x) {
+  return RedBlackTreeNodeAlgorithms().maximum(const_cast<node_ptr>(x));
+}
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::increment(node_ptr x) throw() {
+  return RedBlackTreeNodeAlgorithms().increment(x);
+}
+inline RedBlackTreeNodeBase::const_node_ptr
+RedBlackTreeNodeBase::increment(const_node_ptr x) throw() {
+  return RedBlackTreeNodeAlgorithms().increment(const_cast<node_ptr>(x));
+}
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::decrement(node_ptr x) throw() {
+  return RedBlackTreeNodeAlgorithms().decrement(x);
+}
+inline RedBlackTreeNodeBase::const_node_ptr
+RedBlackTreeNodeBase::decrement(const_node_ptr x) throw() {
+  return RedBlackTreeNodeAlgorithms().decrement(const_cast<node_ptr>(x));
+}
+inline void RedBlackTreeNodeBase::rotate_left(node_ptr const x,
+                                              node_ptr &root) {
+  RedBlackTreeNodeAlgorithms().rotate_left(x, root);
+}
+inline void RedBlackTreeNodeBase::rotate_right(node_ptr const x,
+                                               node_ptr &root) {
+  RedBlackTreeNodeAlgorithms().rotate_right(x, root);
+}
+inline void RedBlackTreeNodeBase::insert_and_rebalance(
+    const bool insert_left, node_ptr x, node_ptr p,
+    RedBlackTreeNodeBase &header) throw() {
+  RedBlackTreeNodeAlgorithms().insert_and_rebalance(insert_left, x, p,
+                                                    &header);
+}
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::rebalance_for_erase(node_ptr const z,
+                                          RedBlackTreeNodeBase &header) throw() {
+  return RedBlackTreeNodeAlgorithms().rebalance_for_erase(z, &header);
+}
+inline RedBlackTreeNodeBase::node_ptr
+RedBlackTreeNodeBase::unlink_range(node_ptr first, node_ptr last,
+                                   RedBlackTreeNodeBase &header) throw() {
+  return RedBlackTreeNodeAlgorithms().unlink_range(first, last, &header);
+}
+inline unsigned int RedBlackTreeNodeBase::black_count(const_node_ptr node,
+                                                      const_node_ptr root) throw() {
+  return RedBlackTreeNodeAlgorithms().black_count(const_cast<node_ptr>(node),
+                                                  const_cast<node_ptr>(root));
+}
+
+/// Aggregate type of the nodes that keep none, only declared so that asking
+/// such a tree for an aggregate does not compile.
+struct RedBlackTreeNoAggregate;
+
+///
+/// @brief Node of the owning RedBlackTree: the links plus the value.
+///
+///    A node type derived from it can augment the tree: RedBlackTree calls
+///    insert_and_rebalance, rebalance_for_erase, propagate and copy_augment
+///    through its node type, so the derived node's versions hide these.
+///
+template <typename Value> struct RedBlackTreeNode : public RedBlackTreeNodeBase {
+
+  typedef RedBlackTreeNoAggregate aggregate_type;
+
+  Value value;
+
+  RedBlackTreeNode() : RedBlackTreeNodeBase(), value() {}
+
+  Value *valPtr() { return &value; }
+  const Value *valPtr() const { return &(value); }
+
+  /// Bring the augmented data of x and its ancestors up to date.
+  static void propagate(RedBlackTreeNodeBase *, RedBlackTreeNodeBase *) {}
+  /// Take the augmented data of the node this one is a copy of.
+  void copy_augment(const RedBlackTreeNode &) {}
 };
 
 ///
@@ -457,31 +794,33 @@ template <typename KeyCompare> struct RedBlackTreeKeyCompare {
 ///
 /// @brief Helper struct for default initialization.
 ///
+///    The header only needs the links, so an empty tree never constructs a
+///    Value.
 ///
-template <typename Value> struct RedBlackTreeHeader {
-  RedBlackTreeNode<Value> header;
+struct RedBlackTreeHeader {
+  RedBlackTreeNodeBase header;
   size_t nodeCount; // Keeps track of tree size
 
   // New nodes are always Red.
   RedBlackTreeHeader() {
-    header.color = Red;
+    header.set_color(Red);
     reset();
   }
 
   void reset() {
-    header.parent = NULL;
+    header.set_parent(NULL);
     header.left = &header;
     header.right = &header;
     nodeCount = 0;
   }
 
   void move_data(RedBlackTreeHeader &other) {
-    header.color = other.header.color;
-    header.parent = other.header.parent;
+    header.parentColor = other.header.parentColor;
     header.left = other.header.left;
     header.right = other.header.right;
-    header.parent->parent = &header;
+    header.parent()->set_parent(&header);
     nodeCount = other.nodeCount;
+    other.reset();
   }
 };
 
@@ -499,27 +838,28 @@ template <typename T> struct RedBlackTree_iterator {
   typedef bidirectional_iterator_tag iterator_category;
   typedef ptrdiff_t difference_type;
   typedef RedBlackTree_iterator<T> RBT_it;
-  typedef RedBlackTreeNode<T> *node_ptr;
+  typedef RedBlackTreeNodeBase *node_ptr;
+  typedef RedBlackTreeNode<T> *link_type;
   RedBlackTree_iterator() : node() {}
   explicit RedBlackTree_iterator(node_ptr x) : node(x) {}
-  reference operator*() const { return *node->valPtr(); }
-  pointer operator->() const { return node->valPtr(); }
+  reference operator*() const { return *static_cast<link_type>(node)->valPtr(); }
+  pointer operator->() const { return static_cast<link_type>(node)->valPtr(); }
   RBT_it &operator++() {
-    node = node->increment(node);
+    node = RedBlackTreeNodeBase::increment(node);
     return *this;
   }
   RBT_it operator++(int) {
     RBT_it tmp = *this;
-    node = node->increment(node);
+    node = RedBlackTreeNodeBase::increment(node);
     return tmp;
   }
   RBT_it &operator--() {
-    node = node->decrement(node);
+    node = RedBlackTreeNodeBase::decrement(node);
     return *this;
   }
   RBT_it operator--(int) {
     RBT_it tmp = *this;
-    node = node->decrement(node);
+    node = RedBlackTreeNodeBase::decrement(node);
     return tmp;
   }
   bool operator==(const RBT_it &x) const { return node == x.node; }
@@ -540,31 +880,32 @@ template <typename T> struct RedBlackTree_const_iterator {
   typedef bidirectional_iterator_tag iterator_category;
   typedef ptrdiff_t difference_type;
   typedef RedBlackTree_const_iterator<T> RBT_It;
-  typedef const RedBlackTreeNode<T> *node_ptr;
+  typedef const RedBlackTreeNodeBase *node_ptr;
+  typedef const RedBlackTreeNode<T> *link_type;
   RedBlackTree_const_iterator() : node() {}
   explicit RedBlackTree_const_iterator(node_ptr x) : node(x) {}
   RedBlackTree_const_iterator(const iterator &it) : node(it.node) {}
   iterator iterator_const_cast() const {
     return iterator(const_cast<typename iterator::node_ptr>(node));
   }
-  reference operator*() const { return *node->valPtr(); }
-  pointer operator->() const { return node->valPtr(); }
+  reference operator*() const { return *static_cast<link_type>(node)->valPtr(); }
+  pointer operator->() const { return static_cast<link_type>(node)->valPtr(); }
   RBT_It &operator++() {
-    node = node->increment(node);
+    node = RedBlackTreeNodeBase::increment(node);
     return *this;
   }
   RBT_It operator++(int) {
     RBT_It tmp = *this;
-    node = node->increment(node);
+    node = RedBlackTreeNodeBase::increment(node);
     return tmp;
   }
   RBT_It &operator--() {
-    node = node->decrement(node);
+    node = RedBlackTreeNodeBase::decrement(node);
     return *this;
   }
   RBT_It operator--(int) {
     RBT_It tmp = *this;
-    node = node->decrement(node);
+    node = RedBlackTreeNodeBase::decrement(node);
     return tmp;
   }
   bool operator==(const RBT_It &x) const { return node == x.node; }
@@ -596,9 +937,11 @@ inline bool operator!=(const RedBlackTree_iterator<Val> &x,
 /// @tparam KeyOfValue
 /// @tparam Compare
 /// @tparam Alloc
+/// @tparam Node RedBlackTreeNode<Value> or a node type derived from it
 ///
 template <typename Key, typename Value, typename KeyOfValue, typename Compare,
-          typename Alloc = std::allocator<Value> >
+          typename Alloc = std::allocator<Value>,
+          typename Node = RedBlackTreeNode<Value> >
 class RedBlackTree {
 public:
   typedef Key key_type;
@@ -610,7 +953,8 @@ public:
   typedef size_t size_type;
   typedef ptrdiff_t difference_type;
   typedef Alloc allocator_type;
-  typedef std::allocator<RedBlackTreeNode<Value> > node_allocator_type;
+  typedef std::allocator<Node> node_allocator_type;
+  typedef typename Node::aggregate_type aggregate_type;
 
   ///
   /// @brief Get the node allocator type object
@@ -636,9 +980,13 @@ public:
   typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
 
 protected:
-  typedef RedBlackTreeNode<Value> node;
+  typedef Node node;
   typedef node *node_ptr;
+  /// Shortest range that erase cuts out at once rather than node by node.
+  enum { bulk_erase_minimum = 16 };
   typedef const node *const_node_ptr;
+  typedef RedBlackTreeNodeBase *base_ptr;
+  typedef const RedBlackTreeNodeBase *const_base_ptr;
 
   ///
   /// @brief Get the node object -> allocate a new node.
@@ -706,7 +1054,8 @@ protected:
   template <typename NodeGen>
   node_ptr clone_node(const_node_ptr x, NodeGen &node_gen) {
     node_ptr tmp = node_gen(*x->valPtr());
-    tmp->color = x->color;
+    tmp->set_color(x->color());
+    tmp->copy_augment(*x);
     tmp->left = 0;
     tmp->right = 0;
     return tmp;
@@ -721,7 +1070,7 @@ protected:
   template <typename KeyCompare>
   struct RedBlackTreeInternal : public node_allocator_type,
                                 public RedBlackTreeKeyCompare<KeyCompare>,
-                                public RedBlackTreeHeader<Value> {
+                                public RedBlackTreeHeader {
     RedBlackTreeInternal() : node_allocator_type() {}
     RedBlackTreeInternal(const RedBlackTreeInternal &other)
         : node_allocator_type(other), RedBlackTreeKeyCompare<KeyCompare>(
@@ -741,7 +1090,7 @@ private: // Functors
     ReuseOrAllocNode(RedBlackTree &t)
         : rootNode(t.root()), nodes(t.rightmost()), tree(t) {
       if (rootNode) {
-        rootNode->parent = 0;
+        rootNode->set_parent(0);
         if (nodes->left)
           nodes = nodes->left;
       } else
@@ -759,11 +1108,11 @@ private: // Functors
       return tree.create_node(arg);
     }
 
-    node_ptr extract() {
+    base_ptr extract() {
       if (!nodes)
         return nodes;
-      node_ptr node = nodes;
-      nodes = nodes->parent;
+      base_ptr node = nodes;
+      nodes = nodes->parent();
       if (nodes) {
         if (nodes->right == node) {
           nodes->right = 0;
@@ -780,8 +1129,8 @@ private: // Functors
         rootNode = 0;
       return node;
     }
-    node_ptr rootNode;
-    node_ptr nodes;
+    base_ptr rootNode;
+    base_ptr nodes;
     RedBlackTree &tree;
   };
 
@@ -805,7 +1154,7 @@ public:
       : internalData(comp, node_allocator_type(a)) {}
   RedBlackTree(const RedBlackTree &x) : internalData(x.internalData) {
     if (x.root() != 0)
-      root() = copy(x);
+      set_root(copy(x));
   }
   ~RedBlackTree() { erase_internal(begin_internal()); }
 
@@ -822,16 +1171,19 @@ public:
       internalData.reset();
       internalData.keyCompare = x.internalData.keyCompare;
       if (x.root() != 0)
-        root() = copy(x, roan);
+        set_root(copy(x, roan));
     }
     return *this;
   }
 
   // Accessors.
   Compare key_comp() const { return internalData.keyCompare; }
-  iterator begin() { return iterator(this->internalData.header.left); }
+  iterator begin() {
+    return iterator(static_cast<node_ptr>(this->internalData.header.left));
+  }
   const_iterator begin() const {
-    return const_iterator(this->internalData.header.left);
+    return const_iterator(
+        static_cast<const_node_ptr>(this->internalData.header.left));
   }
   iterator end() { return iterator(&this->internalData.header); }
   const_iterator end() const {
@@ -856,11 +1208,13 @@ public:
     } else if (t.root() == 0)
       t.internalData.move_data(internalData);
     else {
-      ft::swap(root(), t.root());
+      base_ptr tmp = root();
+      set_root(t.root());
+      t.set_root(tmp);
       ft::swap(leftmost(), t.leftmost());
       ft::swap(rightmost(), t.rightmost());
-      root()->parent = end_internal();
-      t.root()->parent = t.end_internal();
+      root()->set_parent(end_internal());
+      t.root()->set_parent(t.end_internal());
       ft::swap(this->internalData.nodeCount, t.internalData.nodeCount);
     }
     // No need to swap header's color as it does not change.
@@ -878,23 +1232,27 @@ public:
   ///
   pair<iterator, bool> insert_unique(const Value &v) {
     typedef pair<iterator, bool> Res;
-    pair<node_ptr, node_ptr> res = get_insert_unique_pos(KeyOfValue()(v));
+    pair<base_ptr, base_ptr> res = get_insert_unique_pos(KeyOfValue()(v));
     if (res.second) {
       AllocNode an(*this);
       return Res(insert_(res.first, res.second, v, an), true);
     }
-    return Res(iterator(res.first), false);
+    return Res(iterator(static_cast<node_ptr>(res.first)), false);
   }
 
   ///
-  /// @brief Finds the equal key to insert the new node in.
+  /// @brief Insert after the equal keys, a key not less than the rightmost
+  /// one is appended without descending the tree.
   ///
   /// @param v
   /// @return iterator
   ///
   iterator insert_equal(const Value &v) {
-    pair<node_ptr, node_ptr> res = get_insert_equal_pos(KeyOfValue()(v));
     AllocNode an(*this);
+    if (size() > 0 &&
+        !internalData.keyCompare(KeyOfValue()(v), key(rightmost())))
+      return insert_(0, rightmost(), v, an);
+    pair<base_ptr, base_ptr> res = get_insert_equal_pos(KeyOfValue()(v));
     return insert_(res.first, res.second, v, an);
   }
 
@@ -915,6 +1273,11 @@ public:
       insert_equal_(end(), *first, an);
   }
 
+  iterator insert_equal(const_iterator pos, const value_type &x) {
+    AllocNode an(*this);
+    return insert_equal_(pos, x, an);
+  }
+
   ///
   /// @brief Erase the position from the tree.
   ///
@@ -1018,7 +1381,7 @@ public:
   ///
   pair<iterator, iterator> equal_range(const Key &k) {
     node_ptr x = begin_internal();
-    node_ptr y = end_internal();
+    base_ptr y = end_internal();
     while (x != 0) {
       if (internalData.keyCompare(key(x), k))
         x = right(x);
@@ -1026,7 +1389,7 @@ public:
         y = x, x = left(x);
       else {
         node_ptr xu(x);
-        node_ptr yu(y);
+        base_ptr yu(y);
         y = x, x = left(x);
         xu = right(xu);
         return pair<iterator, iterator>(lower_bound_internal(x, y, k),
@@ -1037,8 +1400,8 @@ public:
   }
 
   pair<const_iterator, const_iterator> equal_range(const Key &k) const {
-    const_node_ptr x = begin();
-    const_node_ptr y = end();
+    const_node_ptr x = begin_internal();
+    const_base_ptr y = end_internal();
     while (x != 0) {
       if (internalData.keyCompare(key(x), k))
         x = right(x);
@@ -1046,11 +1409,11 @@ public:
         y = x, x = left(x);
       else {
         const_node_ptr xu(x);
-        const_node_ptr yu(y);
+        const_base_ptr yu(y);
         y = x, x = left(x);
         xu = right(xu);
-        return pair<const_iterator, const_iterator>(lower_bound(x, y, k),
-                                                    upper_bound(xu, yu, k));
+        return pair<const_iterator, const_iterator>(
+            lower_bound_internal(x, y, k), upper_bound_internal(xu, yu, k));
       }
     }
     return pair<const_iterator, const_iterator>(const_iterator(y),
@@ -1071,35 +1434,70 @@ public:
     return upper_bound_internal(begin_internal(), end_internal(), k);
   }
 
+  ///
+  /// @brief Aggregate of the values whose key is in [lo, hi), only for node
+  /// types that keep one per subtree.
+  ///
+  /// @param lo
+  /// @param hi
+  /// @return aggregate_type
+  ///
+  aggregate_type aggregate(const key_type &lo, const key_type &hi) const {
+    return node::template aggregate<KeyOfValue>(begin_internal(), lo, hi,
+                                                internalData.keyCompare);
+  }
+
+  ///
+  /// @brief The value at position was changed in place, update what the
+  /// node type derives from it.
+  ///
+  /// @param position
+  ///
+  void refresh(const_iterator position) {
+    node::propagate(const_cast<base_ptr>(position.node), end_internal());
+  }
+
 protected:
-  node_ptr &root() { return internalData.header.parent; }
-  const_node_ptr root() const { return internalData.header.parent; }
-  node_ptr &leftmost() { return internalData.header.left; }
-  const_node_ptr leftmost() const { return internalData.header.left; }
-  node_ptr &rightmost() { return internalData.header.right; }
-  const_node_ptr rightmost() const { return internalData.header.right; }
+  base_ptr root() { return internalData.header.parent(); }
+  const_base_ptr root() const { return internalData.header.parent(); }
+  void set_root(base_ptr x) { internalData.header.set_parent(x); }
+  base_ptr &leftmost() { return internalData.header.left; }
+  const_base_ptr leftmost() const { return internalData.header.left; }
+  base_ptr &rightmost() { return internalData.header.right; }
+  const_base_ptr rightmost() const { return internalData.header.right; }
   node_ptr begin_internal() {
-    return static_cast<node_ptr>(internalData.header.parent);
+    return static_cast<node_ptr>(internalData.header.parent());
   }
   const_node_ptr begin_internal() const {
-    return static_cast<const_node_ptr>(internalData.header.parent);
+    return static_cast<const_node_ptr>(internalData.header.parent());
   }
-  node_ptr end_internal() { return &internalData.header; }
-  const_node_ptr end_internal() const { return &internalData.header; }
+  base_ptr end_internal() { return &internalData.header; }
+  const_base_ptr end_internal() const { return &internalData.header; }
   static const_reference value(const_node_ptr x) { return *x->valPtr(); }
   static const Key &key(const_node_ptr x) { return KeyOfValue()(value(x)); }
-  static node_ptr left(node_ptr x) { return static_cast<node_ptr>(x->left); }
-  static const_node_ptr left(const_node_ptr x) {
+  static const Key &key(const_base_ptr x) {
+    return key(static_cast<const_node_ptr>(x));
+  }
+  static node_ptr left(base_ptr x) { return static_cast<node_ptr>(x->left); }
+  static const_node_ptr left(const_base_ptr x) {
     return static_cast<const_node_ptr>(x->left);
   }
-  static node_ptr right(node_ptr x) { return static_cast<node_ptr>(x->right); }
-  static const_node_ptr right(const_node_ptr x) {
+  static node_ptr right(base_ptr x) { return static_cast<node_ptr>(x->right); }
+  static const_node_ptr right(const_base_ptr x) {
     return static_cast<const_node_ptr>(x->right);
   }
-  static node_ptr minimum(node_ptr x) { return x->minimum(); }
-  static const_node_ptr minimum(const_node_ptr x) { return x->minimum(); }
-  static node_ptr maximum(node_ptr x) { return x->maximum(); }
-  static const_node_ptr maximum(const_node_ptr x) { return x->maximum(); }
+  static node_ptr minimum(node_ptr x) {
+    return static_cast<node_ptr>(x->minimum());
+  }
+  static const_node_ptr minimum(const_node_ptr x) {
+    return static_cast<const_node_ptr>(x->minimum());
+  }
+  static node_ptr maximum(node_ptr x) {
+    return static_cast<node_ptr>(x->maximum());
+  }
+  static const_node_ptr maximum(const_node_ptr x) {
+    return static_cast<const_node_ptr>(x->maximum());
+  }
 
   ///
   /// @brief Insert the value with a node generator.
@@ -1112,7 +1510,7 @@ protected:
   /// @return iterator
   ///
   template <typename NodeGen>
-  iterator insert_(node_ptr x, node_ptr p, const Value &v, NodeGen &node_gen) {
+  iterator insert_(base_ptr x, base_ptr p, const Value &v, NodeGen &node_gen) {
     bool insert_left = (x != 0 || p == end_internal() ||
                         internalData.keyCompare(KeyOfValue()(v), key(p)));
     node_ptr z = node_gen(v);
@@ -1128,9 +1526,9 @@ protected:
   /// @param v
   /// @return iterator
   ///
-  iterator insert_lower(node_ptr p, const Value &v) {
-    bool insert_left =
-        (p == end() || !internalData.keyCompare(key(p), KeyOfValue()(v)));
+  iterator insert_lower(base_ptr p, const Value &v) {
+    bool insert_left = (p == end_internal() ||
+                        !internalData.keyCompare(key(p), KeyOfValue()(v)));
     node_ptr z = create_node(v);
     node::insert_and_rebalance(insert_left, z, p, this->internalData.header);
     ++internalData.nodeCount;
@@ -1144,8 +1542,8 @@ protected:
   /// @return iterator
   ///
   iterator insert_equal_lower(const Value &v) {
-    node_ptr x = begin();
-    node_ptr y = end();
+    node_ptr x = begin_internal();
+    base_ptr y = end_internal();
     while (x != 0) {
       y = x;
       x = !internalData.keyCompare(key(x), KeyOfValue()(v)) ? left(x)
@@ -1175,10 +1573,10 @@ protected:
     return copy(x, an);
   }
   template <typename NodeGen>
-  node_ptr copy(const_node_ptr x, node_ptr p, NodeGen &node_gen) {
+  node_ptr copy(const_node_ptr x, base_ptr p, NodeGen &node_gen) {
     // Structural copy. x and p must be non-null.
     node_ptr top = clone_node(x, node_gen);
-    top->parent = p;
+    top->set_parent(p);
     try {
       if (x->right)
         top->right = copy(right(x), top, node_gen);
@@ -1187,7 +1585,7 @@ protected:
       while (x != 0) {
         node_ptr y = clone_node(x, node_gen);
         p->left = y;
-        y->parent = p;
+        y->set_parent(p);
         if (x->right)
           y->right = copy(right(x), y, node_gen);
         p = y;
@@ -1204,15 +1602,19 @@ protected:
   /// @brief Erase all nodes from this one down without rebalancing the tree.
   ///
   /// @param x
+  /// @return size_type The number of nodes erased
   ///
-  void erase_internal(node_ptr x) {
+  size_type erase_internal(node_ptr x) {
     // Erase without rebalancing.
+    size_type n = 0;
     while (x != 0) {
-      erase_internal(right(x));
+      n += erase_internal(right(x));
       node_ptr y = left(x);
       drop_node(x);
       x = y;
+      ++n;
     }
+    return n;
   }
 
   ///
@@ -1224,7 +1626,7 @@ protected:
   /// @param k
   /// @return iterator
   ///
-  iterator lower_bound_internal(node_ptr x, node_ptr y, const Key &k) {
+  iterator lower_bound_internal(node_ptr x, base_ptr y, const Key &k) {
     while (x != 0)
       if (!internalData.keyCompare(key(x), k))
         y = x, x = left(x);
@@ -1232,7 +1634,7 @@ protected:
         x = right(x);
     return iterator(y);
   }
-  const_iterator lower_bound_internal(const_node_ptr x, const_node_ptr y,
+  const_iterator lower_bound_internal(const_node_ptr x, const_base_ptr y,
                               const Key &k) const {
     while (x != 0)
       if (!internalData.keyCompare(key(x), k))
@@ -1251,7 +1653,7 @@ protected:
   /// @param k
   /// @return iterator
   ///
-  iterator upper_bound_internal(node_ptr x, node_ptr y, const Key &k) {
+  iterator upper_bound_internal(node_ptr x, base_ptr y, const Key &k) {
     while (x != 0)
       if (internalData.keyCompare(k, key(x)))
         y = x, x = left(x);
@@ -1259,7 +1661,7 @@ protected:
         x = right(x);
     return iterator(y);
   }
-  const_iterator upper_bound_internal(const_node_ptr x, const_node_ptr y,
+  const_iterator upper_bound_internal(const_node_ptr x, const_base_ptr y,
                               const Key &k) const {
     while (x != 0)
       if (internalData.keyCompare(k, key(x)))
@@ -1273,12 +1675,12 @@ protected:
   /// @brief Get the unique position to insert the new node.
   ///
   /// @param k
-  /// @return pair<node_ptr, node_ptr>
+  /// @return pair<base_ptr, base_ptr>
   ///
-  pair<node_ptr, node_ptr> get_insert_unique_pos(const key_type &k) {
-    typedef pair<node_ptr, node_ptr> Res;
+  pair<base_ptr, base_ptr> get_insert_unique_pos(const key_type &k) {
+    typedef pair<base_ptr, base_ptr> Res;
     node_ptr x = begin_internal();
-    node_ptr y = end_internal();
+    base_ptr y = end_internal();
     bool comp = true;
     while (x != 0) {
       y = x;
@@ -1302,12 +1704,12 @@ protected:
   /// @brief Get the equal postion to insert the new node.
   ///
   /// @param k
-  /// @return pair<node_ptr, node_ptr>
+  /// @return pair<base_ptr, base_ptr>
   ///
-  pair<node_ptr, node_ptr> get_insert_equal_pos(const key_type &k) {
-    typedef pair<node_ptr, node_ptr> Res;
-    node_ptr x = begin();
-    node_ptr y = end();
+  pair<base_ptr, base_ptr> get_insert_equal_pos(const key_type &k) {
+    typedef pair<base_ptr, base_ptr> Res;
+    node_ptr x = begin_internal();
+    base_ptr y = end_internal();
     while (x != 0) {
       y = x;
       x = internalData.keyCompare(k, key(x)) ? left(x) : right(x);
@@ -1315,10 +1717,10 @@ protected:
     return Res(x, y);
   }
 
-  pair<node_ptr, node_ptr> get_insert_hint_unique_pos(const_iterator position,
+  pair<base_ptr, base_ptr> get_insert_hint_unique_pos(const_iterator position,
                                                       const key_type &k) {
     iterator pos = position.iterator_const_cast();
-    typedef pair<node_ptr, node_ptr> Res;
+    typedef pair<base_ptr, base_ptr> Res;
     // end()
     if (pos.node == end_internal()) {
       if (size() > 0 && internalData.keyCompare(key(rightmost()), k))
@@ -1357,19 +1759,19 @@ protected:
   template <typename NodeGen>
   iterator insert_unique(const_iterator position, const Value &v,
                           NodeGen &node_gen) {
-    pair<node_ptr, node_ptr> res =
+    pair<base_ptr, base_ptr> res =
         get_insert_hint_unique_pos(position, KeyOfValue()(v));
     if (res.second)
       return insert_(res.first, res.second, v, node_gen);
-    return iterator(res.first);
+    return iterator(static_cast<node_ptr>(res.first));
   }
 
-  pair<node_ptr, node_ptr> get_insert_hint_equal_pos(const_iterator position,
+  pair<base_ptr, base_ptr> get_insert_hint_equal_pos(const_iterator position,
                                                      const key_type &k) {
     iterator pos = position.iterator_const_cast();
-    typedef pair<node_ptr, node_ptr> Res;
+    typedef pair<base_ptr, base_ptr> Res;
     // end()
-    if (pos.node == end()) {
+    if (pos.node == end_internal()) {
       if (size() > 0 && !internalData.keyCompare(k, key(rightmost())))
         return Res(0, rightmost());
       else
@@ -1405,7 +1807,7 @@ protected:
   iterator insert_equal_(const_iterator position,
 
                          const Value &v, NodeGen &node_gen) {
-    pair<node_ptr, node_ptr> res =
+    pair<base_ptr, base_ptr> res =
         get_insert_hint_equal_pos(position, KeyOfValue()(v));
     if (res.second)
       return insert_(res.first, res.second, v, node_gen);
@@ -1419,7 +1821,7 @@ protected:
   ///
   void erase_internal_helper(const_iterator position) {
     node_ptr y = static_cast<node_ptr>(node::rebalance_for_erase(
-        const_cast<node_ptr>(position.node), this->internalData.header));
+        const_cast<base_ptr>(position.node), this->internalData.header));
     drop_node(y);
     --internalData.nodeCount;
   }
@@ -1427,15 +1829,30 @@ protected:
   ///
   /// @brief Erase a range.
   ///
+  ///    A short range is erased node by node. A longer one is unlinked with
+  ///    O(log n) rebalancing steps and freed without any: O(log n + k).
+  ///
   /// @param first
   /// @param last
   ///
   void erase_internal_helper(const_iterator first, const_iterator last) {
-    if (first == begin() && last == end())
+    if (first == begin() && last == end()) {
       clear();
-    else
+      return;
+    }
+    const_iterator it = first;
+    for (size_type n = 0; it != last && n < bulk_erase_minimum; ++n)
+      ++it;
+    if (it == last) {
       while (first != last)
         erase_internal_helper(first++);
+      return;
+    }
+    // Cut the range out with one rebalancing, then free it in bulk.
+    base_ptr cut = node::unlink_range(const_cast<base_ptr>(first.node),
+                                      const_cast<base_ptr>(last.node),
+                                      internalData.header);
+    internalData.nodeCount -= erase_internal(static_cast<node_ptr>(cut));
   }
 
   ///
@@ -1447,16 +1864,16 @@ protected:
   bool rb_verify() const {
     if (internalData.nodeCount == 0 || begin() == end())
       return internalData.nodeCount == 0 && begin() == end() &&
-             this->internalData.header.left == end() &&
-             this->internalData.header.right == end();
+             this->internalData.header.left == end_internal() &&
+             this->internalData.header.right == end_internal();
     unsigned int len = node::black_count(leftmost(), root());
     for (const_iterator it = begin(); it != end(); ++it) {
       const_node_ptr x = static_cast<const_node_ptr>(it.node);
       const_node_ptr L = left(x);
       const_node_ptr R = right(x);
       // Check if the children of a red node are black.
-      if (x->color == Red)
-        if ((L && L->color == Red) || (R && R->color == Red))
+      if (x->color() == Red)
+        if ((L && L->color() == Red) || (R && R->color() == Red))
           return false;
       // Check that Left and Right have different values.
       if (L && internalData.keyCompare(key(x), key(L)))
@@ -1478,54 +1895,66 @@ protected:
 };
 
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator==(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator==(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator<(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-          const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator<(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+          const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator!=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator!=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return !(x == y);
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator>(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-          const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator>(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+          const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return y < x;
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator<=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator<=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return !(y < x);
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
+          typename Alloc, typename Node>
 inline bool
-operator>=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+operator>=(const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+           const RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   return !(x < y);
 }
 template <typename Key, typename Val, typename KeyOfValue, typename Compare,
-          typename Alloc>
-inline void swap(RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &x,
-                 RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc> &y) {
+          typename Alloc, typename Node>
+inline void swap(RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &x,
+                 RedBlackTree<Key, Val, KeyOfValue, Compare, Alloc, Node> &y) {
   x.swap(y);
 }
 
+///
+/// @brief Node policy of ft::map and ft::set: one allocation per node,
+/// linked by pointers (the default).
+///
+struct pointer_nodes {
+  template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+            typename Alloc>
+  struct tree {
+    typedef RedBlackTree<Key, Value, KeyOfValue, Compare, Alloc> type;
+  };
+};
+
 } // namespace ft
 
 #endif
@@ -6,7 +6,7 @@
 /*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/07/28 17:00:26 by bcosters          #+#    #+#             */
-/*   Updated: 2022/07/29 10:32:41 by bcosters         ###   ########.fr       */
+/*   Updated: 2026/10/19 19:40:00 by bcosters         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,6 +14,8 @@
 #define SET_HPP
 
 #include "Iterators.hpp"
+#include "CompactRedBlackTree.hpp"
+#include "DeferredRedBlackTree.hpp"
 #include "RedBlackTree.hpp"
 #include "utility.hpp"
 #include <algorithm>
@@ -29,7 +31,8 @@
 
 namespace ft {
 template <typename Key, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<Key> >
+          typename Alloc = std::allocator<Key>,
+          typename Nodes = ft::pointer_nodes>
 class set {
 public:
   typedef Key key_type;
@@ -39,8 +42,9 @@ public:
   typedef Alloc allocator_type;
 
 private:
-  typedef RedBlackTree<key_type, value_type, std::_Identity<value_type>,
-                       key_compare, Alloc>
+  typedef typename Nodes::template tree<key_type, value_type,
+                                        std::_Identity<value_type>,
+                                        key_compare, Alloc>::type
       tree_type;
   tree_type tree; // Red-black tree representing set.
 public:
@@ -262,6 +266,16 @@ public:
   /// the user's responsibility.
   ///
   void clear() { tree.clear(); }
+  ///
+  /// @brief Hands the nodes dropped by clear(), assignment and destruction
+  /// to a reclaimer.
+  /// @param  r  The reclaimer, 0 to free the nodes at once again.
+  ///
+  /// The set is then emptied in constant time and @a r frees the nodes later,
+  /// a bounded amount per r.collect() call or on its own thread.  Only sets
+  /// with the ft::deferred_nodes node policy provide it.
+  ///
+  void set_reclaimer(tree_reclaimer *r) { tree.set_reclaimer(r); }
   // set operations:
 
   ///
@@ -340,10 +354,12 @@ public:
     return tree.equal_range(x);
   }
 
-  template <typename K1, typename C1, typename A1>
-  friend bool operator==(const set<K1, C1, A1> &, const set<K1, C1, A1> &);
-  template <typename K1, typename C1, typename A1>
-  friend bool operator<(const set<K1, C1, A1> &, const set<K1, C1, A1> &);
+  template <typename K1, typename C1, typename A1, typename N1>
+  friend bool operator==(const set<K1, C1, A1, N1> &,
+                         const set<K1, C1, A1, N1> &);
+  template <typename K1, typename C1, typename A1, typename N1>
+  friend bool operator<(const set<K1, C1, A1, N1> &,
+                        const set<K1, C1, A1, N1> &);
 };
 ///
 /// @brief  Set equality comparison.
@@ -355,9 +371,9 @@ public:
 /// Sets are considered equivalent if their sizes are equal, and if
 /// corresponding elements compare equal.
 ///
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator==(const set<Key, Compare, Alloc> &x,
-                       const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator==(const set<Key, Compare, Alloc, Nodes> &x,
+                       const set<Key, Compare, Alloc, Nodes> &y) {
   return x.tree == y.tree;
 }
 ///
@@ -371,38 +387,39 @@ inline bool operator==(const set<Key, Compare, Alloc> &x,
 ///
 /// See std::lexicographicalcompare() for how the determination is made.
 ///
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator<(const set<Key, Compare, Alloc> &x,
-                      const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator<(const set<Key, Compare, Alloc, Nodes> &x,
+                      const set<Key, Compare, Alloc, Nodes> &y) {
   return x.tree < y.tree;
 }
 ///  Returns !(x == y).
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator!=(const set<Key, Compare, Alloc> &x,
-                       const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator!=(const set<Key, Compare, Alloc, Nodes> &x,
+                       const set<Key, Compare, Alloc, Nodes> &y) {
   return !(x == y);
 }
 ///  Returns y < x.
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator>(const set<Key, Compare, Alloc> &x,
-                      const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator>(const set<Key, Compare, Alloc, Nodes> &x,
+                      const set<Key, Compare, Alloc, Nodes> &y) {
   return y < x;
 }
 ///  Returns !(y < x)
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator<=(const set<Key, Compare, Alloc> &x,
-                       const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator<=(const set<Key, Compare, Alloc, Nodes> &x,
+                       const set<Key, Compare, Alloc, Nodes> &y) {
   return !(y < x);
 }
 ///  Returns !(x < y)
-template <typename Key, typename Compare, typename Alloc>
-inline bool operator>=(const set<Key, Compare, Alloc> &x,
-                       const set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline bool operator>=(const set<Key, Compare, Alloc, Nodes> &x,
+                       const set<Key, Compare, Alloc, Nodes> &y) {
   return !(x < y);
 }
 /// See std::set::swap().
-template <typename Key, typename Compare, typename Alloc>
-inline void swap(set<Key, Compare, Alloc> &x, set<Key, Compare, Alloc> &y) {
+template <typename Key, typename Compare, typename Alloc, typename Nodes>
+inline void swap(set<Key, Compare, Alloc, Nodes> &x,
+                 set<Key, Compare, Alloc, Nodes> &y) {
   x.swap(y);
 }
 
@@ -0,0 +1,617 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SoaVector.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SOAVECTOR_HPP
+#define SOAVECTOR_HPP
+
+#include "Iterators.hpp"
+#include "Vector.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+///
+/// @brief A structure-of-arrays vector stores every field of its rows in a
+/// separate contiguous array (a column).
+///
+///    soa_vector<float, float, int> holds three arrays instead of one array
+///    of { float, float, int } structs, so a loop over one field only pulls
+///    that field through the cache and compiles to a plain vectorizable loop
+///    over a T *.
+///
+///    All the columns share one size and one capacity, they grow together
+///    following the vectorBase growth policy.
+///
+///    C++98 has no variadic templates: a row has up to 6 fields, the unused
+///    trailing ones are ft::soa_null.
+///
+
+namespace ft {
+
+///
+/// @brief Placeholder for the unused fields of a soa_vector.
+///
+struct soa_null {};
+
+///
+/// @brief Pointer + length view over one column.
+///
+/// @tparam T
+///
+template <typename T> struct soa_span {
+  typedef T value_type;
+  typedef T *iterator;
+  typedef T &reference;
+  typedef std::size_t size_type;
+
+  soa_span() : ptr(NULL), len(0) {}
+  soa_span(T *p, size_type n) : ptr(p), len(n) {}
+
+  T *data() const { return ptr; }
+  T *begin() const { return ptr; }
+  T *end() const { return ptr + len; }
+  size_type size() const { return len; }
+  bool empty() const { return len == 0; }
+  reference operator[](size_type i) const { return ptr[i]; }
+
+private:
+  T *ptr;
+  size_type len;
+};
+
+///
+/// @brief Type of the field at index I of a SoaColumns / SoaValues chain, and
+/// the link of the chain that holds it.
+///
+template <std::size_t I, typename Chain> struct SoaAt;
+template <template <typename, typename> class Cons, typename T, typename Next>
+struct SoaAt<0, Cons<T, Next> > {
+  typedef T type;
+  typedef Cons<T, Next> holder;
+};
+template <std::size_t I, template <typename, typename> class Cons,
+          typename T, typename Next>
+struct SoaAt<I, Cons<T, Next> > : public SoaAt<I - 1, Next> {};
+
+///
+/// @brief One row of a soa_vector by value: a chain of fields.
+///
+template <typename T, typename Next> struct SoaValues : public Next {
+  typedef Next next_type;
+
+  SoaValues() : Next(), value() {}
+  template <typename A2, typename A3, typename A4, typename A5, typename A6>
+  SoaValues(const T &a, const A2 &b, const A3 &c, const A4 &d, const A5 &e,
+            const A6 &f)
+      : Next(b, c, d, e, f, soa_null()), value(a) {}
+
+  T value;
+};
+
+/// End of a row.
+template <typename Next> struct SoaValues<soa_null, Next> {
+  SoaValues() {}
+  template <typename A1, typename A2, typename A3, typename A4, typename A5,
+            typename A6>
+  SoaValues(const A1 &, const A2 &, const A3 &, const A4 &, const A5 &,
+            const A6 &) {}
+};
+
+///
+/// @brief The columns of a soa_vector: a chain of raw arrays.
+///
+/// The chain does not know its size or capacity, the soa_vector passes them
+/// to every operation. Copying a SoaColumns only copies the pointers.
+///
+template <typename T, typename Next> struct SoaColumns : public Next {
+  typedef T value_type;
+  typedef Next next_type;
+  typedef std::allocator<T> allocator_type;
+  typedef SoaValues<T, typename Next::values_type> values_type;
+
+  SoaColumns() : Next(), data(NULL) {}
+
+  static std::size_t max_size() {
+    const std::size_t n = allocator_type().max_size();
+    const std::size_t m = Next::max_size();
+    return n < m ? n : m;
+  }
+
+  ///
+  /// @brief Allocate n slots in every column, all or nothing.
+  ///
+  void allocate(std::size_t n) {
+    data = n ? allocator_type().allocate(n) : NULL;
+    try {
+      Next::allocate(n);
+    } catch (...) {
+      deallocateColumn(n);
+      __throw_exception_again;
+    }
+  }
+
+  void deallocate(std::size_t n) {
+    deallocateColumn(n);
+    Next::deallocate(n);
+  }
+
+  ///
+  /// @brief Construct rows [dst, dst + n) as copies of src's rows
+  /// [from, from + n). Nothing is left constructed if a copy throws.
+  ///
+  void copy_construct(std::size_t dst, const SoaColumns &src, std::size_t from,
+                      std::size_t n) {
+    std::uninitialized_copy(src.data + from, src.data + from + n, data + dst);
+    try {
+      Next::copy_construct(dst, src, from, n);
+    } catch (...) {
+      destroyColumn(dst, dst + n);
+      __throw_exception_again;
+    }
+  }
+
+  ///
+  /// @brief Construct rows [dst, dst + n) as copies of the row val.
+  ///
+  void fill_construct(std::size_t dst, std::size_t n, const values_type &val) {
+    std::uninitialized_fill_n(data + dst, n, val.value);
+    try {
+      Next::fill_construct(dst, n, val);
+    } catch (...) {
+      destroyColumn(dst, dst + n);
+      __throw_exception_again;
+    }
+  }
+
+  void destroy(std::size_t first, std::size_t last) {
+    destroyColumn(first, last);
+    Next::destroy(first, last);
+  }
+
+  /// Copy row i into val.
+  void load(std::size_t i, values_type &val) const {
+    val.value = data[i];
+    Next::load(i, val);
+  }
+
+  /// Assign val to row i.
+  void store(std::size_t i, const values_type &val) {
+    data[i] = val.value;
+    Next::store(i, val);
+  }
+
+  /// Shift rows [first + 1, last) one slot down, row last - 1 is left as is.
+  void shift_down(std::size_t first, std::size_t last) {
+    std::copy(data + first + 1, data + last, data + first);
+    Next::shift_down(first, last);
+  }
+
+  T *data;
+
+private:
+  void deallocateColumn(std::size_t n) {
+    if (data)
+      allocator_type().deallocate(data, n);
+    data = NULL;
+  }
+
+  void destroyColumn(std::size_t first, std::size_t last) {
+    allocator_type alloc;
+    for (; first != last; ++first)
+      alloc.destroy(data + first);
+  }
+};
+
+/// End of the columns.
+template <typename Next> struct SoaColumns<soa_null, Next> {
+  typedef SoaValues<soa_null, soa_null> values_type;
+
+  static std::size_t max_size() { return std::size_t(-1); }
+  void allocate(std::size_t) {}
+  void deallocate(std::size_t) {}
+  void copy_construct(std::size_t, const SoaColumns &, std::size_t,
+                      std::size_t) {}
+  void fill_construct(std::size_t, std::size_t, const values_type &) {}
+  void destroy(std::size_t, std::size_t) {}
+  void load(std::size_t, values_type &) const {}
+  void store(std::size_t, const values_type &) {}
+  void shift_down(std::size_t, std::size_t) {}
+};
+
+///
+/// @brief Proxy reference to one row of a soa_vector.
+///
+/// Fields are reached with ft::get<I>(ref). The proxy converts to the row by
+/// value and assigning a row to it writes every column.
+///
+/// @tparam Columns
+/// @tparam Const
+///
+template <typename Columns, bool Const> struct SoaReference {
+  typedef typename conditional<Const, const Columns, Columns>::type
+      columns_type;
+  typedef typename Columns::values_type value_type;
+
+  SoaReference(columns_type *c, std::size_t i) : cols(c), index(i) {}
+  SoaReference(const SoaReference &other)
+      : cols(other.cols), index(other.index) {}
+
+  operator value_type() const {
+    value_type val;
+    cols->load(index, val);
+    return val;
+  }
+  const SoaReference &operator=(const value_type &val) const {
+    cols->store(index, val);
+    return *this;
+  }
+  const SoaReference &operator=(const SoaReference &rhs) const {
+    return *this = value_type(rhs);
+  }
+
+  columns_type *cols;
+  std::size_t index;
+};
+
+///
+/// @brief Access field I of a row proxy.
+///
+template <std::size_t I, typename Columns, bool Const>
+typename conditional<Const, const typename SoaAt<I, Columns>::type &,
+                     typename SoaAt<I, Columns>::type &>::type
+get(const SoaReference<Columns, Const> &ref) {
+  return static_cast<const typename SoaAt<I, Columns>::holder &>(*ref.cols)
+      .data[ref.index];
+}
+
+///
+/// @brief Access field I of a row by value.
+///
+template <std::size_t I, typename T, typename Next>
+typename SoaAt<I, SoaValues<T, Next> >::type &get(SoaValues<T, Next> &val) {
+  return static_cast<typename SoaAt<I, SoaValues<T, Next> >::holder &>(val)
+      .value;
+}
+template <std::size_t I, typename T, typename Next>
+const typename SoaAt<I, SoaValues<T, Next> >::type &
+get(const SoaValues<T, Next> &val) {
+  return static_cast<const typename SoaAt<I, SoaValues<T, Next> >::holder &>(
+             val)
+      .value;
+}
+
+///
+/// @brief Random access iterator over the rows of a soa_vector, it
+/// dereferences to a SoaReference proxy.
+///
+/// @tparam Columns
+/// @tparam Const
+///
+template <typename Columns, bool Const> struct SoaIterator {
+  typedef typename Columns::values_type value_type;
+  typedef SoaReference<Columns, Const> reference;
+  typedef void pointer;
+  typedef random_access_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef SoaIterator<Columns, Const> Soa_It;
+  typedef typename reference::columns_type columns_type;
+
+  SoaIterator() : cols(), index() {}
+  SoaIterator(columns_type *c, std::size_t i) : cols(c), index(i) {}
+  /// Enable conversion to const_iterator.
+  operator SoaIterator<Columns, true>() const {
+    return SoaIterator<Columns, true>(cols, index);
+  }
+
+  reference operator*() const { return reference(cols, index); }
+  reference operator[](difference_type n) const {
+    return reference(cols, index + n);
+  }
+  Soa_It &operator++() {
+    ++index;
+    return *this;
+  }
+  Soa_It operator++(int) {
+    Soa_It tmp = *this;
+    ++index;
+    return tmp;
+  }
+  Soa_It &operator--() {
+    --index;
+    return *this;
+  }
+  Soa_It operator--(int) {
+    Soa_It tmp = *this;
+    --index;
+    return tmp;
+  }
+  Soa_It &operator+=(difference_type n) {
+    index += n;
+    return *this;
+  }
+  Soa_It &operator-=(difference_type n) {
+    index -= n;
+    return *this;
+  }
+  Soa_It operator+(difference_type n) const { return Soa_It(cols, index + n); }
+  Soa_It operator-(difference_type n) const { return Soa_It(cols, index - n); }
+  friend Soa_It operator+(difference_type n, const Soa_It &it) {
+    return it + n;
+  }
+  friend difference_type operator-(const Soa_It &lhs, const Soa_It &rhs) {
+    return difference_type(lhs.index) - difference_type(rhs.index);
+  }
+  friend bool operator==(const Soa_It &lhs, const Soa_It &rhs) {
+    return lhs.index == rhs.index;
+  }
+  friend bool operator!=(const Soa_It &lhs, const Soa_It &rhs) {
+    return lhs.index != rhs.index;
+  }
+  friend bool operator<(const Soa_It &lhs, const Soa_It &rhs) {
+    return lhs.index < rhs.index;
+  }
+  friend bool operator>(const Soa_It &lhs, const Soa_It &rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const Soa_It &lhs, const Soa_It &rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const Soa_It &lhs, const Soa_It &rhs) {
+    return !(lhs < rhs);
+  }
+
+  columns_type *cols;
+  std::size_t index;
+};
+
+///
+/// @brief Structure-of-arrays vector class
+///
+/// @tparam T1..T6 Field types, unused ones are soa_null
+///
+template <typename T1, typename T2 = soa_null, typename T3 = soa_null,
+          typename T4 = soa_null, typename T5 = soa_null,
+          typename T6 = soa_null>
+class soa_vector {
+public:
+  typedef SoaColumns<
+      T1, SoaColumns<
+              T2, SoaColumns<
+                      T3, SoaColumns<
+                              T4, SoaColumns<
+                                      T5, SoaColumns<
+                                              T6, SoaColumns<soa_null,
+                                                             soa_null> > > > > > >
+      columns_type;
+  typedef typename columns_type::values_type value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef SoaReference<columns_type, false> reference;
+  typedef SoaReference<columns_type, true> const_reference;
+  typedef SoaIterator<columns_type, false> iterator;
+  typedef SoaIterator<columns_type, true> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  /// ---------- Ctors & operators
+
+  soa_vector() : cols(), count(0), cap(0) {}
+
+  ///
+  /// @brief Construct a new soa_vector object -> Fill constructor
+  ///
+  /// @param n
+  /// @param val
+  ///
+  explicit soa_vector(size_type n, const value_type &val = value_type())
+      : cols(), count(0), cap(0) {
+    resize(n, val);
+  }
+
+  soa_vector(const soa_vector &other) : cols(), count(0), cap(0) {
+    reserve(other.size());
+    cols.copy_construct(0, other.cols, 0, other.size());
+    count = other.size();
+  }
+
+  ~soa_vector() {
+    cols.destroy(0, count);
+    cols.deallocate(cap);
+  }
+
+  soa_vector &operator=(const soa_vector &other) {
+    if (&other != this) {
+      soa_vector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// ---------- Iterators
+  iterator begin() { return iterator(&cols, 0); }
+  const_iterator begin() const { return const_iterator(&cols, 0); }
+  iterator end() { return iterator(&cols, count); }
+  const_iterator end() const { return const_iterator(&cols, count); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /// ---------- Capacity
+  size_type size() const { return count; }
+  size_type capacity() const { return cap; }
+  bool empty() const { return count == 0; }
+  size_type max_size() const { return columns_type::max_size(); }
+
+  ///
+  /// @brief Increase the capacity of every column to n.
+  ///
+  /// @param n
+  ///
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("soa_vector::reserve");
+    if (n > cap)
+      reallocate(n);
+  }
+
+  ///
+  /// @brief Resize the soa_vector, either adds copies of val or erases.
+  ///
+  /// @param n
+  /// @param val
+  ///
+  void resize(size_type n, const value_type &val = value_type()) {
+    if (n > count) {
+      if (n > cap)
+        reallocate(vectorBase<T1>::growLength(count, n - count, max_size(),
+                                              "soa_vector::resize"));
+      cols.fill_construct(count, n - count, val);
+    } else
+      cols.destroy(n, count);
+    count = n;
+  }
+
+  /// ---------- Element access
+
+  reference operator[](size_type n) { return reference(&cols, n); }
+  const_reference operator[](size_type n) const {
+    return const_reference(&cols, n);
+  }
+  reference at(size_type n) {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const {
+    rangeCheck(n);
+    return (*this)[n];
+  }
+
+  ///
+  /// @brief Contiguous view over the field I of every row.
+  ///
+  /// @tparam I
+  /// @return soa_span
+  ///
+  template <std::size_t I> soa_span<typename SoaAt<I, columns_type>::type>
+  column() {
+    return soa_span<typename SoaAt<I, columns_type>::type>(
+        static_cast<typename SoaAt<I, columns_type>::holder &>(cols).data,
+        count);
+  }
+  template <std::size_t I>
+  soa_span<const typename SoaAt<I, columns_type>::type> column() const {
+    return soa_span<const typename SoaAt<I, columns_type>::type>(
+        static_cast<const typename SoaAt<I, columns_type>::holder &>(cols)
+            .data,
+        count);
+  }
+
+  /// ---------- Modifiers
+
+  ///
+  /// @brief Add a row at the end, one value per field.
+  ///
+  void push_back(const T1 &a, const T2 &b = T2(), const T3 &c = T3(),
+                 const T4 &d = T4(), const T5 &e = T5(), const T6 &f = T6()) {
+    push_back(value_type(a, b, c, d, e, f));
+  }
+  void push_back(const value_type &val) {
+    if (count == cap)
+      reallocate(vectorBase<T1>::growLength(count, 1, max_size(),
+                                            "soa_vector::push_back"));
+    cols.fill_construct(count, 1, val);
+    ++count;
+  }
+
+  ///
+  /// @brief Remove the last row.
+  ///
+  void pop_back() {
+    if (empty())
+      throw ft::ContainerIsEmptyError();
+    --count;
+    cols.destroy(count, count + 1);
+  }
+
+  ///
+  /// @brief Erase the row at the given position, the next rows shift down.
+  ///
+  /// @param position
+  /// @return iterator
+  ///
+  iterator erase(iterator position) {
+    cols.shift_down(position.index, count);
+    --count;
+    cols.destroy(count, count + 1);
+    return position;
+  }
+
+  void clear() {
+    cols.destroy(0, count);
+    count = 0;
+  }
+
+  void swap(soa_vector &other) {
+    ft::swap(cols, other.cols);
+    ft::swap(count, other.count);
+    ft::swap(cap, other.cap);
+  }
+
+protected:
+  void rangeCheck(size_type n) const {
+    if (n >= count)
+      throw std::out_of_range("soa_vector::rangeCheck");
+  }
+
+  ///
+  /// @brief Move every column to new storage of n slots. The old storage is
+  /// only released once every column has been copied.
+  ///
+  /// @param n
+  ///
+  void reallocate(size_type n) {
+    columns_type tmp;
+    tmp.allocate(n);
+    try {
+      tmp.copy_construct(0, cols, 0, count);
+    } catch (...) {
+      tmp.deallocate(n);
+      __throw_exception_again;
+    }
+    cols.destroy(0, count);
+    cols.deallocate(cap);
+    cols = tmp;
+    cap = n;
+  }
+
+  columns_type cols;
+  size_type count;
+  size_type cap;
+};
+
+template <typename T1, typename T2, typename T3, typename T4, typename T5,
+          typename T6>
+void swap(soa_vector<T1, T2, T3, T4, T5, T6> &x,
+          soa_vector<T1, T2, T3, T4, T5, T6> &y) {
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,345 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ThreadPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by bcosters          #+#    #+#             */
+/*   Updated: 2026/10/19 20:40:00 by bcosters         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace ft {
+namespace parallel {
+
+///
+/// @brief Fork-join thread pool with one task deque per thread.
+///
+///    A pool of size n runs n - 1 worker threads, the thread that calls
+///    run() is the n-th: it queues the tasks and then executes tasks itself
+///    until its own ones are done, so run() may be called from inside a
+///    task. Workers pop the newest task of their own deque and steal the
+///    oldest one of another deque when theirs is empty, threads outside the
+///    pool queue into a shared deque.
+///
+///    A task that throws does not stop the others, run() then throws
+///    std::runtime_error once they are all done.
+///
+class thread_pool {
+public:
+  typedef std::size_t size_type;
+  typedef void (*task_function)(void *, size_type);
+
+private:
+  struct Job {
+    long pending;
+    int failed;
+  };
+
+  struct Task {
+    task_function fn;
+    void *ctx;
+    size_type index;
+    Job *job;
+  };
+
+  ///
+  /// @brief Task deque of one thread, tasks[head, tail) are queued.
+  ///
+  struct Queue {
+    pthread_mutex_t lock;
+    Task *tasks;
+    size_type head;
+    size_type tail;
+    size_type cap;
+    pthread_t thread;
+    thread_pool *pool;
+    size_type id;
+
+    Queue(thread_pool *p, size_type i)
+        : tasks(0), head(0), tail(0), cap(0), pool(p), id(i) {
+      pthread_mutex_init(&lock, 0);
+    }
+    ~Queue() {
+      delete[] tasks;
+      pthread_mutex_destroy(&lock);
+    }
+
+    bool empty() const { return head == tail; }
+    void push(const Task &t) {
+      if (tail == cap) {
+        size_type n = tail - head;
+        Task *p = n * 2 < cap ? tasks : new Task[cap ? cap * 2 : 64];
+        std::copy(tasks + head, tasks + tail, p);
+        if (p != tasks) {
+          delete[] tasks;
+          cap = cap ? cap * 2 : 64;
+        }
+        tasks = p;
+        head = 0;
+        tail = n;
+      }
+      tasks[tail++] = t;
+    }
+  };
+
+  Queue **queues;
+  size_type count;
+  size_type started;
+  pthread_mutex_t sleepLock;
+  pthread_cond_t wake;
+  long queued;
+  bool stopping;
+
+  thread_pool(const thread_pool &);
+  thread_pool &operator=(const thread_pool &);
+
+  /// ---------- Calling thread
+
+  static thread_pool *&currentPool() {
+    static __thread thread_pool *pool = 0;
+    return pool;
+  }
+  static size_type &currentQueue() {
+    static __thread size_type id = 0;
+    return id;
+  }
+  size_type self() const { return currentPool() == this ? currentQueue() : 0; }
+
+  /// ---------- Deques
+
+  void push(size_type q, const Task &t) {
+    Queue &queue = *queues[q];
+    pthread_mutex_lock(&queue.lock);
+    try {
+      queue.push(t);
+    } catch (...) {
+      pthread_mutex_unlock(&queue.lock);
+      __throw_exception_again;
+    }
+    pthread_mutex_unlock(&queue.lock);
+  }
+
+  bool popBack(size_type q, Task &t) {
+    Queue &queue = *queues[q];
+    bool found = false;
+    pthread_mutex_lock(&queue.lock);
+    if (!queue.empty()) {
+      t = queue.tasks[--queue.tail];
+      found = true;
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return found;
+  }
+
+  bool stealFront(size_type q, Task &t) {
+    Queue &queue = *queues[q];
+    bool found = false;
+    pthread_mutex_lock(&queue.lock);
+    if (!queue.empty()) {
+      t = queue.tasks[queue.head++];
+      found = true;
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return found;
+  }
+
+  bool take(size_type q, Task &t) {
+    bool found = popBack(q, t);
+    for (size_type i = 1; !found && i < count; ++i)
+      found = stealFront((q + i) % count, t);
+    if (found)
+      __atomic_sub_fetch(&queued, 1, __ATOMIC_RELAXED);
+    return found;
+  }
+
+  static void execute(const Task &t) {
+    try {
+      t.fn(t.ctx, t.index);
+    } catch (...) {
+      __atomic_store_n(&t.job->failed, 1, __ATOMIC_RELAXED);
+    }
+    // Last touch of the job: the caller may return as soon as it sees 0.
+    __atomic_sub_fetch(&t.job->pending, 1, __ATOMIC_ACQ_REL);
+  }
+
+  /// ---------- Workers
+
+  static void *workerMain(void *arg) {
+    Queue *q = static_cast<Queue *>(arg);
+    thread_pool &pool = *q->pool;
+    currentPool() = &pool;
+    currentQueue() = q->id;
+    for (;;) {
+      Task t;
+      if (pool.take(q->id, t)) {
+        execute(t);
+        continue;
+      }
+      pthread_mutex_lock(&pool.sleepLock);
+      while (!pool.stopping && __atomic_load_n(&pool.queued, __ATOMIC_RELAXED) <= 0)
+        pthread_cond_wait(&pool.wake, &pool.sleepLock);
+      bool stop = pool.stopping;
+      pthread_mutex_unlock(&pool.sleepLock);
+      if (stop)
+        break;
+    }
+    return 0;
+  }
+
+  void start(size_type n) {
+    if (n == 0)
+      n = 1;
+    stopping = false;
+    queues = new Queue *[n];
+    for (count = 0; count < n; ++count)
+      queues[count] = new Queue(this, count);
+    // Every deque exists before the first worker reads them. A deque whose
+    // thread failed to start is still drained by stealing.
+    for (started = 1; started < n; ++started)
+      if (pthread_create(&queues[started]->thread, 0, &workerMain,
+                         queues[started]) != 0)
+        break;
+  }
+
+  void stop() {
+    pthread_mutex_lock(&sleepLock);
+    stopping = true;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&sleepLock);
+    for (size_type i = 1; i < started; ++i)
+      pthread_join(queues[i]->thread, 0);
+    for (size_type i = 0; i < count; ++i)
+      delete queues[i];
+    delete[] queues;
+    queues = 0;
+    count = 0;
+  }
+
+public:
+  /// ---------- Ctors & operators
+
+  ///
+  /// @brief Starts n - 1 worker threads.
+  ///
+  explicit thread_pool(size_type n)
+      : queues(0), count(0), started(0), queued(0), stopping(false) {
+    pthread_mutex_init(&sleepLock, 0);
+    pthread_cond_init(&wake, 0);
+    start(n);
+  }
+
+  ~thread_pool() {
+    stop();
+    pthread_cond_destroy(&wake);
+    pthread_mutex_destroy(&sleepLock);
+  }
+
+  /// ---------- Capacity
+
+  ///
+  /// @brief Number of threads taking part in run(), the caller included.
+  ///
+  size_type size() const { return count; }
+  ///
+  /// @brief Restarts the pool with n threads. No run() may be in flight.
+  ///
+  void resize(size_type n) {
+    if (n == 0)
+      n = 1;
+    if (n == size())
+      return;
+    stop();
+    start(n);
+  }
+
+  /// ---------- Execution
+
+  ///
+  /// @brief Calls fn(ctx, i) for every i in [0, n) and returns once all
+  /// calls are done.
+  ///
+  void run(size_type n, task_function fn, void *ctx) {
+    Job job;
+    job.pending = long(n);
+    job.failed = 0;
+    if (n == 0)
+      return;
+    if (size() == 1 || n == 1) {
+      for (size_type i = 0; i < n; ++i) {
+        Task t = {fn, ctx, i, &job};
+        execute(t);
+      }
+    } else {
+      size_type me = self();
+      // Own deque when inside the pool, so nested work stays local until
+      // stolen; spread round robin otherwise.
+      for (size_type i = 0; i < n; ++i) {
+        Task t = {fn, ctx, n - 1 - i, &job};
+        push(me ? me : i % size(), t);
+      }
+      __atomic_add_fetch(&queued, long(n), __ATOMIC_RELAXED);
+      pthread_mutex_lock(&sleepLock);
+      pthread_cond_broadcast(&wake);
+      pthread_mutex_unlock(&sleepLock);
+      while (__atomic_load_n(&job.pending, __ATOMIC_ACQUIRE) > 0) {
+        Task t;
+        if (take(me, t))
+          execute(t);
+        else
+          sched_yield();
+      }
+    }
+    if (job.failed)
+      throw std::runtime_error("ft::parallel: a task threw an exception");
+  }
+  ///
+  /// @brief Calls f(i) for every i in [0, n), f is shared by all threads.
+  ///
+  template <typename F> void run(size_type n, F &f) {
+    run(n, &callFunctor<F>, &f);
+  }
+
+private:
+  template <typename F> static void callFunctor(void *f, size_type i) {
+    (*static_cast<F *>(f))(i);
+  }
+};
+
+///
+/// @brief Number of hardware threads, at least 1.
+///
+inline std::size_t hardware_threads() {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? std::size_t(n) : 1;
+}
+///
+/// @brief The pool of the ft::parallel algorithms and of the vector
+/// first-touch paths, one per process.
+///
+inline thread_pool &default_pool() {
+  static thread_pool pool(hardware_threads());
+  return pool;
+}
+///
+/// @brief Sets the number of threads the algorithms use, 1 runs
+/// everything on the calling thread. Not while an algorithm is running.
+///
+inline void set_thread_count(std::size_t n) { default_pool().resize(n); }
+inline std::size_t thread_count() { return default_pool().size(); }
+
+} // namespace parallel
+} // namespace ft
+
+#endif
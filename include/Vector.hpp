@@ -6,13 +6,14 @@
 /*   By: bcosters <bcosters@student.42lisboa.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/01/13 16:44:00 by bcosters          #+#    #+#             */
-/*   Updated: 2022/08/02 09:32:48 by bcosters         ###   ########.fr       */
+/*   Updated: 2026/10/19 21:10:00 by bcosters         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 
+#include "AlignedAllocator.hpp"
 #include "Iterators.hpp"
 #include "utility.hpp"
 #include <algorithm>
@@ -82,7 +83,7 @@ namespace ft
             finish = pointer();
             endOfStorage = pointer();
             createStorage(rhs.size());
-            finish = construct(start, rhs.start, rhs.finish);
+            finish = copyConstruct(start, rhs.start, rhs.size());
         }
 
         ///
@@ -221,12 +222,81 @@ namespace ft
         ///
         void destroyAll()
         {
-            destroy(start, finish);
+            destroyRange(start, finish);
             // for (size_type i = 0; i < size(); i++) {
             //   destroy(start, i);
             // }
         }
 
+        /// ---------- First touch
+
+        ///
+        /// @brief Constructs n copies of val at p, on the allocator's threads
+        /// when it opts in (see ft::allocator_first_touch).
+        ///
+        /// @return pointer past the last constructed element
+        ///
+        pointer fillConstruct(pointer p, size_type n, const value_type &val)
+        {
+            if (firstTouch(n))
+                return firstTouchRun(FirstTouch::fill, p, &val, n);
+            pointer cur = p;
+            try
+            {
+                for (; cur != p + n; ++cur)
+                    alloc.construct(cur, val);
+            }
+            catch (...)
+            {
+                destroy(p, cur);
+                __throw_exception_again;
+            }
+            return cur;
+        }
+
+        ///
+        /// @brief Copy constructs src[0, n) at p.
+        ///
+        pointer copyConstruct(pointer p, const value_type *src, size_type n)
+        {
+            if (firstTouch(n))
+                return firstTouchRun(FirstTouch::copy, p, src, n);
+            pointer cur = p;
+            try
+            {
+                for (; cur != p + n; ++cur)
+                    alloc.construct(cur, *src++);
+            }
+            catch (...)
+            {
+                destroy(p, cur);
+                __throw_exception_again;
+            }
+            return cur;
+        }
+
+        ///
+        /// @brief Assigns val to the n live elements at p.
+        ///
+        void assignFill(pointer p, size_type n, const value_type &val)
+        {
+            if (firstTouch(n))
+                firstTouchRun(FirstTouch::assign, p, &val, n);
+            else
+                std::fill(p, p + n, val);
+        }
+
+        ///
+        /// @brief Destroys [first, last), does not free memory.
+        ///
+        void destroyRange(pointer first, pointer last)
+        {
+            if (firstTouch(last - first))
+                firstTouchRun(FirstTouch::destroy, first, 0, last - first);
+            else
+                destroy(first, last);
+        }
+
         ///
         /// @brief Returns the current size of the vector.
         ///
@@ -248,7 +318,115 @@ namespace ft
         ///
         size_type capacity() const { return size_type(endOfStorage - start); }
 
+        ///
+        /// @brief Growth policy shared by the vector-like containers: the
+        /// length doubles, or grows by n if that is more, capped at maxSize.
+        ///
+        /// @param size Current length
+        /// @param n Number of elements that must fit on top of size
+        /// @param maxSize
+        /// @param s Message of the length_error thrown when n does not fit
+        /// @return size_type
+        ///
+        static size_type growLength(size_type size, size_type n,
+                                    size_type maxSize, const char *s)
+        {
+            if (maxSize - size < n)
+                throw std::length_error(s);
+            const size_type len = size + std::max(size, n);
+            return (len < size || len > maxSize) ? maxSize : len;
+        }
+
     protected:
+        enum { first_touch_chunk = 1 << 20 };
+
+        ///
+        /// @brief Whether n elements are worth splitting between threads.
+        ///
+        static bool firstTouch(size_type n)
+        {
+            const std::size_t threshold = allocator_first_touch<Allocator>::threshold;
+            return threshold != 0 && n > 1 && n >= threshold / sizeof(value_type) &&
+                   allocator_first_touch<Allocator>::workers() > 1;
+        }
+
+        ///
+        /// @brief One chunk of a parallel fill, copy, assign or destroy. A
+        /// chunk that throws destroys what it constructed.
+        ///
+        struct FirstTouch
+        {
+            enum Mode { fill, copy, assign, destroy };
+
+            vectorBase &base;
+            Mode mode;
+            pointer dst;
+            const value_type *src;
+            size_type n;
+            size_type chunks;
+            char *done;
+
+            size_type begin(size_type i) const
+            {
+                return n / chunks * i + std::min(i, n % chunks);
+            }
+            void operator()(size_type i)
+            {
+                pointer first = dst + begin(i);
+                pointer last = dst + begin(i + 1);
+                pointer cur = first;
+                try
+                {
+                    if (mode == fill)
+                        for (; cur != last; ++cur)
+                            base.alloc.construct(cur, *src);
+                    else if (mode == copy)
+                        for (const value_type *from = src + begin(i); cur != last; ++cur)
+                            base.alloc.construct(cur, *from++);
+                    else if (mode == assign)
+                        std::fill(first, last, *src);
+                    else
+                        base.destroy(first, last);
+                }
+                catch (...)
+                {
+                    base.destroy(first, cur);
+                    __throw_exception_again;
+                }
+                done[i] = 1;
+            }
+        };
+
+        ///
+        /// @brief Runs a FirstTouch over n elements in chunks of at least
+        /// first_touch_chunk bytes. If an element throws, every element it
+        /// constructed is destroyed and the exception of run() is rethrown.
+        ///
+        pointer firstTouchRun(typename FirstTouch::Mode mode, pointer dst,
+                              const value_type *src, size_type n)
+        {
+            size_type chunks = std::min<size_type>(
+                allocator_first_touch<Allocator>::workers() * 4,
+                n * sizeof(value_type) / first_touch_chunk + 1);
+            char *done = new char[chunks]();
+            FirstTouch body = {*this, mode, dst, src, n, chunks, done};
+            try
+            {
+                allocator_first_touch<Allocator>::run(chunks, body);
+            }
+            catch (...)
+            {
+                if (mode == FirstTouch::fill || mode == FirstTouch::copy)
+                    for (size_type i = 0; i < chunks; ++i)
+                        if (done[i])
+                            destroy(dst + body.begin(i), dst + body.begin(i + 1));
+                delete[] done;
+                __throw_exception_again;
+            }
+            delete[] done;
+            return dst + n;
+        }
+
         ///
         /// @brief Create storage of a given size, updates the internal pointers.
         ///
@@ -322,6 +500,10 @@ namespace ft
         typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
         typedef vectorBase<T, Allocator> Base;
 
+        /// Alignment in bytes guaranteed for data(), aligned_allocator raises
+        /// it so kernels can use aligned loads.
+        enum { alignment = ft::allocator_alignment<Allocator>::value };
+
         using Base::allocate;
         using Base::capacity;
         using Base::deallocate;
@@ -362,7 +544,7 @@ namespace ft
         ///
         vector(const vector &other) : Base(other.size(), other.get_allocator())
         {
-            Base::finish = construct(Base::start, other.begin(), other.end());
+            Base::finish = Base::copyConstruct(Base::start, other.Base::start, other.size());
         }
 
         ///
@@ -400,17 +582,15 @@ namespace ft
             if (&other != this)
             {
                 destroyAll();
+                Base::finish = Base::start;
                 if (capacity() < other.size())
                 {
                     deallocate(Base::start, capacity());
-                    Base::start = allocate(other.size());
-                    Base::finish = construct(Base::start, other.begin(), other.end());
-                    Base::endOfStorage = Base::finish;
-                }
-                else
-                {
-                    Base::finish = construct(Base::start, other.begin(), other.end());
+                    Base::start = Base::finish = Base::endOfStorage = pointer();
+                    Base::start = Base::finish = allocate(other.size());
+                    Base::endOfStorage = Base::start + other.size();
                 }
+                Base::finish = Base::copyConstruct(Base::start, other.Base::start, other.size());
             }
             return *this;
         }
@@ -553,6 +733,14 @@ namespace ft
             return *(end() - 1);
         }
 
+        ///
+        /// @brief Return the data PTR, aligned to at least alignment bytes.
+        ///
+        /// @return T*
+        ///
+        T *data() { return dataPtr(Base::start); }
+        const T *data() const { return dataPtr(Base::start); }
+
         ///
         /// @brief Add the value at the end of the vector.
         ///
@@ -614,6 +802,63 @@ namespace ft
             insertDispatch(position, first, last, Integral());
         }
 
+        ///
+        /// @brief Append n elements copied from p at the end, the storage
+        /// grows at most once. Trivially copyable data is copied with memcpy.
+        ///
+        /// @param p
+        /// @param n
+        ///
+        void append(const value_type *p, size_type n)
+        {
+            if (n == 0)
+                return;
+            if (size_type(Base::endOfStorage - Base::finish) >= n)
+            {
+                Base::finish = copyN(Base::finish, p, n, trivial_type());
+                return;
+            }
+            // Copy into the new storage before releasing the old one, p may
+            // point into this vector.
+            const size_type len = checkLen(n, "vector::append");
+            pointer newStart = allocate(len);
+            pointer newFinish = newStart;
+            try
+            {
+                newFinish = copyN(newStart, Base::start, size(), trivial_type());
+                newFinish = copyN(newFinish, p, n, trivial_type());
+            }
+            catch (...)
+            {
+                destroy(newStart, newFinish);
+                deallocate(newStart, len);
+                __throw_exception_again;
+            }
+            destroy(Base::start, Base::finish);
+            deallocate(Base::start, capacity());
+            Base::start = newStart;
+            Base::finish = newFinish;
+            Base::endOfStorage = newStart + len;
+        }
+
+        ///
+        /// @brief Append the given range at the end.
+        ///
+        ///    Forward ranges are measured and reserved for once. For input
+        ///    ranges size_hint elements are reserved up front, the storage
+        ///    then grows geometrically, so O(log n) times at most.
+        ///
+        /// @tparam InputIt
+        /// @param first
+        /// @param last
+        /// @param size_hint Expected length of an input range
+        ///
+        template <typename InputIt>
+        void append_range(InputIt first, InputIt last, size_type size_hint = 0)
+        {
+            appendRange(first, last, size_hint, ft::__iterator_category(first));
+        }
+
         ///
         /// @brief Erase the element at the given position.
         ///
@@ -667,14 +912,6 @@ namespace ft
         using Base::destroyAll;
         using Base::swapData;
 
-        ///
-        /// @brief Return the data PTR.
-        ///
-        /// @return T*
-        ///
-        T *data() { return dataPtr(Base::start); }
-        const T *data() const { return dataPtr(Base::start); }
-
         ///
         /// @brief Check if a given n will go out of range.
         ///
@@ -725,6 +962,97 @@ namespace ft
             }
         }
 
+        /// Elements are copied with memcpy when copying them is a memcpy
+        typedef ft::integral_constant<bool, __has_trivial_copy(T) &&
+                                                __has_trivial_destructor(T)>
+            trivial_type;
+
+        ///
+        /// @brief Copy n elements from src to the uninitialized dst.
+        ///
+        /// @param dst
+        /// @param src
+        /// @param n
+        /// @return pointer Past the last copied element
+        ///
+        pointer copyN(pointer dst, const value_type *src, size_type n, ft::true_type)
+        {
+            if (n)
+                std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                            n * sizeof(value_type));
+            return dst + n;
+        }
+        pointer copyN(pointer dst, const value_type *src, size_type n, ft::false_type)
+        {
+            return std::uninitialized_copy(src, src + n, dst);
+        }
+
+        ///
+        /// @brief Make room for n more elements, growing geometrically.
+        ///
+        /// @param n
+        ///
+        void reserveMore(size_type n)
+        {
+            if (size_type(Base::endOfStorage - Base::finish) < n)
+                reserve(checkLen(n, "vector::append_range"));
+        }
+
+        ///
+        /// @brief Append a range, input_iterator specialization.
+        ///
+        /// @tparam InputIterator
+        /// @param first
+        /// @param last
+        /// @param sizeHint
+        ///
+        template <typename InputIterator>
+        void appendRange(InputIterator first, InputIterator last, size_type sizeHint,
+                         ft::input_iterator_tag)
+        {
+            if (first == last)
+                return;
+            reserveMore(sizeHint);
+            for (; first != last; ++first)
+            {
+                if (Base::finish == Base::endOfStorage)
+                    reserveMore(1);
+                Base::alloc.construct(Base::finish, *first);
+                ++Base::finish;
+            }
+        }
+        template <typename InputIterator>
+        void appendRange(InputIterator first, InputIterator last, size_type sizeHint,
+                         std::input_iterator_tag)
+        {
+            appendRange(first, last, sizeHint, ft::input_iterator_tag());
+        }
+
+        ///
+        /// @brief Append a range, forward_iterator specialization.
+        ///
+        /// @tparam ForwardIterator
+        /// @param first
+        /// @param last
+        ///
+        template <typename ForwardIterator>
+        void appendRange(ForwardIterator first, ForwardIterator last, size_type,
+                         ft::forward_iterator_tag)
+        {
+            reserveMore(ft::distance(first, last));
+            for (; first != last; ++first)
+            {
+                Base::alloc.construct(Base::finish, *first);
+                ++Base::finish;
+            }
+        }
+        template <typename ForwardIterator>
+        void appendRange(ForwardIterator first, ForwardIterator last, size_type sizeHint,
+                         std::forward_iterator_tag)
+        {
+            appendRange(first, last, sizeHint, ft::forward_iterator_tag());
+        }
+
         ///
         /// @brief Increase the allocated size by one and insert the value before position.
         ///
@@ -807,11 +1135,7 @@ namespace ft
         ///
         void fillInitialize(size_type n, const value_type &value)
         {
-            for (size_type i = 0; i < n; i++)
-            {
-                construct(Base::start, value, i);
-            }
-            Base::finish = Base::start + n;
+            Base::finish = Base::fillConstruct(Base::start, n, value);
         }
 
         ///
@@ -971,10 +1295,7 @@ namespace ft
         ///
         size_type checkLen(size_type n, const char *s) const
         {
-            if (max_size() - size() < n)
-                throw std::length_error(s);
-            const size_type len = size() + std::max(size(), n);
-            return (len < size() || len > max_size()) ? max_size() : len;
+            return Base::growLength(size(), n, max_size(), s);
         }
 
         ///
@@ -986,7 +1307,7 @@ namespace ft
         {
             if (size_type n = Base::finish - pos)
             {
-                destroy(pos, Base::finish);
+                Base::destroyRange(pos, Base::finish);
                 Base::finish = (pos);
             }
         }
@@ -1025,18 +1346,21 @@ namespace ft
             {
                 destroyAll();
                 deallocate(Base::start, capacity());
-                Base::start = allocate(n);
-                Base::finish = ft::fill_n(Base::start, n, value);
-                Base::endOfStorage = Base::finish;
+                Base::start = Base::finish = Base::endOfStorage = pointer();
+                Base::start = Base::finish = allocate(n);
+                Base::endOfStorage = Base::start + n;
+                Base::finish = Base::fillConstruct(Base::start, n, value);
             }
             else if (n > size())
             {
-                ft::fill(begin(), end(), value);
-                size_type add = n - size();
-                Base::finish = (ft::fill_n(Base::finish, add, value));
+                Base::assignFill(Base::start, size(), value);
+                Base::finish = Base::fillConstruct(Base::finish, n - size(), value);
             }
             else
-                eraseUntilEnd(ft::fill_n(Base::start, n, value));
+            {
+                Base::assignFill(Base::start, n, value);
+                eraseUntilEnd(Base::start + n);
+            }
         }
 
         ///
@@ -1117,6 +1441,9 @@ namespace ft
         void rangeInsert(iterator pos, InputIterator first, InputIterator last,
                          ft::input_iterator_tag)
         {
+            if (pos == end())
+                appendRange(first, last, 0, ft::__iterator_category(first));
+            else
             {
                 for (; first != last; ++first)
                 {
@@ -1126,6 +1453,16 @@ namespace ft
             }
         }
 
+        ///
+        /// @brief Catch the stl_iterators and use the input_iterator version.
+        ///
+        template <typename InputIterator>
+        void rangeInsert(iterator pos, InputIterator first, InputIterator last,
+                         std::input_iterator_tag)
+        {
+            rangeInsert(pos, first, last, ft::input_iterator_tag());
+        }
+
         ///
         /// @brief Inserts a range before the position, forward_iterator specialization.
         ///
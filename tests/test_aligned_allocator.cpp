@@ -0,0 +1,86 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <cstdlib>
+# include <memory>
+# include <new>
+# include <vector>
+template <typename T, size_t Alignment = 64>
+struct aligned_allocator : public std::allocator<T> {
+	template <typename U> struct rebind { typedef aligned_allocator<U, Alignment> other; };
+	aligned_allocator() {}
+	template <typename U> aligned_allocator(const aligned_allocator<U, Alignment> &) {}
+	T *allocate(size_t n, const void * = 0) {
+		void	*p = NULL;
+		if (posix_memalign(&p, Alignment, n ? n * sizeof(T) : Alignment))
+			throw std::bad_alloc();
+		return static_cast<T *>(p);
+	}
+	void deallocate(T *p, size_t) { free(p); }
+};
+template <typename Vector> size_t vector_alignment() { return alignof(typename Vector::value_type); }
+template <> size_t vector_alignment<std::vector<float, aligned_allocator<float> > >() { return 64; }
+template <> size_t vector_alignment<std::vector<char, aligned_allocator<char, 4096> > >() { return 4096; }
+using std::vector;
+#else
+# include "../include/Vector.hpp"
+using ft::aligned_allocator;
+using ft::vector;
+template <typename Vector> size_t vector_alignment() { return Vector::alignment; }
+#endif // _IS_TEST
+
+#include <iostream>
+#include <stdint.h>
+
+#define SIZE 1000000
+
+template <typename T>
+bool is_aligned(const T *p, size_t alignment) {
+	return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+int main() {
+	std::cout << "[#### Testing aligned_allocator ####]" << std::endl;
+	typedef vector<float, aligned_allocator<float> >	floats;
+
+	std::cout << "[alignment] " << vector_alignment<vector<int> >() << ' '
+		<< vector_alignment<floats>() << ' '
+		<< vector_alignment<vector<char, aligned_allocator<char, 4096> > >() << std::endl;
+
+	floats	v;
+	bool	aligned = true;
+	for (int i = 0; i < 1000; i++) {
+		v.push_back(i * 0.5f);
+		aligned = aligned && is_aligned(v.data(), 64);
+	}
+	std::cout << "[push_back aligned] " << aligned << " [size] " << v.size() << " [back] " << v.back() << std::endl;
+
+	floats	copy(v);
+	copy.resize(5000, 1.0f);
+	copy.reserve(20000);
+	std::cout << "[copy aligned] " << is_aligned(copy.data(), 64) << " [size] " << copy.size() << std::endl;
+
+	vector<char, aligned_allocator<char, 4096> >	page(10, 'x');
+	std::cout << "[page aligned] " << is_aligned(page.data(), 4096) << std::endl;
+
+	std::cout << "[#### per thread vectors ####]" << std::endl;
+	vector<floats>	lanes(8, floats(3, 1.0f));
+	bool	shared = false;
+	for (size_t i = 0; i < lanes.size(); i++)
+		for (size_t j = i + 1; j < lanes.size(); j++)
+			shared = shared || reinterpret_cast<uintptr_t>(lanes[i].data()) / 64 ==
+				reinterpret_cast<uintptr_t>(lanes[j].data()) / 64;
+	std::cout << "[shared line] " << shared << std::endl;
+
+	std::cout << "[#### large ####]" << std::endl;
+	floats	a(SIZE, 1.5f), b(SIZE, 2.0f);
+	double	sum = 0;
+	for (int round = 0; round < 20; round++) {
+		float		*pa = a.data();
+		const float	*pb = b.data();
+		for (size_t i = 0; i < a.size(); i++)
+			pa[i] = pa[i] * 0.5f + pb[i];
+		sum += a[round];
+	}
+	std::cout << "[sum] " << sum << std::endl;
+	return 0;
+}
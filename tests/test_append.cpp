@@ -0,0 +1,126 @@
+#ifndef _IS_TEST
+# include <iterator>
+# include <map>
+# include <set>
+# include <utility>
+# include <vector>
+namespace ft = std;
+template <typename T>
+void append(std::vector<T> &v, const T *p, size_t n) { v.insert(v.end(), p, p + n); }
+template <typename T, typename It>
+void append_range(std::vector<T> &v, It first, It last, size_t) { v.insert(v.end(), first, last); }
+template <typename C>
+std::back_insert_iterator<C> chunked_back_inserter(C &c, size_t) { return std::back_inserter(c); }
+#else
+# include "../include/Map.hpp"
+# include "../include/Set.hpp"
+# include "../include/Vector.hpp"
+template <typename T>
+void append(ft::vector<T> &v, const T *p, size_t n) { v.append(p, n); }
+template <typename T, typename It>
+void append_range(ft::vector<T> &v, It first, It last, size_t hint) { v.append_range(first, last, hint); }
+using ft::chunked_back_inserter;
+#endif // _IS_TEST
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+#define SIZE 1000000
+
+/// Plain record, as read from a socket buffer.
+struct Record {
+	int		id;
+	short	flags;
+	double	value;
+};
+
+template <typename T>
+void display(const std::string &title, const ft::vector<T> &v) {
+	std::cout << title << " [size] " << v.size() << " [values]";
+	for (size_t i = 0; i < v.size(); i++)
+		std::cout << ' ' << v[i];
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### Testing append ####]" << std::endl;
+	ft::vector<int>	v;
+	int				buf[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	append(v, buf, 8);
+	append(v, buf, 0);
+	append(v, buf + 2, 3);
+	display("[append]", v);
+
+	ft::vector<std::string>	words;
+	std::string				names[] = { "alpha", "beta", "gamma" };
+	append(words, names, 3);
+	append(words, names, 2);
+	display("[strings]", words);
+
+	ft::vector<Record>	records;
+	Record				wire[4];
+	for (int i = 0; i < 4; i++) {
+		wire[i].id = i + 1;
+		wire[i].flags = short(i * 3);
+		wire[i].value = i * 0.5;
+	}
+	append(records, wire, 4);
+	append(records, wire + 1, 2);
+	std::cout << "[records] " << records.size();
+	for (size_t i = 0; i < records.size(); i++)
+		std::cout << ' ' << records[i].id << ':' << records[i].flags << ':' << records[i].value;
+	std::cout << std::endl;
+
+	std::cout << "[#### append_range ####]" << std::endl;
+	std::list<int>	lst;
+	for (int i = 0; i < 10; i++)
+		lst.push_back(i * i);
+	append_range(v, lst.begin(), lst.end(), 0);
+	display("[list]", v);
+	std::istringstream	in("10 20 30 40 50");
+	ft::vector<int>		parsed;
+	append_range(parsed, std::istream_iterator<int>(in), std::istream_iterator<int>(), 2);
+	display("[istream]", parsed);
+	ft::set<int>	keys;
+	ft::set<int>	none;
+	for (int i = 0; i < 6; i++)
+		keys.insert(i * 7 % 10);
+	append_range(parsed, keys.begin(), keys.end(), 0);
+	append_range(parsed, none.begin(), none.end(), 0);
+	display("[set]", parsed);
+	ft::map<int, int>				table;
+	ft::map<int, int>				empty;
+	ft::vector<ft::pair<int, int> >	rows;
+	table[3] = 30;
+	table[1] = 10;
+	append_range(rows, empty.begin(), empty.end(), 0);
+	append_range(rows, table.begin(), table.end(), 0);
+	std::cout << "[map] " << rows.size() << ' ' << rows[0].first << ' ' << rows[1].second
+		<< std::endl;
+	parsed.insert(parsed.end(), lst.begin(), lst.end());
+	display("[insert end]", parsed);
+
+	std::cout << "[#### chunked_back_inserter ####]" << std::endl;
+	ft::vector<int>	out;
+	std::copy(lst.begin(), lst.end(), chunked_back_inserter(out, 4));
+	std::fill_n(chunked_back_inserter(out, 4), 3, 7);
+	display("[inserter]", out);
+
+	std::cout << "[#### large ####]" << std::endl;
+	ft::vector<int>	chunk(1024, 3);
+	ft::vector<int>	big;
+	for (int i = 0; i < SIZE / 1024; i++)
+		append(big, &chunk[0], chunk.size());
+	std::list<int>	src(SIZE / 4, 1);
+	append_range(big, src.begin(), src.end(), src.size());
+	ft::vector<int>	gen;
+	std::copy(src.begin(), src.end(), chunked_back_inserter(gen, 4096));
+	long	sum = 0;
+	for (size_t i = 0; i < big.size(); i++)
+		sum += big[i];
+	std::cout << "[size] " << big.size() << ' ' << gen.size() << " [sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,159 @@
+#ifndef _IS_TEST
+# include <algorithm>
+# include <cstddef>
+# include <vector>
+class bit_vector : public std::vector<bool> {
+public:
+	static const size_t	npos = size_t(-1);
+
+	bit_vector() {}
+	explicit bit_vector(size_t n, bool val = false) : std::vector<bool>(n, val) {}
+
+	bool test(size_t n) const { return (*this)[n]; }
+	size_t count() const {
+		size_t	n = 0;
+		for (size_t i = 0; i < size(); i++)
+			n += (*this)[i];
+		return n;
+	}
+	bool any() const { return count() != 0; }
+	bool none() const { return !any(); }
+	size_t find_first() const { return find_from(0); }
+	size_t find_next(size_t pos) const { return pos >= size() ? npos : find_from(pos + 1); }
+	void fill(bool val) { std::fill(begin(), end(), val); }
+	bit_vector &operator&=(const bit_vector &rhs) {
+		for (size_t i = 0; i < size(); i++)
+			(*this)[i] = (*this)[i] && rhs[i];
+		return *this;
+	}
+	bit_vector &operator|=(const bit_vector &rhs) {
+		for (size_t i = 0; i < size(); i++)
+			(*this)[i] = (*this)[i] || rhs[i];
+		return *this;
+	}
+	bit_vector &operator^=(const bit_vector &rhs) {
+		for (size_t i = 0; i < size(); i++)
+			(*this)[i] = (*this)[i] != rhs[i];
+		return *this;
+	}
+
+private:
+	size_t find_from(size_t pos) const {
+		for (; pos < size(); pos++)
+			if ((*this)[pos])
+				return pos;
+		return npos;
+	}
+};
+bit_vector operator^(const bit_vector &lhs, const bit_vector &rhs) {
+	bit_vector	tmp(lhs);
+	return tmp ^= rhs;
+}
+#else
+# include "../include/BitVector.hpp"
+typedef ft::bit_vector<>	bit_vector;
+#endif // _IS_TEST
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define SIZE 1000000
+
+void print(const std::string &title, const bit_vector &b) {
+	std::cout << title << " [size] " << b.size() << " [count] " << b.count() << " [bits] ";
+	for (bit_vector::const_iterator it = b.begin(); it != b.end(); ++it)
+		std::cout << *it;
+	std::cout << std::endl;
+}
+
+void print_set(const std::string &title, const bit_vector &b) {
+	std::cout << title;
+	for (size_t i = b.find_first(); i != bit_vector::npos; i = b.find_next(i))
+		std::cout << ' ' << i;
+	std::cout << std::endl;
+}
+
+int main() {
+	srand(42);
+
+	std::cout << "[#### Testing bit_vector ####]" << std::endl;
+	bit_vector	b;
+	std::cout << "[empty] " << b.empty() << " [none] " << b.none() << std::endl;
+	for (int i = 0; i < 70; i++)
+		b.push_back(i % 3 == 0);
+	print("[push_back]", b);
+	print_set("[set]", b);
+	std::cout << "[find_next] " << (b.find_next(69) == bit_vector::npos)
+		<< ' ' << (b.find_next(bit_vector::npos) == bit_vector::npos) << std::endl;
+	b.pop_back();
+	b.pop_back();
+	print("[pop_back]", b);
+
+	std::cout << "[#### proxy references ####]" << std::endl;
+	b[1] = true;
+	b[0] = b[2];
+	b.back() = true;
+	*(b.begin() + 65) = true;
+	bit_vector::reference	ref = b.at(4);
+	ref.flip();
+	print("[assign]", b);
+	std::cout << "[at] " << b.at(1) << " [front] " << b.front() << " [distance] " << (b.end() - b.begin()) << std::endl;
+	try {
+		b.at(1000);
+	} catch (std::out_of_range &e) {
+		std::cout << "[out_of_range]" << std::endl;
+	}
+	size_t	rev = 0;
+	for (bit_vector::reverse_iterator it = b.rbegin(); it != b.rend(); ++it)
+		rev = rev * 3 % 1000003 + *it;
+	std::cout << "[reverse hash] " << rev << std::endl;
+
+	std::cout << "[#### resize / fill / flip ####]" << std::endl;
+	bit_vector	c(10, true);
+	c.resize(70, true);
+	print("[resize true]", c);
+	c.resize(5);
+	c.resize(68);
+	print("[resize false]", c);
+	c.flip();
+	print("[flip]", c);
+	c.fill(false);
+	print("[fill]", c);
+
+	std::cout << "[#### logic ####]" << std::endl;
+	bit_vector	x(130), y(130);
+	for (size_t i = 0; i < 130; i += 3)
+		x[i] = true;
+	for (size_t i = 0; i < 130; i += 5)
+		y[i] = true;
+	bit_vector	z(x);
+	z &= y;
+	print_set("[and]", z);
+	z = x;
+	z |= y;
+	std::cout << "[or count] " << z.count() << std::endl;
+	print_set("[xor]", x ^ y);
+	std::cout << "[equal] " << (z == x) << ' ' << (z == z) << std::endl;
+
+	std::cout << "[#### large ####]" << std::endl;
+	bit_vector	members(SIZE), other(SIZE);
+	for (int i = 0; i < SIZE / 10; i++) {
+		members[rand() % SIZE] = true;
+		other[rand() % SIZE] = true;
+	}
+	size_t	total = 0;
+	for (int round = 0; round < 20; round++) {
+		bit_vector	both(members);
+		both &= other;
+		total += both.count();
+		members ^= other;
+		size_t	hits = 0;
+		for (size_t i = members.find_first(); i != bit_vector::npos; i = members.find_next(i))
+			hits++;
+		total += hits;
+	}
+	std::cout << "[total] " << total << std::endl;
+	return 0;
+}
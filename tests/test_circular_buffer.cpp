@@ -0,0 +1,152 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <deque>
+# include <stdexcept>
+# include <utility>
+template <typename T> class circular_buffer : public std::deque<T> {
+public:
+	typedef std::pair<const T *, size_t>	const_array_range;
+
+	explicit circular_buffer(size_t capacity = 0, bool overwrite = true)
+		: cap(capacity), overwrite(overwrite) {}
+
+	size_t capacity() const { return cap; }
+	bool full() const { return this->size() == cap; }
+	void push_back(const T &val) {
+		if (full()) {
+			if (!overwrite)
+				throw std::length_error("circular_buffer::push_back");
+			if (cap == 0)
+				return;
+			this->pop_front();
+		}
+		std::deque<T>::push_back(val);
+	}
+	void push_front(const T &val) {
+		if (full()) {
+			if (!overwrite)
+				throw std::length_error("circular_buffer::push_front");
+			if (cap == 0)
+				return;
+			this->pop_back();
+		}
+		std::deque<T>::push_front(val);
+	}
+	void set_capacity(size_t n) {
+		while (this->size() > n)
+			this->pop_front();
+		cap = n;
+	}
+
+private:
+	size_t	cap;
+	bool	overwrite;
+};
+#else
+# include "../include/CircularBuffer.hpp"
+using ft::circular_buffer;
+#endif // _IS_TEST
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define SIZE 1000000
+
+template <typename Buffer>
+void display(const std::string &title, const Buffer &b) {
+	std::cout << title << " [size] " << b.size() << " [capacity] " << b.capacity()
+		<< " [full] " << b.full() << " [values]";
+	for (typename Buffer::const_iterator it = b.begin(); it != b.end(); ++it)
+		std::cout << ' ' << *it;
+	std::cout << std::endl;
+}
+
+/// Bulk read of the whole buffer, two memcpy-able runs for ft.
+template <typename T>
+std::vector<T> linearize(const circular_buffer<T> &b) {
+	std::vector<T>	out;
+#ifdef _IS_TEST
+	typename circular_buffer<T>::const_array_range	one = b.array_one();
+	typename circular_buffer<T>::const_array_range	two = b.array_two();
+	out.insert(out.end(), one.first, one.first + one.second);
+	out.insert(out.end(), two.first, two.first + two.second);
+#else
+	out.assign(b.begin(), b.end());
+#endif
+	return out;
+}
+
+int main() {
+	std::cout << "[#### Testing circular_buffer ####]" << std::endl;
+	circular_buffer<int>	b(5);
+	display("[empty]", b);
+	for (int i = 0; i < 8; i++)
+		b.push_back(i);
+	display("[push_back overwrite]", b);
+	b.push_front(-1);
+	display("[push_front overwrite]", b);
+	b.pop_front();
+	b.pop_back();
+	display("[pop]", b);
+	b.push_front(42);
+	b.push_back(43);
+	display("[push both]", b);
+	std::cout << "[front] " << b.front() << " [back] " << b.back() << " [at] " << b.at(2) << std::endl;
+	try {
+		b.at(5);
+	} catch (std::out_of_range &e) {
+		std::cout << "[out_of_range]" << std::endl;
+	}
+
+	std::cout << "[#### iterators ####]" << std::endl;
+	circular_buffer<int>::iterator	it = b.begin() + 3;
+	std::cout << "[it] " << *it << ' ' << it[-1] << ' ' << (b.end() - it) << std::endl;
+	*it = 99;
+	for (circular_buffer<int>::reverse_iterator r = b.rbegin(); r != b.rend(); ++r)
+		std::cout << *r << ' ';
+	std::cout << std::endl;
+	std::vector<int>	lin = linearize(b);
+	std::cout << "[linearized]";
+	for (size_t i = 0; i < lin.size(); i++)
+		std::cout << ' ' << lin[i];
+	std::cout << std::endl;
+
+	std::cout << "[#### no overwrite ####]" << std::endl;
+	circular_buffer<std::string>	s(3, false);
+	s.push_back("a");
+	s.push_back("b");
+	s.push_front("c");
+	try {
+		s.push_back("d");
+	} catch (std::length_error &e) {
+		std::cout << "[length_error]" << std::endl;
+	}
+	display("[strings]", s);
+
+	std::cout << "[#### copy / capacity ####]" << std::endl;
+	circular_buffer<int>	copy(b);
+	copy.pop_front();
+	copy.push_back(7);
+	display("[copy]", copy);
+	display("[original]", b);
+	copy.set_capacity(2);
+	display("[shrunk]", copy);
+	copy.set_capacity(4);
+	copy.push_back(8);
+	display("[grown]", copy);
+	copy = b;
+	copy.clear();
+	display("[cleared]", copy);
+
+	std::cout << "[#### telemetry window ####]" << std::endl;
+	circular_buffer<int>	window(1024);
+	long					sum = 0;
+	for (int i = 0; i < SIZE * 10; i++) {
+		window.push_back(i % 1000);
+		if (i % 4096 == 0)
+			sum += linearize(window)[window.size() / 2];
+	}
+	std::cout << "[size] " << window.size() << " [sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,118 @@
+#ifndef _IS_TEST
+# include <map>
+# include <set>
+# include <string>
+# include <utility>
+namespace ft = std;
+typedef std::map<int, int>			compact_map;
+typedef std::set<std::string>		compact_set;
+typedef std::multiset<int>			compact_multiset;
+#else
+# include "../include/Map.hpp"
+# include "../include/Multiset.hpp"
+# include "../include/Set.hpp"
+# include <string>
+typedef ft::map<int, int, std::less<int>,
+	std::allocator<ft::pair<const int, int> >, ft::compact_nodes>	compact_map;
+typedef ft::set<std::string, std::less<std::string>,
+	std::allocator<std::string>, ft::compact_nodes>					compact_set;
+typedef ft::multiset<int, std::less<int>, std::allocator<int>,
+	ft::compact_nodes>												compact_multiset;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#define SIZE 1000000
+
+template <typename Map>
+void	print(const Map &m) {
+	std::cout << "[size] " << m.size() << " |";
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << ' ' << it->first << ':' << it->second;
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### basics ####]" << std::endl;
+	compact_map	m;
+	std::cout << "[empty] " << m.empty() << ' ' << (m.begin() == m.end())
+		<< ' ' << (m.find(3) == m.end()) << ' ' << m.count(3) << std::endl;
+	for (int i = 0; i < 20; i++)
+		m.insert(ft::make_pair((i * 7) % 20, i));
+	print(m);
+	std::cout << "[dup] " << m.insert(ft::make_pair(7, 0)).second
+		<< " [hint] " << m.insert(m.end(), ft::make_pair(25, 25))->first << std::endl;
+	m[30] = 30;
+	m[3] += 100;
+	std::cout << "[bounds] " << m.lower_bound(21)->first << ' '
+		<< m.upper_bound(7)->first << ' '
+		<< (m.equal_range(4).first == m.find(4)) << std::endl;
+	m.erase(m.begin());
+	m.erase(5);
+	m.erase(m.find(10), m.find(14));
+	print(m);
+	compact_multiset	multi;
+	std::cout << "[multi empty] " << multi.count(3);
+	for (int i = 0; i < 12; i++)
+		multi.insert(i % 4);
+	std::cout << " [count] " << multi.count(3) << ' ' << multi.count(9) << std::endl;
+
+	std::cout << "[#### copy, swap, reuse ####]" << std::endl;
+	compact_map	copy(m);
+	copy.erase(copy.begin(), copy.end());
+	std::cout << "[cleared] " << copy.size() << std::endl;
+	for (int i = 0; i < 5; i++)
+		copy[i * i] = i;
+	copy.swap(m);
+	print(m);
+	print(copy);
+	compact_map	assigned;
+	assigned = copy;
+	std::cout << "[==] " << (assigned == copy) << " [<] " << (m < copy)
+		<< std::endl;
+	for (compact_map::reverse_iterator it = assigned.rbegin(); it != assigned.rend(); ++it)
+		std::cout << it->first << ' ';
+	std::cout << std::endl;
+
+	std::cout << "[#### non trivial values ####]" << std::endl;
+	compact_set	words;
+	const char	*text[] = {"pear", "apple", "fig", "kiwi", "apple", "plum",
+		"date", "lime", "fig", "cherry", "grape", "melon", "peach", "quince",
+		"lemon", "mango", "olive", "guava", "papaya", "banana", "apricot"};
+	for (size_t i = 0; i < sizeof(text) / sizeof(*text); i++)
+		words.insert(text[i]);
+	words.erase("kiwi");
+	words.insert("kiwi fruit");
+	compact_set	more(words);
+	more.clear();
+	more.insert("zucchini");
+	for (compact_set::const_iterator it = words.begin(); it != words.end(); ++it)
+		std::cout << *it << ' ';
+	std::cout << "| " << *more.begin() << std::endl;
+
+	std::cout << "[#### churn ####]" << std::endl;
+	compact_map	big;
+	clock_t		t = clock();
+	srand(11);
+	for (int i = 0; i < SIZE; i++) {
+		int	k = rand() % (SIZE / 4);
+		if (rand() % 3)
+			big[k] += i;
+		else
+			big.erase(k);
+	}
+	long	sum = 0;
+	for (int i = 0; i < SIZE; i++) {
+		compact_map::const_iterator	it = big.find(rand() % (SIZE / 4));
+		if (it != big.end())
+			sum += it->second;
+	}
+	for (compact_map::iterator it = big.begin(); it != big.end(); ++it)
+		sum += it->first ^ it->second;
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[size] " << big.size() << " [sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,212 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <pthread.h>
+# include <queue>
+/// Mutex-wrapped std::queue, the baseline the lock-free queues replace.
+template <typename T> class locked_queue {
+public:
+	explicit locked_queue(size_t capacity) : cap(capacity) { pthread_mutex_init(&mutex, NULL); }
+	~locked_queue() { pthread_mutex_destroy(&mutex); }
+	bool try_push(const T &val) { return push_many(&val, 1) == 1; }
+	bool try_pop(T &out) { return pop_many(&out, 1) == 1; }
+	size_t push_many(const T *src, size_t n) {
+		pthread_mutex_lock(&mutex);
+		size_t	k = 0;
+		for (; k < n && q.size() < cap; k++)
+			q.push(src[k]);
+		pthread_mutex_unlock(&mutex);
+		return k;
+	}
+	size_t pop_many(T *dst, size_t n) {
+		pthread_mutex_lock(&mutex);
+		size_t	k = 0;
+		for (; k < n && !q.empty(); k++) {
+			dst[k] = q.front();
+			q.pop();
+		}
+		pthread_mutex_unlock(&mutex);
+		return k;
+	}
+	size_t size_approx() const { return q.size(); }
+
+private:
+	std::queue<T>	q;
+	size_t			cap;
+	pthread_mutex_t	mutex;
+};
+typedef locked_queue<long>	spsc;
+typedef locked_queue<long>	mpmc;
+#else
+# include "../include/ConcurrentQueue.hpp"
+typedef ft::spsc_queue<long>	spsc;
+typedef ft::mpmc_queue<long>	mpmc;
+#endif // _IS_TEST
+
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <sys/time.h>
+
+#define SIZE 1000000
+#define BATCH 32
+
+template <typename Queue> struct Job {
+	Queue	*queue;
+	long	items;
+	long	first;
+	bool	batch;
+	long	sum;
+	long	count;
+};
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+template <typename Queue> void *produce(void *arg) {
+	Job<Queue>	*job = static_cast<Job<Queue> *>(arg);
+	long		buf[BATCH];
+	for (long i = 0; i < job->items;) {
+		if (job->batch) {
+			long	n = std::min<long>(BATCH, job->items - i);
+			for (long j = 0; j < n; j++)
+				buf[j] = job->first + i + j;
+			for (long done = 0; done < n;) {
+				long	k = job->queue->push_many(buf + done, n - done);
+				if (!k)
+					sched_yield();
+				done += k;
+			}
+			i += n;
+		} else if (job->queue->try_push(job->first + i))
+			i++;
+		else
+			sched_yield();
+	}
+	return NULL;
+}
+
+template <typename Queue> void *consume(void *arg) {
+	Job<Queue>	*job = static_cast<Job<Queue> *>(arg);
+	long		buf[BATCH];
+	while (job->count < job->items) {
+		long	k = 0;
+		if (job->batch)
+			k = job->queue->pop_many(buf, std::min<long>(BATCH, job->items - job->count));
+		else
+			k = job->queue->try_pop(buf[0]);
+		if (!k)
+			sched_yield();
+		for (long j = 0; j < k; j++)
+			job->sum += buf[j];
+		job->count += k;
+	}
+	return NULL;
+}
+
+/// Move SIZE items through queue with the given number of threads, the
+/// consumers split the items evenly. Checksums go to stdout, timings to stderr.
+template <typename Queue>
+void run(const std::string &title, Queue &queue, int producers, int consumers, bool batch) {
+	const long	items = SIZE;
+	Job<Queue>	pjobs[8], cjobs[8];
+	pthread_t	threads[16];
+	double		start = now();
+	for (int i = 0; i < consumers; i++) {
+		Job<Queue>	job = { &queue, items / consumers + (i < items % consumers), 0, batch, 0, 0 };
+		cjobs[i] = job;
+		pthread_create(&threads[producers + i], NULL, consume<Queue>, &cjobs[i]);
+	}
+	for (int i = 0; i < producers; i++) {
+		long		share = items / producers + (i < items % producers);
+		Job<Queue>	job = { &queue, share, i * (items / producers + 1), batch, 0, 0 };
+		pjobs[i] = job;
+		pthread_create(&threads[i], NULL, produce<Queue>, &pjobs[i]);
+	}
+	for (int i = 0; i < producers + consumers; i++)
+		pthread_join(threads[i], NULL);
+	double	elapsed = now() - start;
+	long	sum = 0, count = 0;
+	for (int i = 0; i < consumers; i++) {
+		sum += cjobs[i].sum;
+		count += cjobs[i].count;
+	}
+	std::cout << title << ' ' << producers << "p/" << consumers << "c" << (batch ? " batch" : "")
+		<< " [count] " << count << " [sum] " << sum << " [left] " << queue.size_approx() << std::endl;
+	std::cerr << title << ' ' << producers << "p/" << consumers << "c" << (batch ? " batch" : "")
+		<< ": " << long(items / elapsed) << " items/s" << std::endl;
+}
+
+/// Ping-pong over two spsc queues, prints the round trip time to stderr.
+struct PingPong {
+	spsc	*to;
+	spsc	*from;
+	long	rounds;
+};
+
+void *pong(void *arg) {
+	PingPong	*p = static_cast<PingPong *>(arg);
+	long		val;
+	for (long i = 0; i < p->rounds; i++) {
+		while (!p->to->try_pop(val))
+			sched_yield();
+		while (!p->from->try_push(val + 1))
+			sched_yield();
+	}
+	return NULL;
+}
+
+int main() {
+	std::cout << "[#### Testing concurrent queues ####]" << std::endl;
+	{
+		spsc	q(4);
+		long	vals[] = { 1, 2, 3, 4, 5, 6 };
+		std::cout << "[push] " << q.try_push(0) << " [push_many] " << q.push_many(vals, 6) << std::endl;
+		long	out[8];
+		long	v = -1;
+		std::cout << "[pop] " << q.try_pop(v) << ' ' << v << " [pop_many] " << q.pop_many(out, 8);
+		std::cout << " [values] " << out[0] << out[1] << out[2] << " [empty pop] " << q.try_pop(v) << std::endl;
+	}
+	{
+		mpmc	q(8);
+		long	vals[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		std::cout << "[push_many] " << q.push_many(vals, 10) << " [size] " << q.size_approx() << std::endl;
+		long	out[4];
+		std::cout << "[pop_many] " << q.pop_many(out, 4) << " [values] " << out[0] << out[3];
+		std::cout << " [push_many] " << q.push_many(vals, 10) << " [size] " << q.size_approx() << std::endl;
+	}
+
+	std::cout << "[#### throughput ####]" << std::endl;
+	{
+		spsc	q(1024);
+		run("[spsc]", q, 1, 1, false);
+		run("[spsc]", q, 1, 1, true);
+	}
+	const int	configs[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 1, 4 }, { 4, 1 }, { 8, 8 } };
+	for (size_t i = 0; i < sizeof(configs) / sizeof(*configs); i++) {
+		mpmc	q(1024);
+		run("[mpmc]", q, configs[i][0], configs[i][1], false);
+		run("[mpmc]", q, configs[i][0], configs[i][1], true);
+	}
+
+	std::cout << "[#### latency ####]" << std::endl;
+	spsc		to(2), from(2);
+	PingPong	p = { &to, &from, SIZE / 10 };
+	pthread_t	thread;
+	long		val = 0;
+	double		start = now();
+	pthread_create(&thread, NULL, pong, &p);
+	for (long i = 0; i < p.rounds; i++) {
+		while (!to.try_push(val))
+			sched_yield();
+		while (!from.try_pop(val))
+			sched_yield();
+	}
+	pthread_join(thread, NULL);
+	std::cerr << "[spsc] round trip: " << (now() - start) / p.rounds * 1e9 << " ns" << std::endl;
+	std::cout << "[rounds] " << p.rounds << " [value] " << val << std::endl;
+	return 0;
+}
@@ -0,0 +1,127 @@
+#ifndef _IS_TEST
+# include <stack>
+namespace ft = std;
+#else
+# include "../include/ConcurrentStack.hpp"
+# include "../include/Stack.hpp"
+#endif // _IS_TEST
+
+#include <iostream>
+#include <pthread.h>
+#include <string>
+#include <sys/time.h>
+
+#define SIZE 1000000
+
+/// Mutex-wrapped stack adapter, the baseline the lock-free stack replaces.
+template <typename T> class locked_stack {
+public:
+	locked_stack() { pthread_mutex_init(&mutex, NULL); }
+	~locked_stack() { pthread_mutex_destroy(&mutex); }
+	void push(const T &val) {
+		pthread_mutex_lock(&mutex);
+		s.push(val);
+		pthread_mutex_unlock(&mutex);
+	}
+	bool try_pop(T &out) {
+		pthread_mutex_lock(&mutex);
+		bool	ok = !s.empty();
+		if (ok) {
+			out = s.top();
+			s.pop();
+		}
+		pthread_mutex_unlock(&mutex);
+		return ok;
+	}
+	void reserve(size_t) {}
+
+private:
+	ft::stack<T>	s;
+	pthread_mutex_t	mutex;
+};
+
+#ifdef _IS_TEST
+typedef ft::concurrent_stack<long>	lockfree_stack;
+#else
+typedef locked_stack<long>	lockfree_stack;
+#endif
+
+template <typename Stack> struct Job {
+	Stack	*stack;
+	long	first;
+	long	items;
+	long	popped;
+	long	sum;
+};
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+/// Push/pop pairs, every thread pushes its own values and pops whatever is on top.
+template <typename Stack> void *work(void *arg) {
+	Job<Stack>	*job = static_cast<Job<Stack> *>(arg);
+	long		val;
+	for (long i = 0; i < job->items; i++) {
+		job->stack->push(job->first + i);
+		if (i % 4 != 3 && job->stack->try_pop(val)) {
+			job->popped++;
+			job->sum += val;
+		}
+	}
+	return NULL;
+}
+
+template <typename Stack>
+void run(const std::string &title, int threads) {
+	Stack		stack;
+	Job<Stack>	jobs[16];
+	pthread_t	ids[16];
+	double		start = now();
+	for (int i = 0; i < threads; i++) {
+		Job<Stack>	job = { &stack, long(i) * SIZE, SIZE / threads, 0, 0 };
+		jobs[i] = job;
+		pthread_create(&ids[i], NULL, work<Stack>, &jobs[i]);
+	}
+	long	popped = 0, sum = 0, val;
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+		popped += jobs[i].popped;
+		sum += jobs[i].sum;
+	}
+	double	elapsed = now() - start;
+	while (stack.try_pop(val)) {
+		popped++;
+		sum += val;
+	}
+	std::cout << title << ' ' << threads << " threads [popped] " << popped << " [sum] " << sum << std::endl;
+	std::cerr << title << ' ' << threads << " threads: " << long(2 * SIZE / elapsed) << " ops/s" << std::endl;
+}
+
+int main() {
+	std::cout << "[#### Testing concurrent_stack ####]" << std::endl;
+	lockfree_stack	s;
+	long			val = -1;
+	std::cout << "[empty pop] " << s.try_pop(val) << ' ' << val << std::endl;
+	s.reserve(1000);
+	for (long i = 0; i < 300; i++)
+		s.push(i);
+	long	sum = 0;
+	for (int i = 0; i < 3; i++) {
+		s.try_pop(val);
+		std::cout << "[pop] " << val << std::endl;
+	}
+	while (s.try_pop(val))
+		sum += val;
+	std::cout << "[sum] " << sum << std::endl;
+
+	std::cout << "[#### contention ####]" << std::endl;
+	const int	threads[] = { 1, 2, 4, 8, 16 };
+	for (size_t i = 0; i < sizeof(threads) / sizeof(*threads); i++) {
+		run<lockfree_stack>("[lock-free]", threads[i]);
+		run<locked_stack<long> >("[mutex stack]", threads[i]);
+	}
+	return 0;
+}
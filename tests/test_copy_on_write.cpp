@@ -0,0 +1,113 @@
+#ifndef _IS_TEST
+# include <map>
+# include <string>
+# include <utility>
+# include <vector>
+namespace ft = std;
+/// Deep copies, what the copy-on-write wrapper replaces.
+template <typename Container>
+class copy_on_write {
+public:
+	copy_on_write() : value() {}
+	explicit copy_on_write(const Container &c) : value(c) {}
+	const Container	&operator*() const { return value; }
+	const Container	*operator->() const { return &value; }
+	const Container	&read() const { return value; }
+	Container		&write() { return value; }
+	friend bool	operator==(const copy_on_write &x, const copy_on_write &y) {
+		return x.value == y.value;
+	}
+private:
+	Container	value;
+};
+#else
+# include "../include/CopyOnWrite.hpp"
+# include "../include/Map.hpp"
+# include "../include/Vector.hpp"
+# include <string>
+using ft::copy_on_write;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#define SIZE 20000
+
+typedef copy_on_write<ft::vector<int> >				cow_vector;
+typedef copy_on_write<ft::map<std::string, int> >	cow_map;
+
+void	print(const cow_vector &v) {
+	std::cout << "[size] " << v->size() << " |";
+	for (ft::vector<int>::const_iterator it = v->begin(); it != v->end(); ++it)
+		std::cout << ' ' << *it;
+	std::cout << std::endl;
+}
+
+long	lookup(cow_map config, const std::string &k) {
+	ft::map<std::string, int>::const_iterator	it = config->find(k);
+	return it == config->end() ? -1 : it->second;
+}
+
+int main() {
+	std::cout << "[#### vector ####]" << std::endl;
+	cow_vector	a;
+	for (int i = 0; i < 8; i++)
+		a.write().push_back(i * i);
+	cow_vector	b(a);
+	cow_vector	c;
+	c = b;
+	b.write()[0] = 100;
+	c.write().pop_back();
+	print(a);
+	print(b);
+	print(c);
+	std::cout << "[==] " << (a == cow_vector(a)) << ' ' << (a == b) << ' '
+		<< (a.read() == *cow_vector(*a)) << std::endl;
+
+	std::cout << "[#### map ####]" << std::endl;
+	ft::map<std::string, int>	base;
+	base["threads"] = 8;
+	base["retries"] = 3;
+	base["timeout"] = 30;
+	cow_map		config(base);
+	cow_map		tuned(config);
+	tuned.write()["timeout"] = 5;
+	tuned.write().erase("retries");
+	std::cout << "[config] " << lookup(config, "timeout") << ' ' << lookup(config, "retries")
+		<< " [tuned] " << lookup(tuned, "timeout") << ' ' << lookup(tuned, "retries")
+		<< ' ' << tuned->size() << std::endl;
+
+	std::cout << "[#### read-only copies ####]" << std::endl;
+	ft::map<std::string, int>	table;
+	ft::vector<int>				values;
+	for (int i = 0; i < SIZE; i++) {
+		char	name[16];
+		name[0] = 'k';
+		int		n = i;
+		int		len = 1;
+		for (; n; n /= 10)
+			name[len++] = char('0' + n % 10);
+		name[len] = '\0';
+		table[name] = i;
+		values.push_back(i);
+	}
+	cow_map		shared(table);
+	cow_vector	shared_values(values);
+	clock_t		t = clock();
+	long		sum = 0;
+	for (int i = 0; i < 1000; i++) {
+		// Handed by value to every request, never written.
+		sum += lookup(shared, "k7");
+		cow_vector	view(shared_values);
+		sum += (*view)[i];
+		if (i % 500 == 0) {
+			cow_vector	edited(shared_values);
+			edited.write()[i] = -1;
+			sum += (*edited)[i] + (*shared_values)[i];
+		}
+	}
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,146 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <memory>
+# include <vector>
+namespace ft {
+	using std::vector;
+	template <typename T, size_t Threshold = (size_t(1) << 26)>
+	class first_touch_allocator : public std::allocator<T> {
+	public:
+		template <typename U> struct rebind { typedef first_touch_allocator<U, Threshold> other; };
+		first_touch_allocator() {}
+		template <typename U> first_touch_allocator(const first_touch_allocator<U, Threshold> &) {}
+	};
+	namespace parallel {
+		inline void set_thread_count(size_t) {}
+	}
+}
+#else
+# include "../include/FirstTouchAllocator.hpp"
+# include "../include/Vector.hpp"
+#endif // _IS_TEST
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/time.h>
+
+#define SIZE (1 << 25)
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+/// Counts live objects, the copy that brings copies_left to 0 throws.
+struct Tracked {
+	static long	live;
+	static long	copies_left;
+	long		value;
+
+	Tracked(long v = 0) : value(v) { ++live; }
+	Tracked(const Tracked &x) : value(x.value) {
+		if (__atomic_sub_fetch(&copies_left, 1, __ATOMIC_RELAXED) == 0)
+			throw std::runtime_error("copy");
+		__atomic_add_fetch(&live, 1, __ATOMIC_RELAXED);
+	}
+	~Tracked() { __atomic_sub_fetch(&live, 1, __ATOMIC_RELAXED); }
+	Tracked &operator=(const Tracked &x) {
+		value = x.value;
+		return *this;
+	}
+};
+long	Tracked::live = 0;
+long	Tracked::copies_left = -1;
+
+template <typename Vec>
+unsigned long checksum(const Vec &v) {
+	unsigned long	sum = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+		sum = sum * 31 + (unsigned long)v[i];
+	return sum;
+}
+
+/// A 4 KiB threshold takes the parallel paths on small vectors.
+void paths(size_t threads) {
+	typedef ft::vector<long, ft::first_touch_allocator<long, 4096> >	vec;
+	ft::parallel::set_thread_count(threads);
+
+	vec	a(100000, 7);
+	std::cout << "[threads] " << threads << " [fill] " << a.size() << ' ' << checksum(a);
+	for (size_t i = 0; i < a.size(); ++i)
+		a[i] = i * 3;
+	vec	b(a);
+	std::cout << " [copy] " << checksum(b);
+	b.assign(300000, 5);
+	std::cout << " [assign] " << b.size() << ' ' << checksum(b);
+	b.assign(200000, 6);
+	std::cout << ' ' << b.size() << ' ' << checksum(b);
+	b.assign(250000, 8);
+	std::cout << ' ' << b.size() << ' ' << checksum(b);
+	b = a;
+	std::cout << " [operator=] " << checksum(b);
+	b.clear();
+	std::cout << " [clear] " << b.size() << std::endl;
+
+	typedef ft::vector<std::string, ft::first_touch_allocator<std::string, 4096> >	strings;
+	strings	s(50000, std::string("a string too long for the small buffer"));
+	s[123] = "x";
+	strings	t(s);
+	t.assign(70000, std::string("b"));
+	std::cout << "[strings] " << s.size() << ' ' << s[123] << ' ' << s[124].size()
+		<< ' ' << t.size() << ' ' << t[69999] << std::endl;
+}
+
+void exceptions(size_t threads) {
+	typedef ft::vector<Tracked, ft::first_touch_allocator<Tracked, 4096> >	vec;
+	ft::parallel::set_thread_count(threads);
+	{
+		vec	a(60000, Tracked(1));
+		Tracked::copies_left = 45000;
+		try {
+			vec	b(a);
+			std::cout << "no throw" << std::endl;
+		} catch (const std::exception &) {
+			std::cout << "[copy threw] live " << Tracked::live;
+		}
+		Tracked::copies_left = 30000;
+		try {
+			vec	c(80000, Tracked(2));
+			std::cout << "no throw" << std::endl;
+		} catch (const std::exception &) {
+			std::cout << " [fill threw] live " << Tracked::live;
+		}
+		Tracked::copies_left = -1;
+	}
+	std::cout << " [after] live " << Tracked::live << std::endl;
+}
+
+void bench() {
+	ft::parallel::set_thread_count(4);
+	double	start = now();
+	{
+		ft::vector<int, ft::first_touch_allocator<int> >	v(SIZE, 1);
+		ft::vector<int, ft::first_touch_allocator<int> >	w(v);
+		std::cout << "[bench] " << v.size() << ' ' << w[SIZE - 1] << std::endl;
+	}
+	double	mid = now();
+	{
+		ft::vector<int>	v(SIZE, 1);
+		ft::vector<int>	w(v);
+	}
+	std::cerr << "fill + copy " << SIZE << " ints: first touch " << mid - start
+		<< "s, plain " << now() - mid << "s" << std::endl;
+}
+
+int main() {
+	size_t	threads[] = { 1, 2, 4, 7 };
+
+	for (size_t i = 0; i < 4; ++i) {
+		paths(threads[i]);
+		exceptions(threads[i]);
+	}
+	bench();
+	return 0;
+}
@@ -0,0 +1,162 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <vector>
+template <typename T> class gap_vector : public std::vector<T> {
+public:
+	gap_vector() {}
+	explicit gap_vector(size_t n, const T &val = T()) : std::vector<T>(n, val) {}
+	template <typename It>
+	gap_vector(It first, It last) : std::vector<T>(first, last) {}
+};
+#else
+# include "../include/GapVector.hpp"
+using ft::gap_vector;
+#endif // _IS_TEST
+
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define SIZE 1000000
+
+template <typename Vec>
+void display(const std::string &title, const Vec &v) {
+	std::cout << title << " [size] " << v.size() << " [values]";
+	for (typename Vec::const_iterator it = v.begin(); it != v.end(); ++it)
+		std::cout << ' ' << *it;
+	std::cout << std::endl;
+}
+
+/// Bulk read of the whole sequence, the two runs around the gap for ft.
+template <typename T>
+std::vector<T> linearize(const gap_vector<T> &v) {
+	std::vector<T>	out;
+#ifdef _IS_TEST
+	typename gap_vector<T>::const_array_range	one = v.array_one();
+	typename gap_vector<T>::const_array_range	two = v.array_two();
+	out.insert(out.end(), one.first, one.first + one.second);
+	out.insert(out.end(), two.first, two.first + two.second);
+#else
+	out.assign(v.begin(), v.end());
+#endif
+	return out;
+}
+
+/// Types at a moving cursor: mostly inserts, some backspaces and jumps.
+template <typename Vec>
+unsigned long edit(Vec &text, int keys) {
+	size_t			cursor = text.size() / 2;
+	unsigned long	seed = 42;
+	for (int i = 0; i < keys; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		unsigned	r = unsigned(seed >> 33);
+		if (r % 1000 == 0)
+			cursor = r % (text.size() + 1);
+		else if (r % 7 == 0 && cursor > 0) {
+			text.erase(text.begin() + (cursor - 1));
+			--cursor;
+		} else {
+			text.insert(text.begin() + cursor, char('a' + r % 26));
+			++cursor;
+		}
+	}
+	unsigned long	hash = 0;
+	for (size_t i = 0; i < text.size(); i++)
+		hash = hash * 31 + text[i];
+	return hash;
+}
+
+int main() {
+	std::cout << "[#### Testing gap_vector ####]" << std::endl;
+	gap_vector<int>	v;
+	display("[empty]", v);
+	for (int i = 0; i < 8; i++)
+		v.push_back(i);
+	display("[push_back]", v);
+	v.insert(v.begin() + 3, 42);
+	v.insert(v.begin() + 4, 43);
+	display("[insert middle]", v);
+	v.insert(v.begin(), 2, -1);
+	display("[insert n front]", v);
+	v.erase(v.begin() + 8);
+	display("[erase]", v);
+	v.erase(v.begin() + 1, v.begin() + 4);
+	display("[erase range]", v);
+	v.insert(v.end(), 100);
+	v.pop_back();
+	v.pop_back();
+	display("[pop_back]", v);
+	std::cout << "[front] " << v[0] << " [back] " << v[v.size() - 1]
+		<< " [at] " << v.at(2) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (std::out_of_range &e) {
+		std::cout << "[out_of_range]" << std::endl;
+	}
+
+	std::cout << "[#### iterators ####]" << std::endl;
+	v.insert(v.begin() + 2, 7);
+	gap_vector<int>::iterator	it = v.begin() + 3;
+	std::cout << "[it] " << *it << ' ' << it[-1] << ' ' << (v.end() - it) << std::endl;
+	*it = 99;
+	for (gap_vector<int>::reverse_iterator r = v.rbegin(); r != v.rend(); ++r)
+		std::cout << *r << ' ';
+	std::cout << std::endl;
+	std::vector<int>	lin = linearize(v);
+	std::cout << "[linearized]";
+	for (size_t i = 0; i < lin.size(); i++)
+		std::cout << ' ' << lin[i];
+	std::cout << std::endl;
+	int					arr[] = {5, 6, 7};
+	v.insert(v.begin() + 1, arr, arr + 3);
+	display("[insert range]", v);
+
+	std::cout << "[#### strings ####]" << std::endl;
+	gap_vector<std::string>	s(3, "x");
+	s.insert(s.begin() + 1, "a");
+	s.insert(s.begin() + 3, "b");
+	for (int i = 0; i < 20; i++)
+		s.insert(s.begin() + 2, std::string(i % 5 + 1, char('c' + i % 3)));
+	s.erase(s.begin() + 4, s.begin() + 10);
+	s.insert(s.begin() + s.size(), s[0]);
+	s.insert(s.begin(), s[3]);
+	display("[strings]", s);
+	// Elements of the vector itself, moved by the gap before being copied.
+	gap_vector<int>	self;
+	for (int i = 0; i < 15; i++)
+		self.push_back(i);
+	self.insert(self.begin(), self[5]);
+	self.insert(self.begin() + 12, self[2]);
+	self.insert(self.begin() + 3, self[14]);
+	display("[self insert]", self);
+
+	std::cout << "[#### copy / assign ####]" << std::endl;
+	gap_vector<int>	copy(v);
+	copy.erase(copy.begin());
+	copy.insert(copy.begin() + 2, 8);
+	display("[copy]", copy);
+	display("[original]", v);
+	std::cout << "[equal] " << (copy == v) << std::endl;
+	copy = v;
+	std::cout << "[equal] " << (copy == v) << std::endl;
+	gap_vector<int>	range(lin.begin(), lin.end());
+	range.swap(copy);
+	display("[swapped]", range);
+	copy.clear();
+	display("[cleared]", copy);
+
+	std::cout << "[#### editor ####]" << std::endl;
+	std::string			seed(SIZE, '.');
+	gap_vector<char>	text(seed.begin(), seed.end());
+	std::vector<char>	plain(seed.begin(), seed.end());
+	clock_t				t = clock();
+	unsigned long		h1 = edit(text, SIZE / 5);
+	std::cerr << "[gap_vector] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	t = clock();
+	unsigned long		h2 = edit(plain, SIZE / 5);
+	std::cerr << "[vector] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[size] " << text.size() << " [hash] " << h1 << " [same] " << (h1 == h2) << std::endl;
+	return 0;
+}
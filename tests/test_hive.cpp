@@ -0,0 +1,123 @@
+#ifndef _IS_TEST
+# include <list>
+template <typename T> class hive : public std::list<T> {
+public:
+	typedef typename std::list<T>::iterator			iterator;
+	typedef typename std::list<T>::const_iterator	const_iterator;
+
+	iterator insert(const T &val) { return std::list<T>::insert(this->end(), val); }
+	iterator get_iterator(const T *p) {
+		for (iterator it = this->begin(); it != this->end(); ++it)
+			if (&*it == p)
+				return it;
+		return this->end();
+	}
+};
+#else
+# include "../include/Hive.hpp"
+using ft::hive;
+#endif // _IS_TEST
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define SIZE 1000000
+
+struct Counted {
+	static int	live;
+	int			value;
+
+	Counted(int v = 0) : value(v) { ++live; }
+	Counted(const Counted &other) : value(other.value) { ++live; }
+	~Counted() { --live; }
+	bool operator==(const Counted &rhs) const { return value == rhs.value; }
+};
+int Counted::live = 0;
+
+template <typename Hive>
+void print_sorted(const std::string &title, const Hive &h) {
+	std::vector<int>	values;
+	for (typename Hive::const_iterator it = h.begin(); it != h.end(); ++it)
+		values.push_back(*it);
+	std::sort(values.begin(), values.end());
+	std::cout << title << " [size] " << h.size() << " [values]";
+	for (size_t i = 0; i < values.size(); i++)
+		std::cout << ' ' << values[i];
+	std::cout << std::endl;
+}
+
+int main() {
+	srand(42);
+
+	std::cout << "[#### Testing hive ####]" << std::endl;
+	hive<int>	h;
+	std::cout << "[empty] " << h.empty() << std::endl;
+
+	std::vector<int *>	ptrs;
+	for (int i = 0; i < 20; i++)
+		ptrs.push_back(&*h.insert(i * 10));
+	print_sorted("[insert]", h);
+
+	// Erase every third element while iterating.
+	int n = 0;
+	for (hive<int>::iterator it = h.begin(); it != h.end(); n++) {
+		if (n % 3 == 0)
+			it = h.erase(it);
+		else
+			++it;
+	}
+	print_sorted("[erase]", h);
+
+	// Holes get refilled, the survivors never move.
+	for (int i = 0; i < 500; i++)
+		h.insert(1000 + i);
+	bool stable = true;
+	for (size_t i = 0; i < ptrs.size(); i++)
+		if (i % 3 != 0 && *ptrs[i] != static_cast<int>(i) * 10)
+			stable = false;
+	std::cout << "[stable] " << stable << std::endl;
+	std::cout << "[get_iterator] " << *h.get_iterator(ptrs[4]) << std::endl;
+
+	long sum = 0, rsum = 0;
+	for (hive<int>::iterator it = h.begin(); it != h.end(); ++it)
+		sum += *it;
+	for (hive<int>::reverse_iterator it = h.rbegin(); it != h.rend(); ++it)
+		rsum += *it;
+	std::cout << "[sum] " << sum << " [rsum] " << rsum << std::endl;
+
+	hive<int>	copy(h);
+	std::cout << "[copy] " << (copy == h) << " [size] " << copy.size() << std::endl;
+	h.erase(h.begin(), h.end());
+	std::cout << "[erase all] " << h.empty() << " " << (h.begin() == h.end()) << std::endl;
+	h.swap(copy);
+	std::cout << "[swap] " << h.size() << " " << copy.size() << std::endl;
+	h.clear();
+	print_sorted("[clear]", h);
+
+	// Random churn.
+	{
+		hive<Counted>	c;
+		for (int i = 0; i < SIZE; i++)
+			c.insert(Counted(i));
+		long total = 0;
+		for (int round = 0; round < 4; round++) {
+			for (hive<Counted>::iterator it = c.begin(); it != c.end();) {
+				if ((it->value + round) % 3 == 0)
+					it = c.erase(it);
+				else
+					++it;
+			}
+			for (int i = 0; i < SIZE / 4; i++)
+				c.insert(Counted(rand() % 1000));
+		}
+		for (hive<Counted>::const_iterator it = c.begin(); it != c.end(); ++it)
+			total += it->value;
+		std::cout << "[churn] [size] " << c.size() << " [total] " << total
+				  << " [live] " << Counted::live << std::endl;
+	}
+	std::cout << "[live after destruction] " << Counted::live << std::endl;
+	return 0;
+}
@@ -0,0 +1,129 @@
+#ifndef _IS_TEST
+# include <map>
+# include <utility>
+namespace ft = std;
+/// Skips the intervals not overlapping [lo, hi]: the full scan it replaces.
+template <typename It>
+struct OverlapIterator {
+	OverlapIterator(It first, It last, int lo, int hi)
+		: cur(first), last(last), lo(lo), hi(hi) { skip(); }
+	typename std::iterator_traits<It>::reference	operator*() const { return *cur; }
+	typename std::iterator_traits<It>::pointer		operator->() const { return &*cur; }
+	OverlapIterator	&operator++() {
+		++cur;
+		skip();
+		return *this;
+	}
+	bool	operator==(const OverlapIterator &o) const { return cur == o.cur; }
+	bool	operator!=(const OverlapIterator &o) const { return cur != o.cur; }
+	void	skip() {
+		while (cur != last && (hi < cur->first.first || cur->first.second < lo))
+			++cur;
+	}
+	It	cur;
+	It	last;
+	int	lo;
+	int	hi;
+};
+class IntervalMap : public std::multimap<std::pair<int, int>, int> {
+public:
+	typedef OverlapIterator<iterator>		overlap_iterator;
+	typedef OverlapIterator<const_iterator>	const_overlap_iterator;
+	iterator	insert(int lo, int hi, int x) {
+		return std::multimap<std::pair<int, int>, int>::insert(
+			std::make_pair(std::make_pair(lo, hi), x));
+	}
+	std::pair<overlap_iterator, overlap_iterator>	overlapping(int lo, int hi) {
+		return std::make_pair(overlap_iterator(begin(), end(), lo, hi),
+			overlap_iterator(end(), end(), lo, hi));
+	}
+	std::pair<const_overlap_iterator, const_overlap_iterator>	overlapping(int lo, int hi) const {
+		return std::make_pair(const_overlap_iterator(begin(), end(), lo, hi),
+			const_overlap_iterator(end(), end(), lo, hi));
+	}
+	std::pair<overlap_iterator, overlap_iterator>	stabbing(int p) { return overlapping(p, p); }
+	std::pair<const_overlap_iterator, const_overlap_iterator>	stabbing(int p) const {
+		return overlapping(p, p);
+	}
+	bool	overlaps(int lo, int hi) const {
+		return overlapping(lo, hi).first != overlapping(lo, hi).second;
+	}
+};
+#else
+# include "../include/IntervalMap.hpp"
+typedef ft::interval_map<int, int>	IntervalMap;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#define SIZE 50000
+
+template <typename Range>
+void	print(const char *name, Range r) {
+	std::cout << '[' << name << ']';
+	for (; r.first != r.second; ++r.first)
+		std::cout << " [" << r.first->first.first << ',' << r.first->first.second
+			<< "]:" << r.first->second;
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### queries ####]" << std::endl;
+	IntervalMap	m;
+	print("empty", m.stabbing(3));
+	for (int i = 0; i < 30; i++) {
+		int	lo = (i * 17) % 60;
+		m.insert(lo, lo + i % 7, i);
+	}
+	m.insert(34, 34, 100);
+	m.insert(34, 34, 101);
+	m.insert(0, 100, 102);
+	std::cout << "[size] " << m.size() << " [count] " << m.count(ft::make_pair(34, 34))
+		<< std::endl;
+	print("stab 5", m.stabbing(5));
+	print("stab 34", m.stabbing(34));
+	print("[20,30]", m.overlapping(20, 30));
+	print("[-5,-1]", m.overlapping(-5, -1));
+	print("[200,300]", m.overlapping(200, 300));
+	std::cout << "[overlaps] " << m.overlaps(-3, 0) << ' ' << m.overlaps(101, 105)
+		<< std::endl;
+
+	std::cout << "[#### updates ####]" << std::endl;
+	for (IntervalMap::overlap_iterator it = m.stabbing(34).first;
+			it != m.stabbing(34).second; ++it)
+		it->second += 1000;
+	m.erase(ft::make_pair(0, 100));
+	m.erase(m.find(ft::make_pair(34, 34)));
+	m.erase(m.lower_bound(ft::make_pair(40, 0)), m.lower_bound(ft::make_pair(50, 0)));
+	const IntervalMap	copy(m);
+	print("stab 34", copy.stabbing(34));
+	print("[38,52]", copy.overlapping(38, 52));
+	print("stab 5", copy.stabbing(5));
+	m.clear();
+	print("cleared", m.overlapping(0, 100));
+
+	std::cout << "[#### random intervals ####]" << std::endl;
+	IntervalMap	big;
+	clock_t		t = clock();
+	srand(17);
+	for (int i = 0; i < SIZE; i++) {
+		int	lo = rand() % (SIZE * 10);
+		// Mostly short intervals with a few long ones.
+		int	len = rand() % 8 ? rand() % 20 : rand() % 2000;
+		big.insert(lo, lo + len, i);
+	}
+	long	sum = 0;
+	long	hits = 0;
+	for (int i = 0; i < 1000; i++) {
+		int	p = rand() % (SIZE * 10);
+		ft::pair<IntervalMap::overlap_iterator, IntervalMap::overlap_iterator>	r
+			= i % 2 ? big.stabbing(p) : big.overlapping(p, p + 50);
+		for (; r.first != r.second; ++r.first, ++hits)
+			sum += r.first->second;
+	}
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[hits] " << hits << " [sum] " << sum << std::endl;
+	return 0;
+}
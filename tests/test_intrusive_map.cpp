@@ -0,0 +1,185 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <functional>
+# include <map>
+# include <utility>
+template <typename Tag> struct intrusive_map_hook {};
+template <typename It, typename T> struct IntrusiveIt {
+	It	it;
+	IntrusiveIt() {}
+	IntrusiveIt(It i) : it(i) {}
+	template <typename I2, typename T2>
+	IntrusiveIt(const IntrusiveIt<I2, T2> &o) : it(o.it) {}
+	T &operator*() const { return *it->second; }
+	T *operator->() const { return it->second; }
+	IntrusiveIt &operator++() { ++it; return *this; }
+	IntrusiveIt &operator--() { --it; return *this; }
+	bool operator==(const IntrusiveIt &o) const { return it == o.it; }
+	bool operator!=(const IntrusiveIt &o) const { return it != o.it; }
+};
+/// Index of pointers: the objects stay where they are, like the hooks.
+template <typename Key, typename T, typename Tag, typename KeyOfValue,
+	typename Compare = std::less<Key> >
+class intrusive_map {
+	typedef std::map<Key, T *, Compare>	Tree;
+	Tree	tree;
+public:
+	typedef IntrusiveIt<typename Tree::iterator, T>				iterator;
+	typedef IntrusiveIt<typename Tree::const_iterator, const T>	const_iterator;
+	typedef std::reverse_iterator<typename Tree::iterator>		tree_reverse;
+
+	iterator begin() { return tree.begin(); }
+	iterator end() { return tree.end(); }
+	const_iterator begin() const { return tree.begin(); }
+	const_iterator end() const { return tree.end(); }
+	bool empty() const { return tree.empty(); }
+	size_t size() const { return tree.size(); }
+	std::pair<iterator, bool> insert(T &obj) {
+		std::pair<typename Tree::iterator, bool> r =
+			tree.insert(std::make_pair(KeyOfValue()(obj), &obj));
+		return std::pair<iterator, bool>(r.first, r.second);
+	}
+	iterator erase(iterator pos) { tree.erase(pos.it++); return pos; }
+	void erase(T &obj) { tree.erase(KeyOfValue()(obj)); }
+	size_t erase(const Key &k) { return tree.erase(k); }
+	void clear() { tree.clear(); }
+	void swap(intrusive_map &o) { tree.swap(o.tree); }
+	iterator find(const Key &k) { return tree.find(k); }
+	const_iterator find(const Key &k) const { return tree.find(k); }
+	size_t count(const Key &k) const { return tree.count(k); }
+	iterator lower_bound(const Key &k) { return tree.lower_bound(k); }
+	iterator upper_bound(const Key &k) { return tree.upper_bound(k); }
+	iterator iterator_to(T &obj) { return tree.find(KeyOfValue()(obj)); }
+};
+using std::pair;
+#else
+# include "../include/IntrusiveMap.hpp"
+using ft::intrusive_map;
+using ft::intrusive_map_hook;
+using ft::pair;
+#endif // _IS_TEST
+
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define SIZE 1000000
+
+struct IdHook {};
+struct PriceHook {};
+
+struct Order : intrusive_map_hook<IdHook>, intrusive_map_hook<PriceHook> {
+	int			id;
+	int			price;
+	std::string	name;
+};
+
+struct IdOf {
+	const int &operator()(const Order &o) const { return o.id; }
+};
+struct PriceOf {
+	const int &operator()(const Order &o) const { return o.price; }
+};
+
+typedef intrusive_map<int, Order, IdHook, IdOf>								ById;
+typedef intrusive_map<int, Order, PriceHook, PriceOf, std::greater<int> >	ByPrice;
+
+template <typename Map>
+void display(const std::string &title, const Map &m) {
+	std::cout << title << " [size] " << m.size() << " [values]";
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << ' ' << it->id << ':' << it->price << ':' << it->name;
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### Testing intrusive_map ####]" << std::endl;
+	std::vector<Order>	pool(10);
+	const char			*names[] = {"ant", "bee", "cat", "dog", "eel",
+		"fox", "gnu", "hen", "ibis", "jay"};
+	for (int i = 0; i < 10; i++) {
+		pool[i].id = (i * 7) % 10;
+		pool[i].price = 100 + (i * 13) % 37;
+		pool[i].name = names[i];
+	}
+	ById	ids;
+	ByPrice	prices;
+	display("[empty]", ids);
+	for (size_t i = 0; i < pool.size(); i++) {
+		ids.insert(pool[i]);
+		prices.insert(pool[i]);
+	}
+	display("[by id]", ids);
+	display("[by price desc]", prices);
+
+	Order	dup;
+	dup.id = 3;
+	dup.price = 1;
+	dup.name = "dup";
+	pair<ById::iterator, bool>	r = ids.insert(dup);
+	std::cout << "[insert dup] " << r.second << ' ' << r.first->name << std::endl;
+
+	std::cout << "[#### lookup ####]" << std::endl;
+	std::cout << "[find 4] " << ids.find(4)->name << " [count 11] " << ids.count(11)
+		<< " [lower 5] " << ids.lower_bound(5)->id << " [upper 5] " << ids.upper_bound(5)->id
+		<< std::endl;
+	std::cout << "[price lower 120] " << prices.lower_bound(120)->price << std::endl;
+	ById::iterator	it = ids.iterator_to(pool[2]);
+	std::cout << "[iterator_to] " << it->id << ' ' << (++it)->id << ' ' << (--it)->id << std::endl;
+	it->name = "renamed";
+	display("[shared object]", prices);
+
+	std::cout << "[#### erase ####]" << std::endl;
+	ids.erase(ids.find(0));
+	ids.erase(pool[5]);
+	std::cout << "[erase key] " << ids.erase(9) << ' ' << ids.erase(42) << std::endl;
+	display("[by id]", ids);
+	display("[by price still]", prices);
+	ids.insert(pool[5]);
+	for (ById::iterator e = ids.begin(); e != ids.end();)
+		if (e->id % 2)
+			e = ids.erase(e);
+		else
+			++e;
+	display("[even ids]", ids);
+	ById	other;
+	other.insert(pool[1]);
+	other.swap(ids);
+	display("[swapped]", ids);
+	display("[other]", other);
+	other.clear();
+	display("[cleared]", other);
+	for (size_t i = 0; i < pool.size(); i++)
+		other.insert(pool[i]);
+	std::cout << "[reinsert] " << other.size() << std::endl;
+	ids.clear();
+	other.clear();
+	prices.clear();
+
+	std::cout << "[#### order book ####]" << std::endl;
+	std::vector<Order>	book(SIZE);
+	ById				bookIds;
+	ByPrice				bookPrices;
+	clock_t				t = clock();
+	for (int i = 0; i < SIZE; i++) {
+		book[i].id = int((i * 7919LL) % SIZE);
+		book[i].price = i;
+		bookIds.insert(book[i]);
+		bookPrices.insert(book[i]);
+	}
+	long	sum = 0;
+	for (int i = 0; i < SIZE; i += 3) {
+		ById::iterator	f = bookIds.find(i);
+		sum += f->price;
+		if (i % 2) {
+			bookPrices.erase(*f);
+			bookIds.erase(f);
+		}
+	}
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[size] " << bookIds.size() << ' ' << bookPrices.size() << " [sum] " << sum
+		<< " [top] " << bookPrices.begin()->price << std::endl;
+	return 0;
+}
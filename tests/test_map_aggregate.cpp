@@ -0,0 +1,124 @@
+#include <climits>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+
+/// Sum of the mapped values.
+struct Sum {
+	typedef long	value_type;
+	static long	identity() { return 0; }
+	static long	combine(long a, long b) { return a + b; }
+	template <typename P>
+	static long	lift(const P &v) { return v.second; }
+};
+
+/// Smallest mapped value.
+struct Min {
+	typedef long	value_type;
+	static long	identity() { return LONG_MAX; }
+	static long	combine(long a, long b) { return b < a ? b : a; }
+	template <typename P>
+	static long	lift(const P &v) { return v.second; }
+};
+
+/// x -> a * x + b modulo a prime, composed in key order: not commutative.
+struct Affine {
+	struct value_type {
+		long	a;
+		long	b;
+	};
+	static value_type	make(long a, long b) {
+		value_type	f;
+		f.a = a;
+		f.b = b;
+		return f;
+	}
+	static value_type	identity() { return make(1, 0); }
+	static value_type	combine(const value_type &f, const value_type &g) {
+		return make(g.a * f.a % 1000003, (g.a * f.b + g.b) % 1000003);
+	}
+	template <typename P>
+	static value_type	lift(const P &v) { return make(v.first % 7 + 2, v.second % 1000003); }
+};
+
+#ifndef _IS_TEST
+# include <map>
+# include <utility>
+namespace ft = std;
+/// Linear scan of the range, what the aggregating map replaces.
+template <typename Monoid>
+class AggregateMap : public std::map<int, long> {
+public:
+	typename Monoid::value_type	aggregate(int lo, int hi) const {
+		typename Monoid::value_type	acc = Monoid::identity();
+		for (const_iterator it = lower_bound(lo); it != end() && it->first < hi; ++it)
+			acc = Monoid::combine(acc, Monoid::lift(*it));
+		return acc;
+	}
+	void	update(iterator pos, long x) { pos->second = x; }
+};
+template <typename Monoid> struct aggregate_map {
+	typedef AggregateMap<Monoid>	type;
+};
+#else
+# include "../include/Map.hpp"
+template <typename Monoid> struct aggregate_map {
+	typedef ft::map<int, long, std::less<int>,
+		std::allocator<ft::pair<const int, long> >, ft::aggregate_nodes<Monoid> >	type;
+};
+#endif // _IS_TEST
+
+#define SIZE 100000
+
+int main() {
+	std::cout << "[#### sum and min ####]" << std::endl;
+	aggregate_map<Sum>::type	sums;
+	aggregate_map<Min>::type	mins;
+	for (int i = 0; i < 40; i++) {
+		sums.insert(ft::make_pair((i * 13) % 40, long(i * i % 17)));
+		mins.insert(ft::make_pair((i * 13) % 40, long(i * i % 17)));
+	}
+	std::cout << "[all] " << sums.aggregate(0, 40) << ' ' << mins.aggregate(0, 40)
+		<< " [empty] " << sums.aggregate(10, 10) << ' ' << (mins.aggregate(50, 60) == LONG_MAX)
+		<< " [window] " << sums.aggregate(5, 17) << ' ' << mins.aggregate(5, 17) << std::endl;
+	sums.erase(7);
+	sums.erase(sums.find(12), sums.find(20));
+	sums.update(sums.find(6), 1000);
+	mins.update(mins.find(9), -5);
+	aggregate_map<Sum>::type	copy(sums);
+	copy.insert(ft::make_pair(100, 1L));
+	std::cout << "[sum] " << sums.aggregate(0, 30) << ' ' << sums.aggregate(6, 7)
+		<< " [min] " << mins.aggregate(0, 9) << ' ' << mins.aggregate(0, 10)
+		<< " [copy] " << copy.aggregate(-10, 1000) << std::endl;
+
+	std::cout << "[#### non commutative ####]" << std::endl;
+	aggregate_map<Affine>::type	affine;
+	srand(3);
+	for (int i = 0; i < 2000; i++) {
+		int	k = rand() % 1000;
+		if (rand() % 4)
+			affine.insert(ft::make_pair(k, long(rand() % 1000)));
+		else
+			affine.erase(k);
+	}
+	for (int lo = 0; lo < 1000; lo += 250) {
+		Affine::value_type	f = affine.aggregate(lo, lo + 300);
+		std::cout << f.a << ':' << f.b << ' ';
+	}
+	std::cout << std::endl;
+
+	std::cout << "[#### windowed metrics ####]" << std::endl;
+	aggregate_map<Sum>::type	metrics;
+	clock_t						t = clock();
+	for (int i = 0; i < SIZE; i++)
+		metrics.insert(ft::make_pair(i, long(i % 100)));
+	long	total = 0;
+	for (int i = 0; i < SIZE; i += 50) {
+		total += metrics.aggregate(i, i + SIZE / 4);
+		metrics.update(metrics.find(i), long(i % 7));
+	}
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[total] " << total << std::endl;
+	return 0;
+}
@@ -0,0 +1,108 @@
+#ifndef _IS_TEST
+# include <map>
+# include <set>
+# include <string>
+# include <utility>
+namespace ft = std;
+/// Frees on the spot, what the deferred trees replace.
+struct tree_reclaimer {
+	size_t	collect(size_t) { return 0; }
+	void	collect_all() {}
+	size_t	pending() const { return 0; }
+	void	start(size_t = 0) {}
+	void	stop() {}
+};
+class deferred_map : public std::map<int, std::string> {
+public:
+	void	set_reclaimer(tree_reclaimer *) {}
+};
+class deferred_set : public std::set<int> {
+public:
+	void	set_reclaimer(tree_reclaimer *) {}
+};
+#else
+# include "../include/Map.hpp"
+# include "../include/Set.hpp"
+# include <string>
+using ft::tree_reclaimer;
+typedef ft::map<int, std::string, std::less<int>,
+	std::allocator<ft::pair<const int, std::string> >, ft::deferred_nodes>	deferred_map;
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::deferred_nodes>	deferred_set;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#define SIZE 1000000
+
+void	print(const deferred_map &m) {
+	std::cout << "[size] " << m.size() << " |";
+	for (deferred_map::const_iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << ' ' << it->first << ':' << it->second;
+	std::cout << std::endl;
+}
+
+void	fill(deferred_map &m, int n) {
+	for (int i = 0; i < n; i++)
+		m[(i * 7) % n] = std::string(i % 5 + 1, char('a' + i % 26));
+}
+
+int main() {
+	std::cout << "[#### no reclaimer ####]" << std::endl;
+	deferred_map	plain;
+	fill(plain, 10);
+	plain.erase(plain.find(3), plain.find(6));
+	print(plain);
+	plain.erase(plain.begin(), plain.end());
+	print(plain);
+
+	std::cout << "[#### collect ####]" << std::endl;
+	tree_reclaimer	reclaimer;
+	{
+		deferred_map	a;
+		deferred_map	b;
+		a.set_reclaimer(&reclaimer);
+		b.set_reclaimer(&reclaimer);
+		fill(a, 2000);
+		fill(b, 12);
+		deferred_map	c(b);
+		b = a;
+		a.clear();
+		fill(a, 6);
+		c.erase(c.begin(), c.end());
+		c[1] = "one";
+		print(a);
+		print(c);
+		std::cout << "[b] " << b.size() << ' ' << b[1999] << std::endl;
+		deferred_set	s;
+		s.set_reclaimer(&reclaimer);
+		for (int i = 0; i < 1000; i++)
+			s.insert(i * 3);
+		s.clear();
+		s.insert(4);
+		std::cout << "[set] " << s.size() << ' ' << *s.begin() << std::endl;
+	}
+	// Dropped trees wait for the collect() calls, each one bounded.
+	while (reclaimer.collect(500) != 0)
+		;
+	std::cout << "[pending] " << reclaimer.pending() << std::endl;
+
+	std::cout << "[#### background ####]" << std::endl;
+	deferred_map	*big = new deferred_map;
+	big->set_reclaimer(&reclaimer);
+	fill(*big, SIZE);
+	reclaimer.start();
+	clock_t	t = clock();
+	delete big;
+	std::cerr << "[drop] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	deferred_map	next;
+	next.set_reclaimer(&reclaimer);
+	fill(next, 1000);
+	next = deferred_map();
+	reclaimer.stop();
+	reclaimer.collect_all();
+	std::cout << "[next] " << next.size() << " [pending] " << reclaimer.pending()
+		<< std::endl;
+	return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _IS_TEST
+#include <map>
+#include <set>
+namespace ft = std;
+#else
+#include "../include/Map.hpp"
+#include "../include/Set.hpp"
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define SIZE 1000000
+
+/// No default constructor: an empty container must not build one.
+class Point {
+public:
+	Point(int x, int y) : x(x), y(y) {}
+	bool operator<(const Point &o) const { return x < o.x || (x == o.x && y < o.y); }
+	int	x;
+	int	y;
+};
+
+std::ostream &operator<<(std::ostream &os, const Point &p) {
+	return os << '(' << p.x << ',' << p.y << ')';
+}
+
+int main() {
+	std::cout << "[#### non default constructible ####]" << std::endl;
+	ft::set<Point>				empty;
+	std::cout << "[empty] " << empty.size() << ' ' << (empty.begin() == empty.end()) << std::endl;
+	ft::set<Point>				points;
+	for (int i = 0; i < 6; i++)
+		points.insert(Point(i % 3, i));
+	for (ft::set<Point>::iterator it = points.begin(); it != points.end(); ++it)
+		std::cout << *it << ' ';
+	std::cout << std::endl;
+	ft::map<std::string, Point>	named;
+	named.insert(ft::make_pair(std::string("origin"), Point(0, 0)));
+	named.insert(ft::make_pair(std::string("unit"), Point(1, 1)));
+	ft::map<std::string, Point>	copy(named);
+	copy.erase("origin");
+	named.swap(copy);
+	std::cout << "[named] " << named.size() << ' ' << named.begin()->second
+		<< " [copy] " << copy.size() << ' ' << (--copy.end())->second << std::endl;
+
+	std::cout << "[#### churn ####]" << std::endl;
+	ft::map<int, int>	m;
+	srand(7);
+	long				sum = 0;
+	for (int i = 0; i < SIZE; i++) {
+		int	k = rand() % (SIZE / 4);
+		if (rand() % 3)
+			m[k] += i;
+		else
+			m.erase(k);
+	}
+	for (ft::map<int, int>::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		sum += it->first ^ it->second;
+	std::cout << "[size] " << m.size() << " [sum] " << sum << std::endl;
+	return 0;
+}
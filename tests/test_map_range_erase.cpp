@@ -0,0 +1,77 @@
+#ifndef _IS_TEST
+# include <map>
+# include <set>
+# include <utility>
+namespace ft = std;
+#else
+# include "../include/Map.hpp"
+# include "../include/Set.hpp"
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#define SIZE 1000000
+
+template <typename Set>
+void	print(const Set &s) {
+	std::cout << "[size] " << s.size() << " |";
+	for (typename Set::const_iterator it = s.begin(); it != s.end(); ++it)
+		std::cout << ' ' << *it;
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### set ranges ####]" << std::endl;
+	ft::set<int>	s;
+	for (int i = 0; i < 100; i++)
+		s.insert((i * 37) % 100);
+	s.erase(s.find(10), s.find(60));
+	print(s);
+	s.erase(s.begin(), s.find(5));
+	s.erase(s.find(80), s.end());
+	s.erase(s.find(7), s.find(7));
+	print(s);
+	s.insert(30);
+	s.insert(-1);
+	print(s);
+
+	std::cout << "[#### map ranges ####]" << std::endl;
+	ft::map<int, int>	m;
+	srand(8);
+	for (int i = 0; i < 5000; i++)
+		m[rand() % 20000] = i;
+	for (int i = 0; i < 40; i++) {
+		int	lo = rand() % 20000;
+		int	len = i % 2 ? rand() % 30 : rand() % 4000;
+		m.erase(m.lower_bound(lo), m.lower_bound(lo + len));
+		m[rand() % 20000] = i;
+	}
+	long	sum = 0;
+	for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->first ^ it->second;
+	ft::map<int, int>::iterator	last = m.end();
+	--last;
+	std::cout << "[size] " << m.size() << " [sum] " << sum << " [ends] "
+		<< m.begin()->first << ' ' << last->first << std::endl;
+
+	std::cout << "[#### trim oldest ####]" << std::endl;
+	ft::map<int, int>	events;
+	for (int i = 0; i < SIZE; i++)
+		events.insert(events.end(), ft::make_pair(i, i));
+	clock_t	t = clock();
+	// Keep a sliding window: drop the oldest entries, a large run at a time.
+	for (int i = 0; i < 8; i++) {
+		events.erase(events.begin(), events.lower_bound(SIZE / 10 * (i + 1)));
+		for (int j = 0; j < 1000; j++)
+			events.insert(events.end(), ft::make_pair(SIZE + i * 1000 + j, j));
+	}
+	events.erase(events.lower_bound(SIZE - 1000), events.lower_bound(SIZE + 5000));
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	ft::map<int, int>::iterator	back = events.end();
+	--back;
+	std::cout << "[size] " << events.size() << " [ends] " << events.begin()->first
+		<< ' ' << back->first << std::endl;
+	return 0;
+}
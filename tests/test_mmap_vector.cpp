@@ -0,0 +1,165 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <cstdio>
+# include <string>
+# include <vector>
+namespace ft {
+	/// The dump-and-reload baseline: the whole array is read on open and
+	/// written back on close.
+	template <typename T>
+	class mmap_vector : public std::vector<T> {
+		std::string	path;
+	public:
+		explicit mmap_vector(const std::string &p) : path(p) {
+			FILE	*f = std::fopen(path.c_str(), "rb");
+			if (!f)
+				return;
+			T	val;
+			while (std::fread(&val, sizeof(T), 1, f) == 1)
+				this->push_back(val);
+			std::fclose(f);
+		}
+		~mmap_vector() { sync(); }
+		void sync(bool = true) {
+			FILE	*f = std::fopen(path.c_str(), "wb");
+			if (this->size())
+				std::fwrite(&(*this)[0], sizeof(T), this->size(), f);
+			std::fclose(f);
+		}
+		void append(const T *p, size_t n) { this->insert(this->end(), p, p + n); }
+	};
+}
+#else
+# include "../include/MmapVector.hpp"
+#endif // _IS_TEST
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define SIZE 10000000
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+struct Point {
+	int		x;
+	int		y;
+	double	w;
+};
+
+std::string temp_path(const std::string &name) {
+	std::ostringstream	s;
+	s << "/tmp/ft_" << name << '_' << getpid() << ".bin";
+	return s.str();
+}
+
+template <typename Vec>
+void print(const std::string &title, const Vec &v) {
+	std::cout << title << " [size] " << v.size() << " [values]";
+	for (size_t i = 0; i < v.size() && i < 20; ++i)
+		std::cout << ' ' << v[i];
+	std::cout << std::endl;
+}
+
+void basics() {
+	std::string	path = temp_path("mmap_basic");
+	std::remove(path.c_str());
+	{
+		ft::mmap_vector<int>	v(path);
+		print("new", v);
+		for (int i = 0; i < 10; ++i)
+			v.push_back(i * i);
+		v.insert(v.begin() + 3, 2, -1);
+		v.erase(v.begin());
+		v.pop_back();
+		print("edited", v);
+	}
+	{
+		ft::mmap_vector<int>	v(path);
+		print("reopened", v);
+		v.resize(15, 7);
+		v.append(&v[0], 5);
+		std::cout << "[front] " << v.front() << " [back] " << v.back() << " [at 4] " << v.at(4) << std::endl;
+		try {
+			v.at(100);
+		} catch (const std::out_of_range &) {
+			std::cout << "out_of_range" << std::endl;
+		}
+		v.sync();
+	}
+	{
+		ft::mmap_vector<int>	v(path);
+		print("synced", v);
+		v.assign(3, 42);
+		v.reserve(100000);
+		std::cout << "[capacity >= 100000] " << (v.capacity() >= 100000) << std::endl;
+	}
+	{
+		ft::mmap_vector<int>	v(path);
+		print("assigned", v);
+		v.clear();
+	}
+	{
+		ft::mmap_vector<int>	v(path);
+		print("cleared", v);
+	}
+	std::remove(path.c_str());
+}
+
+void structs() {
+	std::string	path = temp_path("mmap_struct");
+	std::remove(path.c_str());
+	{
+		ft::mmap_vector<Point>	v(path);
+		for (int i = 0; i < 100000; ++i) {
+			Point	p = { i, -i, i * 0.5 };
+			v.push_back(p);
+		}
+	}
+	{
+		ft::mmap_vector<Point>	v(path);
+		double	sum = 0;
+		for (size_t i = 0; i < v.size(); ++i)
+			sum += v[i].x + v[i].y + v[i].w;
+		std::cout << "[points] " << v.size() << ' ' << sum << std::endl;
+	}
+	std::remove(path.c_str());
+}
+
+void restart() {
+	std::string	path = temp_path("mmap_restart");
+	std::remove(path.c_str());
+	{
+		ft::mmap_vector<long>	v(path);
+		for (long i = 0; i < SIZE; ++i)
+			v.push_back(i);
+	}
+	double	start = now();
+	long	tail = 0;
+	size_t	n = 0;
+	{
+		ft::mmap_vector<long>	v(path);
+		n = v.size();
+		for (size_t i = n - 1000; i < n; ++i)
+			tail += v[i];
+		v.push_back(-1);
+		v.pop_back();
+		std::cerr << "reopen " << n << " longs and read the last 1000: " << now() - start << "s" << std::endl;
+	}
+	std::cout << "[restart] " << n << ' ' << tail << std::endl;
+	std::remove(path.c_str());
+}
+
+int main() {
+	basics();
+	structs();
+	restart();
+	return 0;
+}
@@ -0,0 +1,96 @@
+#ifndef _IS_TEST
+# include <map>
+# include <set>
+# include <string>
+# include <utility>
+namespace ft = std;
+typedef std::multimap<int, int>	compact_multimap;
+#else
+# include "../include/Multimap.hpp"
+# include "../include/Multiset.hpp"
+# include <string>
+typedef ft::multimap<int, int, std::less<int>,
+	std::allocator<ft::pair<const int, int> >, ft::compact_nodes>	compact_multimap;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#define SIZE 1000000
+
+template <typename Map>
+void	print(const Map &m) {
+	std::cout << "[size] " << m.size() << " |";
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << ' ' << it->first << ':' << it->second;
+	std::cout << std::endl;
+}
+
+template <typename Map>
+void	runs(Map &m) {
+	std::cout << "[empty count] " << m.count(0) << ' ' << m.count(3) << std::endl;
+	for (int i = 0; i < 12; i++)
+		m.insert(ft::make_pair(i % 4, i));
+	m.insert(ft::make_pair(2, 100));
+	m.insert(m.end(), ft::make_pair(9, 9));
+	m.insert(m.begin(), ft::make_pair(0, -1));
+	m.insert(m.find(3), ft::make_pair(1, 101));
+	print(m);
+	std::cout << "[count] " << m.count(0) << ' ' << m.count(2) << ' '
+		<< m.count(5) << " [bounds] " << m.lower_bound(2)->second << ' '
+		<< m.upper_bound(2)->second << std::endl;
+	typename Map::iterator	first = m.equal_range(1).first;
+	typename Map::iterator	last = m.equal_range(1).second;
+	for (; first != last; ++first)
+		std::cout << first->second << ' ';
+	std::cout << "| [erase] " << m.erase(2) << ' ' << m.erase(7) << std::endl;
+	m.erase(m.begin());
+	Map	copy(m);
+	copy.insert(ft::make_pair(3, 33));
+	std::cout << "[==] " << (copy == m) << " [<] " << (m < copy) << std::endl;
+	print(copy);
+}
+
+int main() {
+	std::cout << "[#### multimap ####]" << std::endl;
+	ft::multimap<int, int>	m;
+	runs(m);
+	std::cout << "[#### compact multimap ####]" << std::endl;
+	compact_multimap		cm;
+	runs(cm);
+
+	std::cout << "[#### multiset ####]" << std::endl;
+	ft::multiset<std::string>	words;
+	std::cout << "[empty count] " << words.count("to") << std::endl;
+	const char	*text[] = {"to", "be", "or", "not", "to", "be", "that", "is",
+		"the", "question"};
+	for (size_t i = 0; i < sizeof(text) / sizeof(*text); i++)
+		words.insert(text[i]);
+	for (ft::multiset<std::string>::const_iterator it = words.begin(); it != words.end(); ++it)
+		std::cout << *it << ' ';
+	std::cout << "| " << words.count("to") << ' ' << words.erase("be") << ' '
+		<< words.size() << std::endl;
+
+	std::cout << "[#### time keyed runs ####]" << std::endl;
+	ft::multimap<int, int>	events;
+	clock_t					t = clock();
+	// Keys only grow: every insert takes the append fast path.
+	for (int i = 0; i < SIZE; i++)
+		events.insert(ft::make_pair(i / 1000, i));
+	long	sum = 0;
+	srand(5);
+	for (int i = 0; i < 1000; i++) {
+		int	k = rand() % (SIZE / 1000);
+		sum += events.count(k);
+		ft::pair<ft::multimap<int, int>::iterator,
+			ft::multimap<int, int>::iterator>	r = events.equal_range(k);
+		if (r.first != r.second)
+			sum += r.first->second;
+	}
+	for (int k = 0; k < SIZE / 1000; k += 2)
+		sum += events.erase(k);
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[size] " << events.size() << " [sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,258 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <functional>
+# include <set>
+# include <vector>
+namespace ft {
+	template <typename T, typename Comp = std::less<T> >
+	class pairing_heap {
+		struct Node;
+		struct NodeComp {
+			Comp	comp;
+			bool operator()(const Node *a, const Node *b) const { return comp(a->value, b->value); }
+		};
+		typedef std::multiset<Node *, NodeComp>	set_type;
+		struct Node {
+			T							value;
+			typename set_type::iterator	it;
+			Node(const T &v) : value(v) {}
+		};
+		set_type	s;
+
+		pairing_heap &operator=(const pairing_heap &);
+	public:
+		class handle_type {
+			friend class pairing_heap;
+			Node	*node;
+			handle_type(Node *n) : node(n) {}
+		public:
+			handle_type() : node(0) {}
+			const T &operator*() const { return node->value; }
+			const T *operator->() const { return &node->value; }
+		};
+
+		pairing_heap() {}
+		template <typename It>
+		pairing_heap(It first, It last) {
+			for (; first != last; ++first)
+				push(*first);
+		}
+		pairing_heap(const pairing_heap &x) {
+			for (typename set_type::const_iterator it = x.s.begin(); it != x.s.end(); ++it)
+				push((*it)->value);
+		}
+		~pairing_heap() { clear(); }
+
+		bool empty() const { return s.empty(); }
+		size_t size() const { return s.size(); }
+		const T &top() const { return (*s.rbegin())->value; }
+		handle_type push(const T &v) {
+			Node	*n = new Node(v);
+			n->it = s.insert(n);
+			return handle_type(n);
+		}
+		void pop() { erase(handle_type(*s.rbegin())); }
+		void update(handle_type h, const T &v) {
+			s.erase(h.node->it);
+			h.node->value = v;
+			h.node->it = s.insert(h.node);
+		}
+		void increase(handle_type h, const T &v) { update(h, v); }
+		void decrease(handle_type h, const T &v) { update(h, v); }
+		void erase(handle_type h) {
+			s.erase(h.node->it);
+			delete h.node;
+		}
+		void meld(pairing_heap &x) {
+			for (typename set_type::iterator it = x.s.begin(); it != x.s.end(); ++it)
+				(*it)->it = s.insert(*it);
+			x.s.clear();
+		}
+		void clear() {
+			for (typename set_type::iterator it = s.begin(); it != s.end(); ++it)
+				delete *it;
+			s.clear();
+		}
+		void swap(pairing_heap &x) { s.swap(x.s); }
+	};
+	using std::vector;
+}
+#else
+# include "../include/PairingHeap.hpp"
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+#include <utility>
+
+#define NODES 200000
+#define EDGES 8
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+unsigned long	seed = 42;
+
+unsigned long next_rand() {
+	seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+	return seed >> 33;
+}
+
+template <typename Heap>
+void drain(const std::string &title, Heap &h) {
+	std::cout << title << " [size] " << h.size() << " [values]";
+	while (!h.empty()) {
+		std::cout << ' ' << h.top();
+		h.pop();
+	}
+	std::cout << std::endl;
+}
+
+void handles() {
+	typedef ft::pairing_heap<int>	heap;
+	int							vals[] = { 5, 1, 9, 3, 7, 9, 2, 8, 6, 4, 0, 11, 10 };
+	heap						h;
+	ft::vector<heap::handle_type>	hs;
+
+	for (int i = 0; i < 13; ++i)
+		hs.push_back(h.push(vals[i]));
+	std::cout << "[top] " << h.top() << " [handle 3] " << *hs[3] << std::endl;
+	h.increase(hs[1], 20);
+	h.decrease(hs[11], -5);
+	h.update(hs[4], 15);
+	h.update(hs[12], 3);
+	std::cout << "[top] " << h.top() << " [handle 1] " << *hs[1] << std::endl;
+	h.pop();
+	h.erase(hs[6]);
+	h.erase(hs[0]);
+	h.decrease(hs[4], -1);
+	std::cout << "[handle 4] " << *hs[4] << " [handle 10] " << *hs[10] << std::endl;
+
+	heap	copy(h);
+	drain("handles", h);
+	drain("copy", copy);
+
+	for (int i = 0; i < 100; ++i)
+		hs[i % 13] = h.push(i * 7 % 31);
+	h.increase(hs[5], 100);
+	h.clear();
+	std::cout << "[cleared] " << h.empty() << std::endl;
+	h.push(1);
+	drain("reuse", h);
+}
+
+void meld() {
+	typedef ft::pairing_heap<int, std::greater<int> >	heap;
+	heap				a, b;
+	heap::handle_type	ha, hb;
+
+	for (int i = 0; i < 50; ++i) {
+		heap::handle_type	x = a.push(i * 3 % 50);
+		heap::handle_type	y = b.push(i * 7 % 50 + 25);
+		if (i == 10)
+			ha = x;
+		if (i == 20)
+			hb = y;
+	}
+	a.meld(b);
+	std::cout << "[meld] " << a.size() << ' ' << b.size() << ' ' << a.top() << std::endl;
+	a.increase(hb, -3);
+	a.decrease(ha, 1000);
+	std::cout << "[top] " << a.top() << std::endl;
+	for (int i = 0; i < 40; ++i)
+		b.push(i);
+	a.meld(b);
+	a.swap(b);
+	std::cout << "[swap] " << a.size() << ' ' << b.size() << std::endl;
+	drain("meld", b);
+}
+
+/// Dijkstra on a random graph, one handle per vertex.
+void dijkstra() {
+	typedef std::pair<unsigned long, int>					item;
+	typedef ft::pairing_heap<item, std::greater<item> >		heap;
+	ft::vector<int>				to(NODES * EDGES);
+	ft::vector<unsigned long>	weight(NODES * EDGES);
+	ft::vector<unsigned long>	dist(NODES, ~0UL);
+	ft::vector<heap::handle_type>	hs(NODES);
+	ft::vector<char>			state(NODES, 0);
+	heap						h;
+	unsigned long				relaxed = 0;
+
+	for (int i = 0; i < NODES * EDGES; ++i) {
+		to[i] = next_rand() % NODES;
+		weight[i] = next_rand() % 1000 + 1;
+	}
+	double	start = now();
+	dist[0] = 0;
+	hs[0] = h.push(item(0, 0));
+	state[0] = 1;
+	while (!h.empty()) {
+		int	u = h.top().second;
+		h.pop();
+		state[u] = 2;
+		for (int e = u * EDGES; e < (u + 1) * EDGES; ++e) {
+			int				v = to[e];
+			unsigned long	d = dist[u] + weight[e];
+			if (state[v] == 2 || d >= dist[v])
+				continue;
+			dist[v] = d;
+			if (state[v] == 0) {
+				hs[v] = h.push(item(d, v));
+				state[v] = 1;
+			} else {
+				h.increase(hs[v], item(d, v));
+				++relaxed;
+			}
+		}
+	}
+	double	elapsed = now() - start;
+	unsigned long	sum = 0, reached = 0;
+	for (int i = 0; i < NODES; ++i)
+		if (dist[i] != ~0UL) {
+			sum += dist[i];
+			++reached;
+		}
+	std::cout << "[dijkstra] reached " << reached << " sum " << sum
+		<< " decrease-keys " << relaxed << std::endl;
+	std::cerr << "dijkstra: " << elapsed << "s" << std::endl;
+}
+
+/// Timer style workload: re-arm and cancel armed timers by handle.
+void timers() {
+	typedef ft::pairing_heap<unsigned long, std::greater<unsigned long> >	heap;
+	ft::vector<heap::handle_type>	hs;
+	heap							h;
+
+	double	start = now();
+	for (int i = 0; i < 10000; ++i)
+		hs.push_back(h.push(next_rand() % 100000));
+	for (int round = 0; round < 1000000; ++round) {
+		heap::handle_type	&t = hs[next_rand() % hs.size()];
+		if (next_rand() % 4) {
+			h.update(t, next_rand() % 100000);
+		} else {
+			h.erase(t);
+			t = h.push(next_rand() % 100000);
+		}
+	}
+	unsigned long	sum = 0;
+	for (size_t i = 0; i < hs.size(); ++i)
+		sum += *hs[i];
+	std::cout << "[timers] " << h.size() << " top " << h.top() << " sum " << sum << std::endl;
+	std::cerr << "timers: " << now() - start << "s" << std::endl;
+}
+
+int main() {
+	handles();
+	meld();
+	dijkstra();
+	timers();
+	return 0;
+}
@@ -0,0 +1,145 @@
+#ifndef _IS_TEST
+# include <algorithm>
+# include <cstddef>
+# include <functional>
+# include <numeric>
+# include <vector>
+namespace ft {
+	using std::vector;
+	namespace parallel {
+		inline void set_thread_count(size_t) {}
+		using std::sort;
+		using std::stable_sort;
+		using std::for_each;
+		using std::transform;
+		template <typename It, typename T, typename Op>
+		T reduce(It first, It last, T init, Op op) { return std::accumulate(first, last, init, op); }
+		template <typename It, typename T>
+		T reduce(It first, It last, T init) { return std::accumulate(first, last, init); }
+		template <typename It, typename Out, typename Op>
+		Out inclusive_scan(It first, It last, Out out, Op op) { return std::partial_sum(first, last, out, op); }
+		template <typename It, typename Out>
+		Out inclusive_scan(It first, It last, Out out) { return std::partial_sum(first, last, out); }
+	}
+}
+#else
+# include "../include/Parallel.hpp"
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+#include <utility>
+
+#define SIZE 4000000
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+unsigned long	seed = 42;
+
+unsigned long next_rand() {
+	seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+	return seed >> 33;
+}
+
+template <typename Vec>
+unsigned long checksum(const Vec &v) {
+	unsigned long	sum = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+		sum = sum * 31 + (unsigned long)v[i];
+	return sum;
+}
+
+struct ByKey {
+	bool operator()(const std::pair<int, int> &a, const std::pair<int, int> &b) const {
+		return a.first < b.first;
+	}
+};
+
+struct Increment {
+	void operator()(int &x) const { x += 3; }
+};
+
+/// Adds every element it sees to a shared total.
+struct Tally {
+	long	*total;
+	explicit Tally(long *t) : total(t) {}
+	void operator()(const int &x) const { __atomic_add_fetch(total, x, __ATOMIC_RELAXED); }
+};
+
+struct Square {
+	long operator()(int x) const { return (long)x * x; }
+};
+
+void run(size_t threads, size_t n) {
+	ft::parallel::set_thread_count(threads);
+	ft::vector<int>	v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back(next_rand() % 1000000);
+
+	std::cout << "[threads] " << threads << " [size] " << n;
+	ft::vector<int>	s(v);
+	double	start = now();
+	ft::parallel::sort(s.begin(), s.end());
+	std::cerr << threads << " threads sort " << n << ": " << now() - start << "s" << std::endl;
+	std::cout << " [sort] " << checksum(s);
+	ft::parallel::sort(s.begin(), s.end(), std::greater<int>());
+	std::cout << ' ' << checksum(s);
+
+	ft::vector<std::pair<int, int> >	p;
+	for (size_t i = 0; i < n; ++i)
+		p.push_back(std::make_pair(v[i] % 1000, (int)i));
+	ft::parallel::stable_sort(p.begin(), p.end(), ByKey());
+	unsigned long	sum = 0;
+	for (size_t i = 0; i < p.size(); ++i)
+		sum = sum * 31 + p[i].first * 7 + p[i].second;
+	std::cout << " [stable_sort] " << sum;
+
+	ft::parallel::for_each(s.begin(), s.end(), Increment());
+	std::cout << " [for_each] " << checksum(s);
+	const ft::vector<int>	&cs = s;
+	long					tally = 0;
+	ft::parallel::for_each(cs.begin(), cs.end(), Tally(&tally));
+	std::cout << " [const for_each] " << tally;
+
+	ft::vector<long>	sq(n);
+	ft::parallel::transform(v.begin(), v.end(), sq.begin(), Square());
+	std::cout << " [transform] " << checksum(sq);
+	ft::parallel::transform(v.begin(), v.end(), s.begin(), s.begin(), std::minus<int>());
+	std::cout << ' ' << checksum(s);
+
+	std::cout << " [reduce] " << ft::parallel::reduce(sq.begin(), sq.end(), 0L)
+		<< ' ' << ft::parallel::reduce(v.begin(), v.end(), 0UL, std::bit_xor<unsigned long>());
+
+	// Associative but not commutative: blocks must be combined in order.
+	ft::vector<std::string>	words(n < 200000 ? n : 200000);
+	for (size_t i = 0; i < words.size(); ++i)
+		words[i] = std::string(1, 'a' + v[i] % 26);
+	std::string	joined = ft::parallel::reduce(words.begin(), words.end(), std::string(">"));
+	unsigned long	hash = 0;
+	for (size_t i = 0; i < joined.size(); ++i)
+		hash = hash * 31 + joined[i];
+	std::cout << ' ' << joined.size() << ' ' << hash;
+
+	ft::vector<long>	scan(n);
+	ft::parallel::inclusive_scan(sq.begin(), sq.end(), scan.begin());
+	std::cout << " [scan] " << checksum(scan);
+	ft::parallel::inclusive_scan(s.begin(), s.end(), s.begin(), std::bit_xor<int>());
+	std::cout << ' ' << checksum(s) << std::endl;
+}
+
+int main() {
+	size_t	sizes[] = { 0, 1, 17, 40000, 100003, SIZE };
+	size_t	threads[] = { 1, 2, 4, 7 };
+
+	for (size_t t = 0; t < 4; ++t)
+		for (size_t i = 0; i < 6; ++i)
+			run(threads[t], sizes[i]);
+	return 0;
+}
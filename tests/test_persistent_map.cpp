@@ -0,0 +1,103 @@
+#ifndef _IS_TEST
+# include <map>
+# include <utility>
+namespace ft = std;
+/// Snapshots by full copy, what the persistent map replaces.
+class PersistentMap : public std::map<int, int> {
+public:
+	PersistentMap	snapshot() const { return *this; }
+	std::pair<iterator, bool>	insert_or_assign(int k, int x) {
+		std::pair<iterator, bool>	r = insert(std::make_pair(k, x));
+		r.first->second = x;
+		return r;
+	}
+	using std::map<int, int>::insert;
+};
+#else
+# include "../include/PersistentMap.hpp"
+typedef ft::persistent_map<int, int>	PersistentMap;
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#define SIZE 200000
+
+void	print(const PersistentMap &m) {
+	std::cout << "[size] " << m.size() << " |";
+	for (PersistentMap::const_iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << ' ' << it->first << ':' << it->second;
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### versions ####]" << std::endl;
+	PersistentMap	v1;
+	for (int i = 0; i < 12; i++)
+		v1.insert(ft::make_pair((i * 5) % 12, i));
+	PersistentMap	v2 = v1.snapshot();
+	std::cout << "[dup] " << v2.insert(ft::make_pair(3, 0)).second
+		<< " [assign] " << v2.insert_or_assign(3, 33).second
+		<< ' ' << v2.insert_or_assign(20, 20).first->second << std::endl;
+	v2.erase(0);
+	v2.erase(v2.find(7));
+	v2.erase(v2.lower_bound(9), v2.end());
+	PersistentMap	v3(v2);
+	v3.clear();
+	v3.insert(ft::make_pair(1, 1));
+	print(v1);
+	print(v2);
+	print(v3);
+	std::cout << "[==] " << (v1 == v1.snapshot()) << ' ' << (v1 == v2)
+		<< " [<] " << (v2 < v1) << " [find] " << (v1.find(7) != v1.end())
+		<< ' ' << v2.count(7) << " [bounds] " << v1.lower_bound(4)->first
+		<< ' ' << v2.upper_bound(4)->first << std::endl;
+	for (PersistentMap::const_reverse_iterator it = v2.rbegin(); it != v2.rend(); ++it)
+		std::cout << it->first << ' ';
+	PersistentMap::const_iterator	it = v1.end();
+	std::cout << "| " << (--it)->first << ' ' << (--it)->first << std::endl;
+	v1.swap(v3);
+	print(v1);
+
+	std::cout << "[#### sorted inserts ####]" << std::endl;
+	PersistentMap	sorted;
+	for (int i = 0; i < SIZE; i++)
+		sorted.insert(ft::make_pair(i, i));
+	for (int i = 0; i < SIZE; i += 2)
+		sorted.erase(i);
+	long	check = 0;
+	for (PersistentMap::const_iterator i = sorted.begin(); i != sorted.end(); ++i)
+		check += i->second;
+	std::cout << "[size] " << sorted.size() << " [sum] " << check << std::endl;
+
+	std::cout << "[#### snapshots under writes ####]" << std::endl;
+	PersistentMap				live;
+	std::vector<PersistentMap>	views;
+	clock_t						t = clock();
+	srand(21);
+	for (int i = 0; i < SIZE; i++)
+		live.insert(ft::make_pair(rand() % (SIZE * 4), i));
+	long	sum = 0;
+	for (int i = 0; i < SIZE; i++) {
+		int	k = rand() % (SIZE * 4);
+		if (i % 3)
+			live.insert_or_assign(k, i);
+		else
+			live.erase(k);
+		if (i % 2000 == 0) {
+			views.push_back(live.snapshot());
+			// Readers look at the view while the writer goes on.
+			PersistentMap::const_iterator	f = views.back().lower_bound(k);
+			if (f != views.back().end())
+				sum += f->second;
+		}
+	}
+	for (size_t i = 0; i < views.size(); i++)
+		sum += views[i].size();
+	std::cerr << "[time] " << double(clock() - t) / CLOCKS_PER_SEC << "s" << std::endl;
+	std::cout << "[views] " << views.size() << " [size] " << live.size()
+		<< " [sum] " << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,115 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <queue>
+# include <vector>
+namespace ft {
+	template <typename T, typename Seq = std::vector<T>,
+		typename Comp = std::less<typename Seq::value_type>, size_t Arity = 2>
+	class priority_queue : public std::priority_queue<T, Seq, Comp> {
+	public:
+		priority_queue() {}
+		template <typename It>
+		priority_queue(It first, It last) : std::priority_queue<T, Seq, Comp>(first, last) {}
+		template <typename It>
+		void push_many(It first, It last) {
+			for (; first != last; ++first)
+				this->push(*first);
+		}
+		void pop_push(const T &x) {
+			T	tmp = x;
+			this->pop();
+			this->push(tmp);
+		}
+	};
+	using std::vector;
+}
+#else
+# include "../include/PriorityQueue.hpp"
+#endif // _IS_TEST
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+
+#define SIZE 1000000
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+template <typename Queue>
+void drain(const std::string &title, Queue &q) {
+	std::cout << title << " [size] " << q.size() << " [values]";
+	while (!q.empty()) {
+		std::cout << ' ' << q.top();
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+template <typename Queue>
+void check(const std::string &title) {
+	int		vals[] = { 5, 1, 9, 3, 7, 9, 2, 8, 6, 4, 0, 11, 10 };
+	Queue	q(vals, vals + 13);
+	std::cout << title << " [top] " << q.top();
+	q.pop_push(-1);
+	q.pop_push(q.top());
+	std::cout << " [after pop_push] " << q.top() << std::endl;
+	int		more[] = { 42, -5, 17 };
+	q.push_many(more, more + 3);
+	q.push(13);
+	drain(title, q);
+}
+
+/// Scheduler-like workload: a large heap, pop_push in a loop, then drain.
+template <typename Queue>
+void bench(const std::string &title, const ft::vector<int> &input) {
+	double	start = now();
+	Queue	q(input.begin(), input.end());
+	long	sum = 0;
+	for (int i = 0; i < SIZE; i++) {
+		sum += q.top();
+		q.pop_push(q.top() - (i % 97) - 1);
+	}
+	q.push_many(input.begin(), input.begin() + SIZE / 10);
+	while (!q.empty()) {
+		sum += q.top() % 1000;
+		q.pop();
+	}
+	std::cout << title << " [sum] " << sum << std::endl;
+	std::cerr << title << ": " << now() - start << " s" << std::endl;
+}
+
+int main() {
+	srand(42);
+	std::cout << "[#### Testing priority_queue ####]" << std::endl;
+	ft::priority_queue<int>	q;
+	std::cout << "[empty] " << q.empty() << std::endl;
+	for (int i = 0; i < 20; i++)
+		q.push(rand() % 100);
+	drain("[push]", q);
+
+	check<ft::priority_queue<int> >("[binary]");
+	check<ft::priority_queue<int, ft::vector<int>, std::less<int>, 4> >("[4-ary]");
+	check<ft::priority_queue<int, ft::vector<int>, std::less<int>, 8> >("[8-ary]");
+	check<ft::priority_queue<int, ft::vector<int>, std::greater<int>, 4> >("[min 4-ary]");
+
+	ft::priority_queue<std::string, ft::vector<std::string>, std::less<std::string>, 4>	words;
+	std::string	w[] = { "pear", "apple", "fig", "kiwi", "banana" };
+	words.push_many(w, w + 5);
+	words.pop_push("cherry");
+	drain("[strings]", words);
+
+	std::cout << "[#### large heaps ####]" << std::endl;
+	ft::vector<int>	input;
+	for (int i = 0; i < SIZE; i++)
+		input.push_back(rand());
+	bench<ft::priority_queue<int> >("[binary]", input);
+	bench<ft::priority_queue<int, ft::vector<int>, std::less<int>, 4> >("[4-ary]", input);
+	bench<ft::priority_queue<int, ft::vector<int>, std::less<int>, 8> >("[8-ary]", input);
+	return 0;
+}
@@ -0,0 +1,184 @@
+#ifndef _IS_TEST
+# include <algorithm>
+# include <cstddef>
+# include <utility>
+# include <vector>
+namespace ft {
+	using std::vector;
+	using std::pair;
+	using std::make_pair;
+	template <typename It>
+	void radix_sort(It first, It last) { std::stable_sort(first, last); }
+	template <typename T>
+	void radix_sort(std::vector<T> &v) { std::stable_sort(v.begin(), v.end()); }
+	template <typename KeyOf>
+	struct KeyLess {
+		KeyOf	key;
+		KeyLess(const KeyOf &k) : key(k) {}
+		template <typename T>
+		bool operator()(const T &a, const T &b) const { return key(a) < key(b); }
+	};
+	template <typename It, typename KeyOf>
+	void radix_sort(It first, It last, KeyOf key) { std::stable_sort(first, last, KeyLess<KeyOf>(key)); }
+	template <typename T, typename KeyOf>
+	void radix_sort(std::vector<T> &v, KeyOf key) { std::stable_sort(v.begin(), v.end(), KeyLess<KeyOf>(key)); }
+}
+#else
+# include "../include/RadixSort.hpp"
+# include "../include/AlignedAllocator.hpp"
+#endif // _IS_TEST
+
+#include <algorithm>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <sys/time.h>
+
+#define SIZE 4000000
+
+double now() {
+	struct timeval	tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+uint64_t	seed = 42;
+
+uint64_t next_rand() {
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed;
+}
+
+template <typename Vec>
+void print(const std::string &title, const Vec &v) {
+	uint64_t	sum = 0;
+	bool		sorted = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum = sum * 31 + (uint64_t)v[i];
+		if (i && v[i] < v[i - 1])
+			sorted = false;
+	}
+	std::cout << title << " [size] " << v.size() << " [sorted] " << sorted << " [sum] " << sum;
+	if (v.size()) {
+		std::cout << " [front] " << +v[0] << " [back] " << +v[v.size() - 1];
+	}
+	std::cout << std::endl;
+}
+
+template <typename T>
+void ints(const std::string &title, size_t n, int shift) {
+	ft::vector<T>	v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back((T)(next_rand() >> shift));
+	ft::radix_sort(v);
+	print(title, v);
+}
+
+template <typename T>
+void floats(const std::string &title, size_t n) {
+	ft::vector<T>	v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back((T)((int64_t)(next_rand() >> 20) - ((int64_t)1 << 43)) / (T)3.0);
+	v.push_back((T)1e30);
+	v.push_back((T)-1e30);
+	ft::radix_sort(v.begin(), v.end());
+	print(title, v);
+}
+
+struct Record {
+	uint32_t	id;
+	std::string	name;
+};
+
+struct ById {
+	typedef uint32_t	result_type;
+	uint32_t operator()(const Record &r) const { return r.id; }
+};
+
+struct ByFirst {
+	typedef uint64_t	result_type;
+	uint64_t operator()(const ft::pair<uint64_t, int> &p) const { return p.first; }
+};
+
+void records() {
+	ft::vector<Record>	v(5000);
+	for (size_t i = 0; i < v.size(); ++i) {
+		v[i].id = next_rand() % 97;
+		v[i].name = std::string(1, 'a' + i % 26);
+	}
+	ft::radix_sort(v.begin(), v.end(), ById());
+	uint64_t	sum = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+		sum = sum * 31 + v[i].id * 131 + v[i].name[0];
+	std::cout << "records [sum] " << sum << std::endl;
+}
+
+void pairs(size_t n) {
+	ft::vector<ft::pair<uint64_t, int> >	v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back(ft::make_pair(next_rand() % 1000, (int)(next_rand() >> 40) - (1 << 23)));
+	ft::vector<ft::pair<uint64_t, int> >	w(v);
+	ft::radix_sort(v);
+	ft::radix_sort(w, ByFirst());
+	uint64_t	sum = 0, wsum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum = sum * 31 + v[i].first * 7 + v[i].second;
+		wsum = wsum * 31 + w[i].first * 7 + w[i].second;
+	}
+	std::cout << "pairs [size] " << n << " [sum] " << sum << " [by first] " << wsum << std::endl;
+}
+
+/// long double has no radix key and takes the comparison path.
+void long_doubles(size_t n) {
+	ft::vector<long double>	v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back((long double)(next_rand() % 100000) / 7);
+	ft::radix_sort(v.begin(), v.end());
+	bool	sorted = true;
+	for (size_t i = 1; i < v.size(); ++i)
+		if (v[i] < v[i - 1])
+			sorted = false;
+	std::cout << "long double [size] " << n << " [sorted] " << sorted;
+	if (n)
+		std::cout << " [front] " << (double)v[0] << " [back] " << (double)v[n - 1];
+	std::cout << std::endl;
+}
+
+template <typename T>
+void bench(const std::string &title, int shift) {
+	ft::vector<T>	v;
+	for (size_t i = 0; i < SIZE; ++i)
+		v.push_back((T)(next_rand() >> shift));
+	ft::vector<T>	w(v);
+	double	start = now();
+	ft::radix_sort(v);
+	double	mid = now();
+	std::sort(w.begin(), w.end());
+	std::cerr << title << ": radix_sort " << mid - start << "s, std::sort " << now() - mid << "s" << std::endl;
+	print(title, v);
+}
+
+int main() {
+	size_t	sizes[] = { 0, 1, 2, 100, 255, 256, 1000, 70000, 300000 };
+
+	for (size_t i = 0; i < 9; ++i) {
+		std::cout << "-- " << sizes[i] << std::endl;
+		ints<int>("int", sizes[i], 20);
+		ints<unsigned int>("unsigned", sizes[i], 20);
+		ints<short>("short", sizes[i], 40);
+		ints<unsigned char>("uchar", sizes[i], 50);
+		ints<signed char>("schar", sizes[i], 50);
+		ints<long>("long", sizes[i], 0);
+		ints<uint64_t>("uint64", sizes[i], 0);
+		ints<int>("int narrow", sizes[i], 56);
+		floats<float>("float", sizes[i]);
+		floats<double>("double", sizes[i]);
+		pairs(sizes[i]);
+		long_doubles(sizes[i]);
+	}
+	records();
+	bench<int>("int", 20);
+	bench<uint64_t>("uint64", 0);
+	bench<double>("double", 1);
+	return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef _IS_TEST
+# include <cstddef>
+# include <tuple>
+# include <vector>
+template <typename A, typename B, typename C>
+class soa_vector : public std::vector<std::tuple<A, B, C> > {
+public:
+	typedef std::tuple<A, B, C>	value_type;
+
+	void push_back(const A &a, const B &b = B(), const C &c = C()) {
+		std::vector<value_type>::push_back(value_type(a, b, c));
+	}
+	template <size_t I> struct column_type {
+		std::vector<value_type> *rows;
+		size_t size() const { return rows->size(); }
+		typename std::tuple_element<I, value_type>::type &operator[](size_t i) const {
+			return std::get<I>((*rows)[i]);
+		}
+	};
+	template <size_t I> column_type<I> column() {
+		column_type<I> col = { this };
+		return col;
+	}
+};
+using std::get;
+#else
+# include "../include/SoaVector.hpp"
+using ft::soa_vector;
+using ft::get;
+#endif // _IS_TEST
+
+#include <iostream>
+#include <string>
+
+#define SIZE 1000000
+
+typedef soa_vector<float, float, int>	particles;
+
+void print(const std::string &title, particles &p) {
+	std::cout << title << " [size] " << p.size() << " [rows]";
+	for (particles::iterator it = p.begin(); it != p.end(); ++it)
+		std::cout << " (" << get<0>(*it) << ',' << get<1>(*it) << ',' << get<2>(*it) << ')';
+	std::cout << std::endl;
+}
+
+int main() {
+	std::cout << "[#### Testing soa_vector ####]" << std::endl;
+	particles	p;
+	std::cout << "[empty] " << p.empty() << std::endl;
+	for (int i = 0; i < 10; i++)
+		p.push_back(i * 0.5f, 1.0f, i);
+	print("[push_back]", p);
+
+	std::cout << "[#### column access ####]" << std::endl;
+	for (size_t i = 0; i < p.size(); i++)
+		p.column<0>()[i] += p.column<1>()[i] * 2;
+	print("[integrate]", p);
+	int	ids = 0;
+	for (size_t i = 0; i < p.column<2>().size(); i++)
+		ids += p.column<2>()[i];
+	std::cout << "[sum ids] " << ids << std::endl;
+
+	std::cout << "[#### proxy references ####]" << std::endl;
+	get<2>(p[3]) = 42;
+	get<0>(*(p.begin() + 4)) = -1.0f;
+	p[0] = p[9];
+	print("[assign]", p);
+	std::cout << "[distance] " << (p.end() - p.begin()) << std::endl;
+
+	std::cout << "[#### erase / pop_back ####]" << std::endl;
+	p.erase(p.begin() + 1);
+	p.pop_back();
+	print("[erased]", p);
+
+	std::cout << "[#### copy / swap / clear ####]" << std::endl;
+	particles	copy(p);
+	particles	other;
+	other.push_back(7.0f, 7.0f, 7);
+	copy.swap(other);
+	print("[copy]", copy);
+	print("[other]", other);
+	copy = other;
+	p.clear();
+	print("[assigned]", copy);
+	print("[cleared]", p);
+
+	std::cout << "[#### non trivial column ####]" << std::endl;
+	soa_vector<std::string, int, char>	names;
+	for (int i = 0; i < 100; i++)
+		names.push_back(std::string(i % 7 + 1, 'a' + i % 26), i, 'x');
+	names.erase(names.begin() + 50);
+	size_t	len = 0;
+	for (size_t i = 0; i < names.size(); i++)
+		len += names.column<0>()[i].size() + names.column<1>()[i];
+	std::cout << "[size] " << names.size() << " [len] " << len << std::endl;
+
+	std::cout << "[#### large ####]" << std::endl;
+	particles	big;
+	for (int i = 0; i < SIZE; i++)
+		big.push_back(i % 100, 0.25f, i);
+	for (int step = 0; step < 10; step++)
+		for (size_t i = 0; i < big.size(); i++)
+			big.column<0>()[i] += big.column<1>()[i];
+	double	sum = 0;
+	for (size_t i = 0; i < big.size(); i++)
+		sum += big.column<0>()[i];
+	std::cout << "[size] " << big.size() << " [sum] " << sum << std::endl;
+	return 0;
+}